@@ -5,5 +5,12 @@
 #include "../../src/c/so3_error.h"
 #include "../../src/c/so3_sampling.h"
 #include "../../src/c/so3_core.h"
+#include "../../src/c/so3_dl_cache.h"
+#include "../../src/c/so3_schedule.h"
+#include "../../src/c/so3_plan.h"
+#include "../../src/c/so3_autotune.h"
+#include "../../src/c/so3_async.h"
+#include "../../src/c/so3_fork.h"
+#include "../../src/c/so3_simd.h"
 
 #endif // SO3_H
@@ -0,0 +1,490 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_async.c
+ * Asynchronous transforms via SSHT. The submit functions queue a
+ * transform on caller-owned buffers and return immediately with a
+ * handle, which can be polled with \link so3_test_done \endlink and has
+ * to be released with \link so3_wait \endlink. An optional callback is
+ * invoked when the transform has been executed.
+ *
+ * The jobs are executed in the order of submission by a pool of one
+ * worker thread per processor, which is started on the first
+ * submission and stopped by \link so3_async_finalize \endlink. Each
+ * worker keeps the plan of its last job and reuses it for jobs with the
+ * same parameters. Since the pool executes several jobs at a time, each
+ * transform uses a single thread unless \link
+ * so3_parameters_t::num_threads num_threads\endlink says otherwise.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <stdlib.h>
+#include <complex.h>
+#include <pthread.h>
+#include <fftw3.h>
+#include <omp.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+#include "so3_sampling.h"
+#include "so3_plan.h"
+#include "so3_async.h"
+
+typedef enum {
+    SO3_ASYNC_INVERSE,
+    SO3_ASYNC_FORWARD,
+    SO3_ASYNC_INVERSE_REAL,
+    SO3_ASYNC_FORWARD_REAL
+} so3_async_kind_t;
+
+struct so3_job {
+    so3_async_kind_t kind;
+    // The signal is complex or real depending on kind.
+    void *f;
+    complex double *flmn;
+    so3_parameters_t parameters;
+
+    so3_job_callback_t callback;
+    void *data;
+
+    // Guarded by the lock of the pool.
+    so3_status_t status;
+    int done;
+    so3_job_t *next;
+};
+
+// The queue of submitted jobs and the workers which execute them.
+static struct {
+    pthread_mutex_t lock;
+    // Signalled when a job is queued or the pool is stopped.
+    pthread_cond_t work;
+    // Broadcast when a job is done.
+    pthread_cond_t done;
+
+    so3_job_t *head, *tail;
+
+    pthread_t *workers;
+    int nworkers;
+    int stop;
+} so3_async_pool = {
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER
+};
+
+//============================================================================
+// Worker threads
+//============================================================================
+
+// Check whether a plan created for the parameters a can execute a
+// transform with the parameters b.
+static int so3_async_same_parameters(
+    const so3_parameters_t *a, const so3_parameters_t *b
+) {
+    return a->L0 == b->L0
+           && a->L == b->L
+           && a->N == b->N
+           && a->sampling_scheme == b->sampling_scheme
+           && a->n_order == b->n_order
+           && a->storage == b->storage
+           && a->n_mode == b->n_mode
+           && a->dl_method == b->dl_method
+           && a->steerable == b->steerable
+           && a->num_threads == b->num_threads;
+}
+
+// Execute a job with the plan of the worker, which is replaced if it
+// does not match the parameters of the job.
+static so3_status_t so3_async_execute(so3_plan_t **plan, so3_job_t *job)
+{
+    so3_status_t status;
+
+    if (*plan && !so3_async_same_parameters(so3_plan_get_parameters(*plan), &job->parameters))
+    {
+        so3_plan_destroy(*plan);
+        *plan = NULL;
+    }
+    if (!*plan)
+    {
+        status = so3_plan_create_r(plan, &job->parameters, FFTW_ESTIMATE);
+        if (status != SO3_SUCCESS)
+            return status;
+    }
+
+    switch (job->kind)
+    {
+    case SO3_ASYNC_INVERSE:
+        status = so3_plan_execute_inverse_via_ssht(*plan, job->f, job->flmn);
+        break;
+    case SO3_ASYNC_FORWARD:
+        status = so3_plan_execute_forward_via_ssht(*plan, job->flmn, job->f);
+        break;
+    case SO3_ASYNC_INVERSE_REAL:
+        status = so3_plan_execute_inverse_via_ssht_real(*plan, job->f, job->flmn);
+        break;
+    case SO3_ASYNC_FORWARD_REAL:
+        status = so3_plan_execute_forward_via_ssht_real(*plan, job->flmn, job->f);
+        break;
+    default:
+        status = SO3_ERROR_INVALID_ARGUMENT;
+    }
+
+    // A plan whose setup failed keeps failing, so start afresh next time.
+    if (status != SO3_SUCCESS)
+    {
+        so3_plan_destroy(*plan);
+        *plan = NULL;
+    }
+
+    return status;
+}
+
+// Execute queued jobs until the pool is stopped and the queue is empty.
+static void *so3_async_worker(void *arg)
+{
+    so3_plan_t *plan = NULL;
+    so3_job_t *job;
+    so3_status_t status;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&so3_async_pool.lock);
+        while (!so3_async_pool.head && !so3_async_pool.stop)
+            pthread_cond_wait(&so3_async_pool.work, &so3_async_pool.lock);
+        job = so3_async_pool.head;
+        if (job)
+        {
+            so3_async_pool.head = job->next;
+            if (!so3_async_pool.head)
+                so3_async_pool.tail = NULL;
+        }
+        pthread_mutex_unlock(&so3_async_pool.lock);
+
+        if (!job)
+            break;
+
+        status = so3_async_execute(&plan, job);
+
+        if (job->callback)
+            job->callback(job, status, job->data);
+
+        pthread_mutex_lock(&so3_async_pool.lock);
+        job->status = status;
+        job->done = 1;
+        pthread_cond_broadcast(&so3_async_pool.done);
+        pthread_mutex_unlock(&so3_async_pool.lock);
+    }
+
+    so3_plan_destroy(plan);
+
+    return NULL;
+}
+
+// Start one worker per processor, unless the pool is running. Must be
+// called with the lock held. Returns 0 if no worker could be started.
+static int so3_async_start()
+{
+    int nprocs = omp_get_num_procs();
+    int t;
+
+    if (so3_async_pool.nworkers > 0)
+        return 1;
+
+    so3_async_pool.workers = calloc(nprocs, sizeof *so3_async_pool.workers);
+    if (!so3_async_pool.workers)
+        return 0;
+
+    so3_async_pool.stop = 0;
+    for (t = 0; t < nprocs; ++t)
+    {
+        if (pthread_create(&so3_async_pool.workers[t], NULL, so3_async_worker, NULL))
+            break;
+        so3_async_pool.nworkers++;
+    }
+
+    if (so3_async_pool.nworkers == 0)
+    {
+        free(so3_async_pool.workers);
+        so3_async_pool.workers = NULL;
+        return 0;
+    }
+
+    return 1;
+}
+
+//============================================================================
+// Submission
+//============================================================================
+
+// Queue a job, starting the pool if required.
+static so3_status_t so3_async_submit(
+    so3_job_t **job,
+    so3_async_kind_t kind, void *f, complex double *flmn,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+) {
+    so3_job_t *j;
+
+    if (!job)
+        return SO3_ERROR_INVALID_ARGUMENT;
+    *job = NULL;
+
+    if (!f || !flmn || so3_sampling_check_parameters(parameters) != SO3_SUCCESS)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    j = calloc(1, sizeof *j);
+    if (!j)
+        return SO3_ERROR_OUT_OF_MEMORY;
+
+    j->kind = kind;
+    j->f = f;
+    j->flmn = flmn;
+    j->parameters = *parameters;
+    j->parameters.verbosity = 0;
+    if (j->parameters.num_threads <= 0)
+        j->parameters.num_threads = 1;
+    // Pinning the team of each worker would place all workers on the
+    // first CPU of the process.
+    j->parameters.numa = 0;
+    j->callback = callback;
+    j->data = data;
+
+    pthread_mutex_lock(&so3_async_pool.lock);
+    if (!so3_async_start())
+    {
+        pthread_mutex_unlock(&so3_async_pool.lock);
+        free(j);
+        return SO3_ERROR_OUT_OF_MEMORY;
+    }
+    if (so3_async_pool.tail)
+        so3_async_pool.tail->next = j;
+    else
+        so3_async_pool.head = j;
+    so3_async_pool.tail = j;
+    pthread_cond_signal(&so3_async_pool.work);
+    pthread_mutex_unlock(&so3_async_pool.lock);
+
+    *job = j;
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Submit an inverse Wigner transform for a complex signal via SSHT,
+ * which is executed asynchronously. The buffers must not be accessed
+ * until the job is done.
+ *
+ * \param[out] job Handle of the job. Release with \link so3_wait \endlink.
+ * \param[out] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in]  flmn Harmonic coefficients.
+ * \param[in]  parameters A fully populated parameters object, which is
+ *                        copied. The \link so3_parameters_t::verbosity
+ *                        verbosity\endlink is ignored.
+ * \param[in]  callback Function called when the transform has been
+ *                      executed, or NULL.
+ * \param[in]  data Data passed to the callback.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink or
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink. Errors of the
+ *                transform are returned by \link so3_wait \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_submit_inverse(
+    so3_job_t **job,
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+) {
+    return so3_async_submit(job, SO3_ASYNC_INVERSE, f, (complex double *)flmn,
+                            parameters, callback, data);
+}
+
+/*!
+ * Submit a forward Wigner transform for a complex signal via SSHT,
+ * which is executed asynchronously. The buffers must not be accessed
+ * until the job is done.
+ *
+ * \param[out] job Handle of the job. Release with \link so3_wait \endlink.
+ * \param[out] flmn Harmonic coefficients. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in]  f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in]  parameters A fully populated parameters object, which is
+ *                        copied. The \link so3_parameters_t::verbosity
+ *                        verbosity\endlink is ignored.
+ * \param[in]  callback Function called when the transform has been
+ *                      executed, or NULL.
+ * \param[in]  data Data passed to the callback.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink or
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink. Errors of the
+ *                transform are returned by \link so3_wait \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_submit_forward(
+    so3_job_t **job,
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+) {
+    return so3_async_submit(job, SO3_ASYNC_FORWARD, (complex double *)f, flmn,
+                            parameters, callback, data);
+}
+
+/*!
+ * Submit an inverse Wigner transform for a real signal via SSHT, which
+ * is executed asynchronously. The buffers must not be accessed until
+ * the job is done.
+ *
+ * \param[out] job Handle of the job. Release with \link so3_wait \endlink.
+ * \param[out] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in]  flmn Harmonic coefficients for n >= 0. Note that for n = 0, these have to
+ *                  respect the symmetry flm0* = (-1)^(m+n)*fl-m0, and hence fl00 has to be real.
+ * \param[in]  parameters A fully populated parameters object, which is
+ *                        copied. The \link so3_parameters_t::verbosity
+ *                        verbosity\endlink is ignored.
+ * \param[in]  callback Function called when the transform has been
+ *                      executed, or NULL.
+ * \param[in]  data Data passed to the callback.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink or
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink. Errors of the
+ *                transform are returned by \link so3_wait \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_submit_inverse_real(
+    so3_job_t **job,
+    double *f, const complex double *flmn,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+) {
+    return so3_async_submit(job, SO3_ASYNC_INVERSE_REAL, f, (complex double *)flmn,
+                            parameters, callback, data);
+}
+
+/*!
+ * Submit a forward Wigner transform for a real signal via SSHT, which
+ * is executed asynchronously. The buffers must not be accessed until
+ * the job is done.
+ *
+ * \param[out] job Handle of the job. Release with \link so3_wait \endlink.
+ * \param[out] flmn Harmonic coefficients. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in]  f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in]  parameters A fully populated parameters object, which is
+ *                        copied. The \link so3_parameters_t::verbosity
+ *                        verbosity\endlink is ignored.
+ * \param[in]  callback Function called when the transform has been
+ *                      executed, or NULL.
+ * \param[in]  data Data passed to the callback.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink or
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink. Errors of the
+ *                transform are returned by \link so3_wait \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_submit_forward_real(
+    so3_job_t **job,
+    complex double *flmn, const double *f,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+) {
+    return so3_async_submit(job, SO3_ASYNC_FORWARD_REAL, (double *)f, flmn,
+                            parameters, callback, data);
+}
+
+//============================================================================
+// Completion
+//============================================================================
+
+/*!
+ * Wait until a job is done and release it.
+ *
+ * \param[in]  job Handle returned on submission. Invalid afterwards.
+ * \retval status Status of the transform.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_wait(so3_job_t *job)
+{
+    so3_status_t status;
+
+    pthread_mutex_lock(&so3_async_pool.lock);
+    while (!job->done)
+        pthread_cond_wait(&so3_async_pool.done, &so3_async_pool.lock);
+    status = job->status;
+    pthread_mutex_unlock(&so3_async_pool.lock);
+
+    free(job);
+
+    return status;
+}
+
+/*!
+ * Check whether a job is done, without blocking. The job still has to
+ * be released with \link so3_wait \endlink, which then returns
+ * immediately.
+ *
+ * \param[in]  job Handle returned on submission.
+ * \retval done 1 if the transform has been executed (and its callback
+ *              has returned), 0 otherwise.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_test_done(so3_job_t *job)
+{
+    int done;
+
+    pthread_mutex_lock(&so3_async_pool.lock);
+    done = job->done;
+    pthread_mutex_unlock(&so3_async_pool.lock);
+
+    return done;
+}
+
+/*!
+ * Stop the worker threads, once they have executed all queued jobs, and
+ * release their plans. The pool is started again by the next
+ * submission. Must not be called concurrently with a submission.
+ *
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_async_finalize()
+{
+    pthread_t *workers;
+    int nworkers, t;
+
+    pthread_mutex_lock(&so3_async_pool.lock);
+    workers = so3_async_pool.workers;
+    nworkers = so3_async_pool.nworkers;
+    so3_async_pool.stop = 1;
+    pthread_cond_broadcast(&so3_async_pool.work);
+    pthread_mutex_unlock(&so3_async_pool.lock);
+
+    for (t = 0; t < nworkers; ++t)
+        pthread_join(workers[t], NULL);
+
+    pthread_mutex_lock(&so3_async_pool.lock);
+    free(so3_async_pool.workers);
+    so3_async_pool.workers = NULL;
+    so3_async_pool.nworkers = 0;
+    pthread_mutex_unlock(&so3_async_pool.lock);
+}
@@ -0,0 +1,67 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_async.h
+ *  Asynchronous transforms, which are executed by a library-managed
+ *  pool of worker threads while the caller continues.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_ASYNC
+#define SO3_ASYNC
+
+#include <complex.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+
+/*!
+ * Opaque handle of a submitted transform. Every job has to be released
+ * with \link so3_wait \endlink exactly once.
+ */
+typedef struct so3_job so3_job_t;
+
+/*!
+ * Function called by a worker thread when a job has been executed, with
+ * the status of the transform and the data passed on submission. It
+ * must not wait for the job it is called for.
+ */
+typedef void (*so3_job_callback_t)(so3_job_t *job, so3_status_t status, void *data);
+
+so3_status_t so3_submit_inverse(
+    so3_job_t **job,
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+);
+
+so3_status_t so3_submit_forward(
+    so3_job_t **job,
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+);
+
+so3_status_t so3_submit_inverse_real(
+    so3_job_t **job,
+    double *f, const complex double *flmn,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+);
+
+so3_status_t so3_submit_forward_real(
+    so3_job_t **job,
+    complex double *flmn, const double *f,
+    const so3_parameters_t *parameters,
+    so3_job_callback_t callback, void *data
+);
+
+so3_status_t so3_wait(so3_job_t *job);
+int so3_test_done(so3_job_t *job);
+
+void so3_async_finalize();
+
+#endif
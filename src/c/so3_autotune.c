@@ -0,0 +1,623 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_autotune.c
+ * Which combination of algorithm (via SSHT or direct), Wigner recursion
+ * and FFTW planning rigour is fastest depends on L, N, the n-mode and
+ * the machine. \link so3_autotune \endlink times all candidates for a
+ * configuration and records the fastest one for each direction in a
+ * tuning database. The transforms \link so3_forward \endlink, \link
+ * so3_inverse \endlink and their real counterparts look up the
+ * configuration in the database and dispatch accordingly.
+ *
+ * The database is a plain text file with one line per configuration.
+ * Its name is passed explicitly or taken from the environment variable
+ * \link SO3_TUNING_DB_ENV \endlink. A configuration consists of all
+ * parameters which affect the cost of a transform (apart from the
+ * verbosity) and the number of threads.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#include <unistd.h>
+#include <fftw3.h>
+#include <omp.h>
+
+#include "ssht.h"
+
+#include "so3_types.h"
+#include "so3_error.h"
+#include "so3_sampling.h"
+#include "so3_plan.h"
+#include "so3_autotune.h"
+
+#define SO3_TUNING_DB_HEADER "# so3 tuning database v1"
+// Each candidate is timed this many times and the minimum is kept.
+#define SO3_AUTOTUNE_NREPEAT 3
+// Maximum length of a line in the database.
+#define SO3_AUTOTUNE_LINE_SIZE 512
+
+// Number of fields which identify a configuration in the database.
+#define SO3_AUTOTUNE_KEY_SIZE 10
+
+//============================================================================
+// Tuning database
+//============================================================================
+
+static const char *so3_autotune_database(const char *database)
+{
+    return database ? database : getenv(SO3_TUNING_DB_ENV);
+}
+
+static void so3_autotune_key(int *key, const so3_parameters_t *parameters)
+{
+    key[0] = parameters->L0;
+    key[1] = parameters->L;
+    key[2] = parameters->N;
+    key[3] = parameters->sampling_scheme;
+    key[4] = parameters->n_order;
+    key[5] = parameters->storage;
+    key[6] = parameters->n_mode;
+    key[7] = parameters->reality != 0;
+    key[8] = parameters->steerable != 0;
+    key[9] = parameters->num_threads > 0
+             ? parameters->num_threads
+             : omp_get_max_threads();
+}
+
+// Parse a line of the database. Returns 1 if the line holds a record.
+static int so3_autotune_parse(int *key, so3_tuning_t *tuning, const char *line)
+{
+    int forward_algorithm, inverse_algorithm;
+    int forward_dl_method, inverse_dl_method;
+
+    if (line[0] == '#')
+        return 0;
+
+    if (sscanf(line,
+               "%d %d %d %d %d %d %d %d %d %d "
+               "%d %d %u %lf %d %d %u %lf",
+               &key[0], &key[1], &key[2], &key[3], &key[4],
+               &key[5], &key[6], &key[7], &key[8], &key[9],
+               &forward_algorithm, &forward_dl_method,
+               &tuning->forward.fftw_flags, &tuning->forward.time,
+               &inverse_algorithm, &inverse_dl_method,
+               &tuning->inverse.fftw_flags, &tuning->inverse.time) != 18)
+        return 0;
+
+    if (forward_algorithm < 0 || forward_algorithm >= SO3_ALGORITHM_SIZE
+        || inverse_algorithm < 0 || inverse_algorithm >= SO3_ALGORITHM_SIZE)
+        return 0;
+
+    tuning->forward.algorithm = forward_algorithm;
+    tuning->forward.dl_method = forward_dl_method;
+    tuning->inverse.algorithm = inverse_algorithm;
+    tuning->inverse.dl_method = inverse_dl_method;
+
+    return 1;
+}
+
+static void so3_autotune_print(FILE *file, const int *key, const so3_tuning_t *tuning)
+{
+    int i;
+
+    for (i = 0; i < SO3_AUTOTUNE_KEY_SIZE; ++i)
+        fprintf(file, "%d ", key[i]);
+    fprintf(file, "%d %d %u %.6e %d %d %u %.6e\n",
+            tuning->forward.algorithm, tuning->forward.dl_method,
+            tuning->forward.fftw_flags, tuning->forward.time,
+            tuning->inverse.algorithm, tuning->inverse.dl_method,
+            tuning->inverse.fftw_flags, tuning->inverse.time);
+}
+
+// Replace the record for the configuration key in the database (or add
+// it). The new file is written next to the old one and renamed, so that
+// concurrent readers never see a partial file.
+static so3_status_t so3_autotune_store(const char *database, const int *key, const so3_tuning_t *tuning)
+{
+    FILE *in, *out;
+    char *tmp_name;
+    char line[SO3_AUTOTUNE_LINE_SIZE];
+    int line_key[SO3_AUTOTUNE_KEY_SIZE];
+    so3_tuning_t line_tuning;
+    int success;
+
+    tmp_name = malloc(strlen(database) + 32);
+    if (!tmp_name)
+        return SO3_ERROR_OUT_OF_MEMORY;
+    sprintf(tmp_name, "%s.%ld.tmp", database, (long)getpid());
+
+    out = fopen(tmp_name, "w");
+    if (!out)
+    {
+        free(tmp_name);
+        return SO3_ERROR_SYSTEM;
+    }
+
+    fprintf(out, "%s\n", SO3_TUNING_DB_HEADER);
+    fprintf(out, "# L0 L N sampling n_order storage n_mode reality steerable threads"
+                 " fwd_algorithm fwd_dl_method fwd_fftw_flags fwd_time"
+                 " inv_algorithm inv_dl_method inv_fftw_flags inv_time\n");
+
+    in = fopen(database, "r");
+    if (in)
+    {
+        while (fgets(line, sizeof line, in))
+        {
+            if (!so3_autotune_parse(line_key, &line_tuning, line))
+                continue;
+            if (!memcmp(line_key, key, sizeof line_key))
+                continue;
+            so3_autotune_print(out, line_key, &line_tuning);
+        }
+        fclose(in);
+    }
+
+    so3_autotune_print(out, key, tuning);
+
+    success = !ferror(out);
+    success = !fclose(out) && success;
+    success = success && !rename(tmp_name, database);
+    if (!success)
+        remove(tmp_name);
+
+    free(tmp_name);
+
+    return success ? SO3_SUCCESS : SO3_ERROR_SYSTEM;
+}
+
+/*!
+ * Look up the tuning of a configuration in a tuning database.
+ *
+ * \param[out] tuning The recorded choices. Unchanged if none is found.
+ * \param[in]  parameters A parameters object with the configuration.
+ * \param[in]  database Name of the tuning database. If NULL, the value of
+ *                      the environment variable \link SO3_TUNING_DB_ENV
+ *                      \endlink is used.
+ * \retval found 1 if the configuration was found, 0 otherwise.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_autotune_lookup(
+    so3_tuning_t *tuning,
+    const so3_parameters_t *parameters,
+    const char *database
+) {
+    FILE *file;
+    char line[SO3_AUTOTUNE_LINE_SIZE];
+    int key[SO3_AUTOTUNE_KEY_SIZE], line_key[SO3_AUTOTUNE_KEY_SIZE];
+    so3_tuning_t line_tuning;
+    int found;
+
+    database = so3_autotune_database(database);
+    if (!database)
+        return 0;
+
+    file = fopen(database, "r");
+    if (!file)
+        return 0;
+
+    so3_autotune_key(key, parameters);
+
+    // Later records take precedence.
+    found = 0;
+    while (fgets(line, sizeof line, file))
+    {
+        if (so3_autotune_parse(line_key, &line_tuning, line)
+            && !memcmp(line_key, key, sizeof key))
+        {
+            *tuning = line_tuning;
+            found = 1;
+        }
+    }
+
+    fclose(file);
+
+    return found;
+}
+
+//============================================================================
+// Timing
+//============================================================================
+
+static int so3_autotune_direct_supported(const so3_parameters_t *parameters)
+{
+    return parameters->sampling_scheme == SO3_SAMPLING_MW && !parameters->steerable;
+}
+
+static so3_status_t so3_autotune_execute_inverse(
+    so3_plan_t *plan, so3_algorithm_t algorithm,
+    void *f, const complex double *flmn
+) {
+    int real = so3_plan_get_parameters(plan)->reality;
+
+    if (algorithm == SO3_ALGORITHM_DIRECT)
+        if (real) return so3_plan_execute_inverse_direct_real(plan, f, flmn);
+        else      return so3_plan_execute_inverse_direct(plan, f, flmn);
+    else
+        if (real) return so3_plan_execute_inverse_via_ssht_real(plan, f, flmn);
+        else      return so3_plan_execute_inverse_via_ssht(plan, f, flmn);
+}
+
+static so3_status_t so3_autotune_execute_forward(
+    so3_plan_t *plan, so3_algorithm_t algorithm,
+    complex double *flmn, const void *f
+) {
+    int real = so3_plan_get_parameters(plan)->reality;
+
+    if (algorithm == SO3_ALGORITHM_DIRECT)
+        if (real) return so3_plan_execute_forward_direct_real(plan, flmn, f);
+        else      return so3_plan_execute_forward_direct(plan, flmn, f);
+    else
+        if (real) return so3_plan_execute_forward_via_ssht_real(plan, flmn, f);
+        else      return so3_plan_execute_forward_via_ssht(plan, flmn, f);
+}
+
+/*!
+ * Time all candidate algorithms, Wigner recursions and FFTW planning
+ * rigours for a configuration on this machine and record the fastest
+ * choice for the forward and the inverse transform in a tuning database.
+ * Only the execution of the transforms is timed, hence choices with
+ * FFTW_MEASURE are best combined with wisdom (see \link
+ * so3_plan_import_wisdom \endlink), so that the planning is not repeated
+ * by every call of the dispatching transforms.
+ *
+ * \param[out] tuning The fastest choices.
+ * \param[in]  parameters A parameters object with the configuration. The
+ *                        \link so3_parameters_t::reality reality\endlink
+ *                        flag selects the complex or real transforms. The
+ *                        \link so3_parameters_t::dl_method dl_method
+ *                        \endlink is ignored.
+ * \param[in]  database Name of the tuning database. If NULL, the value of
+ *                      the environment variable \link SO3_TUNING_DB_ENV
+ *                      \endlink is used. If neither is set, the result is
+ *                      not recorded.
+ * \retval status \link SO3_SUCCESS \endlink if the result was recorded
+ *                (or there is no database), \link
+ *                SO3_ERROR_INVALID_ARGUMENT \endlink, \link
+ *                SO3_ERROR_OUT_OF_MEMORY \endlink, \link SO3_ERROR_FFTW
+ *                \endlink if a candidate could not be planned, \link
+ *                SO3_ERROR_SYSTEM \endlink if the database could not be
+ *                written, or the error of the transforms if all
+ *                candidates failed. Candidates whose transforms fail are
+ *                skipped.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_autotune(
+    so3_tuning_t *tuning,
+    const so3_parameters_t *parameters,
+    const char *database
+) {
+    static const ssht_dl_method_t dl_methods[] = {
+        SSHT_DL_RISBO, SSHT_DL_TRAPANI
+    };
+    static const unsigned fftw_flags[] = {
+        FFTW_ESTIMATE, FFTW_MEASURE
+    };
+    so3_parameters_t candidate;
+    so3_plan_t *plan;
+    complex double *flmn;
+    void *f;
+    int L, N, flmn_size, f_size;
+    int i, d, p, r, algorithm;
+    int key[SO3_AUTOTUNE_KEY_SIZE];
+    double time_start, time_forward, time_inverse;
+    so3_status_t status, failed = SO3_SUCCESS;
+
+    L = parameters->L;
+    N = parameters->N;
+
+    // This is large enough for all sampling schemes.
+    f_size = (2*N-1) * (2*L) * (L+1);
+    flmn_size = so3_sampling_flmn_size(parameters);
+
+    flmn = malloc(flmn_size * sizeof *flmn);
+    f = malloc(f_size * sizeof(complex double));
+    if (!flmn || !f)
+    {
+        free(flmn);
+        free(f);
+        return SO3_ERROR_OUT_OF_MEMORY;
+    }
+
+    tuning->forward.time = -1.0;
+    tuning->inverse.time = -1.0;
+
+    candidate = *parameters;
+    candidate.verbosity = 0;
+
+    for (d = 0; d < sizeof dl_methods / sizeof *dl_methods; ++d)
+        for (p = 0; p < sizeof fftw_flags / sizeof *fftw_flags; ++p)
+        {
+            candidate.dl_method = dl_methods[d];
+
+            status = so3_plan_create_r(&plan, &candidate, fftw_flags[p]);
+            if (status == SO3_SUCCESS)
+            {
+                status = so3_plan_prepare(plan, so3_autotune_direct_supported(parameters)
+                                                ? SO3_PLAN_PREPARE_ALL
+                                                : SO3_PLAN_PREPARE_VIA_SSHT);
+                if (status != SO3_SUCCESS)
+                    so3_plan_destroy(plan);
+            }
+            if (status != SO3_SUCCESS)
+            {
+                free(flmn);
+                free(f);
+                return status;
+            }
+
+            for (algorithm = 0; algorithm < SO3_ALGORITHM_SIZE; ++algorithm)
+            {
+                if (algorithm == SO3_ALGORITHM_DIRECT
+                    && !so3_autotune_direct_supported(parameters))
+                    continue;
+
+                time_forward = time_inverse = -1.0;
+                status = SO3_SUCCESS;
+                for (r = 0; r < SO3_AUTOTUNE_NREPEAT && status == SO3_SUCCESS; ++r)
+                {
+                    // The values do not matter for the timing, but
+                    // they have to be finite.
+                    for (i = 0; i < flmn_size; ++i)
+                        flmn[i] = 1.0 / (1.0 + i % 7);
+
+                    time_start = omp_get_wtime();
+                    status = so3_autotune_execute_inverse(plan, algorithm, f, flmn);
+                    time_start = omp_get_wtime() - time_start;
+                    if (time_inverse < 0.0 || time_start < time_inverse)
+                        time_inverse = time_start;
+                    if (status != SO3_SUCCESS)
+                        break;
+
+                    time_start = omp_get_wtime();
+                    status = so3_autotune_execute_forward(plan, algorithm, flmn, f);
+                    time_start = omp_get_wtime() - time_start;
+                    if (time_forward < 0.0 || time_start < time_forward)
+                        time_forward = time_start;
+                }
+
+                // A candidate which fails, e.g. for lack of memory, is
+                // not a choice however fast it returns.
+                if (status != SO3_SUCCESS)
+                {
+                    if (parameters->verbosity > 1)
+                        printf("%s  algorithm %d, dl method %d, FFTW flags %u: "
+                               "failed with status %d\n",
+                               SO3_PROMPT, algorithm, dl_methods[d], fftw_flags[p],
+                               status);
+                    failed = status;
+                    continue;
+                }
+
+                if (parameters->verbosity > 1)
+                    printf("%s  algorithm %d, dl method %d, FFTW flags %u: "
+                           "forward %fs, inverse %fs\n",
+                           SO3_PROMPT, algorithm, dl_methods[d], fftw_flags[p],
+                           time_forward, time_inverse);
+
+                if (tuning->forward.time < 0.0 || time_forward < tuning->forward.time)
+                {
+                    tuning->forward.algorithm = algorithm;
+                    tuning->forward.dl_method = dl_methods[d];
+                    tuning->forward.fftw_flags = fftw_flags[p];
+                    tuning->forward.time = time_forward;
+                }
+                if (tuning->inverse.time < 0.0 || time_inverse < tuning->inverse.time)
+                {
+                    tuning->inverse.algorithm = algorithm;
+                    tuning->inverse.dl_method = dl_methods[d];
+                    tuning->inverse.fftw_flags = fftw_flags[p];
+                    tuning->inverse.time = time_inverse;
+                }
+            }
+
+            so3_plan_destroy(plan);
+        }
+
+    free(flmn);
+    free(f);
+
+    if (tuning->forward.time < 0.0)
+        return failed;
+
+    if (parameters->verbosity > 0)
+        printf("%sTuned (L, N, reality) = (%d, %d, %d): "
+               "forward uses algorithm %d (%fs), inverse uses algorithm %d (%fs)\n",
+               SO3_PROMPT, L, N, parameters->reality,
+               tuning->forward.algorithm, tuning->forward.time,
+               tuning->inverse.algorithm, tuning->inverse.time);
+
+    database = so3_autotune_database(database);
+    if (!database)
+        return SO3_SUCCESS;
+
+    so3_autotune_key(key, parameters);
+    return so3_autotune_store(database, key, tuning);
+}
+
+//============================================================================
+// Dispatching transforms
+//============================================================================
+
+// Create the plan for one direction of a transform according to the
+// tuning database. Without a record, this behaves like the so3_core
+// routines via SSHT.
+static so3_plan_t *so3_autotune_plan_create(
+    so3_algorithm_t *algorithm,
+    const so3_parameters_t *parameters,
+    int forward
+) {
+    so3_tuning_t tuning;
+    so3_tuning_choice_t *choice;
+    so3_parameters_t tuned;
+
+    tuned = *parameters;
+
+    if (!so3_autotune_lookup(&tuning, parameters, NULL))
+    {
+        *algorithm = SO3_ALGORITHM_VIA_SSHT;
+        return so3_plan_create(&tuned, FFTW_ESTIMATE);
+    }
+
+    choice = forward ? &tuning.forward : &tuning.inverse;
+
+    // Guard against hand-edited databases.
+    *algorithm = choice->algorithm;
+    if (*algorithm == SO3_ALGORITHM_DIRECT && !so3_autotune_direct_supported(parameters))
+        *algorithm = SO3_ALGORITHM_VIA_SSHT;
+
+    tuned.dl_method = choice->dl_method;
+    return so3_plan_create(&tuned, choice->fftw_flags);
+}
+
+/*!
+ * Compute inverse Wigner transform for a complex signal with the
+ * algorithm recorded for this configuration in the tuning database
+ * (see \link so3_autotune \endlink), which is named by the environment
+ * variable \link SO3_TUNING_DB_ENV \endlink. Without a record, \link
+ * so3_core_inverse_via_ssht \endlink is used.
+ *
+ * \param[out] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in]  flmn Harmonic coefficients.
+ * \param[in]  parameters A fully populated parameters object. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored. Use \link so3_inverse_real
+ *                        \endlink instead for real signals.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_inverse(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters
+) {
+    so3_parameters_t complex_parameters = *parameters;
+    so3_algorithm_t algorithm;
+    so3_plan_t *plan;
+
+    complex_parameters.reality = 0;
+    plan = so3_autotune_plan_create(&algorithm, &complex_parameters, 0);
+    if (so3_autotune_execute_inverse(plan, algorithm, f, flmn) != SO3_SUCCESS)
+        SO3_ERROR_GENERIC("Transform failed.");
+
+    so3_plan_destroy(plan);
+}
+
+/*!
+ * Compute forward Wigner transform for a complex signal with the
+ * algorithm recorded for this configuration in the tuning database
+ * (see \link so3_autotune \endlink), which is named by the environment
+ * variable \link SO3_TUNING_DB_ENV \endlink. Without a record, \link
+ * so3_core_forward_via_ssht \endlink is used.
+ *
+ * \param[out] flmn Harmonic coefficients. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in]  f Function on sphere.
+ * \param[in]  parameters A fully populated parameters object. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored. Use \link so3_forward_real
+ *                        \endlink instead for real signals.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_forward(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters
+) {
+    so3_parameters_t complex_parameters = *parameters;
+    so3_algorithm_t algorithm;
+    so3_plan_t *plan;
+
+    complex_parameters.reality = 0;
+    plan = so3_autotune_plan_create(&algorithm, &complex_parameters, 1);
+    if (so3_autotune_execute_forward(plan, algorithm, flmn, f) != SO3_SUCCESS)
+        SO3_ERROR_GENERIC("Transform failed.");
+
+    so3_plan_destroy(plan);
+}
+
+/*!
+ * Compute inverse Wigner transform for a real signal with the
+ * algorithm recorded for this configuration in the tuning database
+ * (see \link so3_autotune \endlink), which is named by the environment
+ * variable \link SO3_TUNING_DB_ENV \endlink. Without a record, \link
+ * so3_core_inverse_via_ssht_real \endlink is used.
+ *
+ * \param[out] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in]  flmn Harmonic coefficients for n >= 0. Note that for n = 0, these have to
+ *                  respect the symmetry flm0* = (-1)^(m+n)*fl-m0, and hence fl00 has to be real.
+ * \param[in]  parameters A fully populated parameters object. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored. Use \link so3_inverse
+ *                        \endlink instead for complex signals.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_inverse_real(
+    double *f, const complex double *flmn,
+    const so3_parameters_t *parameters
+) {
+    so3_parameters_t real_parameters = *parameters;
+    so3_algorithm_t algorithm;
+    so3_plan_t *plan;
+
+    real_parameters.reality = 1;
+    plan = so3_autotune_plan_create(&algorithm, &real_parameters, 0);
+    if (so3_autotune_execute_inverse(plan, algorithm, f, flmn) != SO3_SUCCESS)
+        SO3_ERROR_GENERIC("Transform failed.");
+
+    so3_plan_destroy(plan);
+}
+
+/*!
+ * Compute forward Wigner transform for a real signal with the
+ * algorithm recorded for this configuration in the tuning database
+ * (see \link so3_autotune \endlink), which is named by the environment
+ * variable \link SO3_TUNING_DB_ENV \endlink. Without a record, \link
+ * so3_core_forward_via_ssht_real \endlink is used.
+ *
+ * \param[out] flmn Harmonic coefficients for n >= 0. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in]  f Function on sphere.
+ * \param[in]  parameters A fully populated parameters object. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored. Use \link so3_forward
+ *                        \endlink instead for complex signals.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_forward_real(
+    complex double *flmn, const double *f,
+    const so3_parameters_t *parameters
+) {
+    so3_parameters_t real_parameters = *parameters;
+    so3_algorithm_t algorithm;
+    so3_plan_t *plan;
+
+    real_parameters.reality = 1;
+    plan = so3_autotune_plan_create(&algorithm, &real_parameters, 1);
+    if (so3_autotune_execute_forward(plan, algorithm, flmn, f) != SO3_SUCCESS)
+        SO3_ERROR_GENERIC("Transform failed.");
+
+    so3_plan_destroy(plan);
+}
@@ -0,0 +1,94 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_autotune.h
+ *  Selection of the fastest algorithm, recursion method and FFTW
+ *  planning rigour for a configuration, a persistent database of the
+ *  results and transforms which dispatch to the recorded choice.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_AUTOTUNE
+#define SO3_AUTOTUNE
+
+#include "ssht.h"
+#include <complex.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+
+/*!
+ * Name of the environment variable which holds the file name of the
+ * tuning database, if none is passed explicitly.
+ */
+#define SO3_TUNING_DB_ENV "SO3_TUNING_DB"
+
+typedef enum {
+    /*! so3_core_*_via_ssht */
+    SO3_ALGORITHM_VIA_SSHT,
+    /*! so3_core_*_direct (MW sampling only, not steerable) */
+    SO3_ALGORITHM_DIRECT,
+    /*!
+     * "guard" value that equals the number of usable enum values.
+     * useful in loops, for instance.
+     */
+    SO3_ALGORITHM_SIZE
+} so3_algorithm_t;
+
+/*!
+ * The choice for one direction (forward or inverse) of a transform.
+ */
+typedef struct {
+    /*! Algorithm family. */
+    so3_algorithm_t algorithm;
+    /*! Recursion method for the Wigner functions. */
+    ssht_dl_method_t dl_method;
+    /*! FFTW planning flags. */
+    unsigned fftw_flags;
+    /*! Measured wall-clock time of one transform in seconds. */
+    double time;
+} so3_tuning_choice_t;
+
+/*!
+ * The result of \link so3_autotune \endlink for a configuration.
+ */
+typedef struct {
+    so3_tuning_choice_t forward;
+    so3_tuning_choice_t inverse;
+} so3_tuning_t;
+
+so3_status_t so3_autotune(
+    so3_tuning_t *tuning,
+    const so3_parameters_t *parameters,
+    const char *database
+);
+int so3_autotune_lookup(
+    so3_tuning_t *tuning,
+    const so3_parameters_t *parameters,
+    const char *database
+);
+
+void so3_inverse(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters
+);
+
+void so3_forward(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters
+);
+
+void so3_inverse_real(
+    double *f, const complex double *flmn,
+    const so3_parameters_t *parameters
+);
+
+void so3_forward_real(
+    complex double *flmn, const double *f,
+    const so3_parameters_t *parameters
+);
+
+#endif
@@ -8,6 +8,9 @@
 #include "ssht.h"
 #include <complex.h>
 
+#include "so3_types.h"
+#include "so3_error.h"
+
 void so3_core_inverse_via_ssht(
     complex double *f, const complex double *flmn,
     const so3_parameters_t *parameters
@@ -50,4 +53,160 @@ void so3_core_forward_direct_real(
     const so3_parameters_t *parameters
 );
 
+void so3_core_inverse_direct_split(
+    double *f_re, double *f_im,
+    const double *flmn_re, const double *flmn_im,
+    const so3_parameters_t *parameters
+);
+
+void so3_core_forward_direct_split(
+    double *flmn_re, double *flmn_im,
+    const double *f_re, const double *f_im,
+    const so3_parameters_t *parameters
+);
+
+
+
+void so3_core_inverse_via_ssht_batch(
+    complex double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+void so3_core_forward_via_ssht_batch(
+    complex double *flmn, const complex double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+void so3_core_inverse_via_ssht_real_batch(
+    double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+void so3_core_forward_via_ssht_real_batch(
+    complex double *flmn, const double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+
+
+void so3_core_inverse_direct_batch(
+    complex double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+void so3_core_forward_direct_batch(
+    complex double *flmn, const complex double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+void so3_core_inverse_direct_real_batch(
+    double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+void so3_core_forward_direct_real_batch(
+    complex double *flmn, const double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+
+
+so3_status_t so3_core_inverse_via_ssht_r(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_via_ssht_r(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_inverse_via_ssht_real_r(
+    double *f, const complex double *flmn,
+    const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_via_ssht_real_r(
+    complex double *flmn, const double *f,
+    const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_inverse_direct_r(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_direct_r(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_inverse_direct_real_r(
+    double *f, const complex double *flmn,
+    const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_direct_real_r(
+    complex double *flmn, const double *f,
+    const so3_parameters_t *parameters
+);
+
+
+
+so3_status_t so3_core_inverse_direct_split_r(
+    double *f_re, double *f_im,
+    const double *flmn_re, const double *flmn_im,
+    const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_direct_split_r(
+    double *flmn_re, double *flmn_im,
+    const double *f_re, const double *f_im,
+    const so3_parameters_t *parameters
+);
+
+
+
+so3_status_t so3_core_inverse_via_ssht_batch_r(
+    complex double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_via_ssht_batch_r(
+    complex double *flmn, const complex double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_inverse_via_ssht_real_batch_r(
+    double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_via_ssht_real_batch_r(
+    complex double *flmn, const double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+
+
+so3_status_t so3_core_inverse_direct_batch_r(
+    complex double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_direct_batch_r(
+    complex double *flmn, const complex double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_inverse_direct_real_batch_r(
+    double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_core_forward_direct_real_batch_r(
+    complex double *flmn, const double *f,
+    int count, const so3_parameters_t *parameters
+);
+
 #endif
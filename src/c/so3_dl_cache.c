@@ -0,0 +1,396 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_dl_cache.c
+ * Persistent cache of the Wigner quarter planes dl_{m m'}(pi/2) for
+ * 0 <= m, m' <= el and all el < L. The planes are identical for every
+ * transform with the same band-limit and recursion method, so they are
+ * computed once, written to disk and memory-mapped read-only by all
+ * processes which use them. The kernel then shares a single copy of
+ * the pages between all processes on a node.
+ *
+ * The file consists of a header, holding a magic string, a format
+ * version, a byte-order marker, the band-limit, the recursion method,
+ * the number of stored values and a checksum of these, followed by the
+ * planes for el = 0, ..., L-1. Plane el is stored compactly as an
+ * (el+1) x (el+1) array with m varying fastest.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ssht.h"
+
+#include "so3_types.h"
+#include "so3_error.h"
+#include "so3_dl_cache.h"
+
+#define SO3_DL_CACHE_MAGIC "SO3DLPI2"
+#define SO3_DL_CACHE_VERSION 1
+#define SO3_DL_CACHE_BYTE_ORDER 0x01020304u
+// The data is stored at this offset, which keeps it cache-line aligned.
+#define SO3_DL_CACHE_HEADER_SIZE 64
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t header_size;
+    int32_t L;
+    int32_t dl_method;
+    uint32_t reserved;
+    uint64_t data_size;
+    uint64_t checksum;
+} so3_dl_cache_header_t;
+
+struct so3_dl_cache {
+    void *map;
+    size_t map_size;
+    const double *data;
+    int L;
+    ssht_dl_method_t dl_method;
+};
+
+// Offset of the plane for el, i.e. sum of (k+1)^2 for k < el.
+static size_t so3_dl_cache_plane_offset(int el)
+{
+    return (size_t)el * (el+1) * (2*el+1) / 6;
+}
+
+// 64-bit FNV-1a hash over the stored values, processed in words.
+static uint64_t so3_dl_cache_checksum(uint64_t hash, const double *data, size_t size)
+{
+    size_t i;
+    uint64_t word;
+
+    for (i = 0; i < size; ++i)
+    {
+        memcpy(&word, data + i, sizeof word);
+        hash ^= word;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+#define SO3_DL_CACHE_CHECKSUM_INIT 14695981039346656037ULL
+
+// Compute all planes for el < L and write them to filename. The file
+// is written under a temporary name and renamed afterwards, so that
+// concurrent readers never see a partially written file.
+static so3_status_t so3_dl_cache_write(const char *filename, int L, ssht_dl_method_t dl_method)
+{
+    so3_dl_cache_header_t header;
+    char padding[SO3_DL_CACHE_HEADER_SIZE];
+    char *tmpname;
+    FILE *file;
+    double *dl, *dl8 = NULL, *sqrt_tbl, *signs, *plane;
+    int dl_offset, dl_stride;
+    int el, m, mm, success;
+    so3_status_t status;
+
+    if (dl_method != SSHT_DL_RISBO && dl_method != SSHT_DL_TRAPANI)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    tmpname = malloc(strlen(filename) + 32);
+    sqrt_tbl = calloc(2*(L-1)+2, sizeof *sqrt_tbl);
+    signs = calloc(L+1, sizeof *signs);
+    plane = malloc(L*L * sizeof *plane);
+    dl = ssht_dl_calloc(L, SSHT_DL_QUARTER);
+    if (dl_method == SSHT_DL_RISBO)
+        dl8 = ssht_dl_calloc(L, SSHT_DL_QUARTER_EXTENDED);
+
+    file = NULL;
+    status = SO3_ERROR_OUT_OF_MEMORY;
+    if (tmpname && sqrt_tbl && signs && plane && dl
+        && (dl8 || dl_method != SSHT_DL_RISBO))
+    {
+        sprintf(tmpname, "%s.%ld.tmp", filename, (long)getpid());
+        file = fopen(tmpname, "wb");
+        status = SO3_ERROR_SYSTEM;
+    }
+    if (!file)
+    {
+        free(dl);
+        free(dl8);
+        free(plane);
+        free(sqrt_tbl);
+        free(signs);
+        free(tmpname);
+        return status;
+    }
+
+    for (el = 0; el <= 2*L-1; ++el)
+        sqrt_tbl[el] = sqrt((double)el);
+    for (m = 0; m <= L-1; m += 2)
+    {
+        signs[m]   =  1.0;
+        signs[m+1] = -1.0;
+    }
+
+    dl_offset = ssht_dl_get_offset(L, SSHT_DL_QUARTER);
+    dl_stride = ssht_dl_get_stride(L, SSHT_DL_QUARTER);
+
+    memset(&header, 0, sizeof header);
+    memcpy(header.magic, SO3_DL_CACHE_MAGIC, sizeof header.magic);
+    header.version = SO3_DL_CACHE_VERSION;
+    header.byte_order = SO3_DL_CACHE_BYTE_ORDER;
+    header.header_size = SO3_DL_CACHE_HEADER_SIZE;
+    header.L = L;
+    header.dl_method = dl_method;
+    header.data_size = so3_dl_cache_plane_offset(L);
+    header.checksum = SO3_DL_CACHE_CHECKSUM_INIT;
+
+    // Reserve space for the header, which is written once the
+    // checksum is known.
+    memset(padding, 0, sizeof padding);
+    success = fwrite(padding, sizeof padding, 1, file) == 1;
+
+    for (el = 0; el < L && success; ++el)
+    {
+        switch (dl_method)
+        {
+        case SSHT_DL_RISBO:
+            ssht_dl_beta_risbo_eighth_table(
+                    dl8,
+                    SO3_PION2,
+                    L,
+                    SSHT_DL_QUARTER_EXTENDED,
+                    el,
+                    sqrt_tbl,
+                    signs);
+            ssht_dl_beta_risbo_fill_eighth2quarter_table(
+                    dl,
+                    dl8, L,
+                    SSHT_DL_QUARTER,
+                    SSHT_DL_QUARTER_EXTENDED,
+                    el,
+                    signs);
+            break;
+
+        case SSHT_DL_TRAPANI:
+            ssht_dl_halfpi_trapani_eighth_table(
+                    dl,
+                    L,
+                    SSHT_DL_QUARTER,
+                    el,
+                    sqrt_tbl);
+            ssht_dl_halfpi_trapani_fill_eighth2quarter_table(
+                    dl,
+                    L,
+                    SSHT_DL_QUARTER,
+                    el,
+                    signs);
+            break;
+
+        default:
+            // Rejected above.
+            break;
+        }
+
+        for (mm = 0; mm <= el; ++mm)
+            for (m = 0; m <= el; ++m)
+                plane[m + (el+1)*mm] = dl[m + dl_offset + mm*dl_stride];
+
+        header.checksum = so3_dl_cache_checksum(header.checksum, plane, (el+1)*(el+1));
+        success = fwrite(plane, sizeof *plane, (el+1)*(el+1), file) == (size_t)(el+1)*(el+1);
+    }
+
+    if (success)
+    {
+        memcpy(padding, &header, sizeof header);
+        success = fseek(file, 0, SEEK_SET) == 0
+                  && fwrite(padding, sizeof padding, 1, file) == 1;
+    }
+
+    success = (fclose(file) == 0) && success;
+    if (success)
+        success = rename(tmpname, filename) == 0;
+    if (!success)
+        remove(tmpname);
+
+    free(dl);
+    free(dl8);
+    free(plane);
+    free(sqrt_tbl);
+    free(signs);
+    free(tmpname);
+
+    return success ? SO3_SUCCESS : SO3_ERROR_SYSTEM;
+}
+
+// Map filename and validate its contents. Returns SO3_ERROR_SYSTEM if
+// the file does not exist, is invalid, or does not cover band-limit L
+// with dl_method.
+static so3_status_t so3_dl_cache_map(
+    so3_dl_cache_t **cache, const char *filename, int L, ssht_dl_method_t dl_method
+) {
+    so3_dl_cache_header_t header;
+    struct stat st;
+    void *map;
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return SO3_ERROR_SYSTEM;
+
+    if (fstat(fd, &st) != 0 || st.st_size < SO3_DL_CACHE_HEADER_SIZE)
+    {
+        close(fd);
+        return SO3_ERROR_SYSTEM;
+    }
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return SO3_ERROR_SYSTEM;
+
+    memcpy(&header, map, sizeof header);
+    if (memcmp(header.magic, SO3_DL_CACHE_MAGIC, sizeof header.magic)
+        || header.version != SO3_DL_CACHE_VERSION
+        || header.byte_order != SO3_DL_CACHE_BYTE_ORDER
+        || header.header_size != SO3_DL_CACHE_HEADER_SIZE
+        || header.dl_method != dl_method
+        || header.L < L
+        || header.data_size != so3_dl_cache_plane_offset(header.L)
+        || (uint64_t)st.st_size != SO3_DL_CACHE_HEADER_SIZE + header.data_size * sizeof(double)
+        || header.checksum != so3_dl_cache_checksum(
+                                SO3_DL_CACHE_CHECKSUM_INIT,
+                                (const double *)((const char *)map + SO3_DL_CACHE_HEADER_SIZE),
+                                header.data_size))
+    {
+        munmap(map, st.st_size);
+        return SO3_ERROR_SYSTEM;
+    }
+
+    *cache = malloc(sizeof **cache);
+    if (!*cache)
+    {
+        munmap(map, st.st_size);
+        return SO3_ERROR_OUT_OF_MEMORY;
+    }
+
+    (*cache)->map = map;
+    (*cache)->map_size = st.st_size;
+    (*cache)->data = (const double *)((const char *)map + SO3_DL_CACHE_HEADER_SIZE);
+    (*cache)->L = header.L;
+    (*cache)->dl_method = header.dl_method;
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Open a cache file of the Wigner quarter planes at beta = pi/2 and
+ * map it into memory. If the file does not exist, is corrupt, was
+ * written by an incompatible version, or does not cover the requested
+ * band-limit or recursion method, the planes are computed and the file
+ * is (re)written first.
+ *
+ * \param[out] cache Handle to the mapped cache, or NULL on failure.
+ *                   Release with \link so3_dl_cache_close \endlink.
+ * \param[in]  filename Name of the cache file.
+ * \param[in]  L Minimum band-limit the cache has to cover.
+ * \param[in]  dl_method Recursion method used to compute the planes.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink (for an
+ *                unknown recursion method),
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink or
+ *                \link SO3_ERROR_SYSTEM \endlink if the file could
+ *                neither be read nor written.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_dl_cache_open(
+    so3_dl_cache_t **cache, const char *filename, int L, ssht_dl_method_t dl_method
+) {
+    so3_status_t status;
+
+    *cache = NULL;
+
+    status = so3_dl_cache_map(cache, filename, L, dl_method);
+    if (status != SO3_ERROR_SYSTEM)
+        return status;
+
+    status = so3_dl_cache_write(filename, L, dl_method);
+    if (status != SO3_SUCCESS)
+        return status;
+
+    return so3_dl_cache_map(cache, filename, L, dl_method);
+}
+
+/*!
+ * Unmap a cache. Plans using the cache must not be executed afterwards.
+ *
+ * \param[in]  cache Cache to release. May be NULL.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_dl_cache_close(so3_dl_cache_t *cache)
+{
+    if (!cache)
+        return;
+
+    munmap(cache->map, cache->map_size);
+    free(cache);
+}
+
+/*!
+ * Get the band-limit covered by a cache.
+ *
+ * \param[in]  cache Cache.
+ * \retval L Band-limit. The cache holds the planes for all el < L.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_dl_cache_get_L(const so3_dl_cache_t *cache)
+{
+    return cache->L;
+}
+
+/*!
+ * Get the recursion method the planes of a cache were computed with.
+ *
+ * \param[in]  cache Cache.
+ * \retval dl_method Recursion method.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+ssht_dl_method_t so3_dl_cache_get_dl_method(const so3_dl_cache_t *cache)
+{
+    return cache->dl_method;
+}
+
+/*!
+ * Get the Wigner quarter plane for a given el.
+ *
+ * \param[in]  cache Cache.
+ * \param[in]  el Harmonic index, 0 <= el < \link so3_dl_cache_get_L
+ *                \endlink.
+ * \retval plane Read-only array of size (el+1)*(el+1), holding
+ *               dl_{m m'}(pi/2) at index m + (el+1)*m' for
+ *               0 <= m, m' <= el.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+const double *so3_dl_cache_get_plane(const so3_dl_cache_t *cache, int el)
+{
+    return cache->data + so3_dl_cache_plane_offset(el);
+}
@@ -0,0 +1,35 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_dl_cache.h
+ *  Persistent, memory-mapped cache of the Wigner quarter planes at
+ *  beta = pi/2, as used by the direct transforms.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_DL_CACHE
+#define SO3_DL_CACHE
+
+#include "ssht.h"
+
+#include "so3_error.h"
+
+/*!
+ * Opaque handle to a mapped cache file. The mapping is read-only and
+ * may be shared by any number of plans (and threads) at the same time.
+ */
+typedef struct so3_dl_cache so3_dl_cache_t;
+
+so3_status_t so3_dl_cache_open(
+    so3_dl_cache_t **cache, const char *filename, int L, ssht_dl_method_t dl_method
+);
+void so3_dl_cache_close(so3_dl_cache_t *cache);
+
+int so3_dl_cache_get_L(const so3_dl_cache_t *cache);
+ssht_dl_method_t so3_dl_cache_get_dl_method(const so3_dl_cache_t *cache);
+const double *so3_dl_cache_get_plane(const so3_dl_cache_t *cache, int el);
+
+#endif
@@ -32,4 +32,23 @@
     SO3_ERROR_GENERIC("Memory allocation failed")			\
   }
 
+/*!
+ * Status codes of the reentrant functions (those with suffix _r), which
+ * report errors to the caller instead of terminating the program.
+ */
+typedef enum {
+    /*! The function completed successfully. */
+    SO3_SUCCESS = 0,
+    /*! An argument or a field of the parameters object is invalid. */
+    SO3_ERROR_INVALID_ARGUMENT,
+    /*! The parameters are valid, but not supported by the routine. */
+    SO3_ERROR_UNSUPPORTED,
+    /*! Memory allocation failed. */
+    SO3_ERROR_OUT_OF_MEMORY,
+    /*! The threaded FFTW library could not be initialised. */
+    SO3_ERROR_FFTW,
+    /*! A system call failed or a helper process terminated. */
+    SO3_ERROR_SYSTEM
+} so3_status_t;
+
 #endif
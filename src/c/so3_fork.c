@@ -0,0 +1,819 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_fork.c
+ * Batched transforms executed by forked helper processes, for hosts
+ * which must not start threads but may fork. \link so3_fork_init
+ * \endlink creates a shared arena with shm_open and mmap and then forks
+ * the helpers, which therefore see the arena at the same address as the
+ * caller. Buffers allocated from the arena with \link so3_fork_alloc
+ * \endlink are handed to the helpers by pointer, without copying.
+ *
+ * A batched call splits the signals into one contiguous range per
+ * helper and blocks until all helpers are done. Each helper executes
+ * its range with a single-threaded plan, which it keeps and reuses for
+ * calls with the same parameters, so the transforms need not be
+ * thread-safe. Calls must not be made concurrently, and helpers started
+ * by a process do not outlive it.
+ *
+ * The pool relies on process-shared semaphores, which are only
+ * available on Linux. Elsewhere \link so3_fork_init \endlink returns
+ * \link SO3_ERROR_UNSUPPORTED \endlink and no batches are accepted.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <sys/prctl.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#include <fftw3.h>
+#include <omp.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+#include "so3_sampling.h"
+#include "so3_plan.h"
+#include "so3_fork.h"
+
+// Alignment of the buffers in the arena, which is at least that of
+// fftw_malloc.
+#define SO3_FORK_ALIGN 64
+
+// Interval at which a waiting caller checks whether the helpers are
+// still alive.
+#define SO3_FORK_POLL_NS 100000000L
+
+typedef enum {
+    SO3_FORK_INVERSE,
+    SO3_FORK_FORWARD,
+    SO3_FORK_INVERSE_REAL,
+    SO3_FORK_FORWARD_REAL,
+    SO3_FORK_INVERSE_DIRECT,
+    SO3_FORK_FORWARD_DIRECT,
+    SO3_FORK_INVERSE_DIRECT_REAL,
+    SO3_FORK_FORWARD_DIRECT_REAL
+} so3_fork_kind_t;
+
+#ifdef __linux__
+// The range of signals of a batched call assigned to a helper. Lives in
+// the shared control block, written by the caller before start is
+// posted and by the helper before done is posted.
+typedef struct {
+    sem_t start;
+    int stop;
+
+    so3_fork_kind_t kind;
+    // The signal is complex or real depending on kind.
+    void *f;
+    complex double *flmn;
+    int count;
+    so3_parameters_t parameters;
+
+    so3_status_t status;
+    int finished;
+} so3_fork_task_t;
+
+typedef struct {
+    // Posted by a helper when it has finished its task.
+    sem_t done;
+    so3_fork_task_t tasks[];
+} so3_fork_control_t;
+
+// Header of a block of the arena. The blocks tile the arena, and only
+// the caller walks and modifies them.
+typedef struct {
+    size_t size;
+    int free;
+} so3_fork_block_t;
+
+#define SO3_FORK_HEADER \
+    ((sizeof(so3_fork_block_t) + SO3_FORK_ALIGN-1) / SO3_FORK_ALIGN * SO3_FORK_ALIGN)
+
+static struct {
+    // The shared mapping: the control block, followed by the arena.
+    void *mapping;
+    size_t mapping_size;
+    so3_fork_control_t *control;
+    char *arena;
+    size_t arena_size;
+
+    pid_t *helpers;
+    int nhelpers;
+    // Set when a helper has terminated, after which no further calls
+    // are accepted until the pool is finalised.
+    int broken;
+} so3_fork_pool;
+#endif
+
+//============================================================================
+// Helper processes
+//============================================================================
+
+#ifdef __linux__
+// Check whether a plan created for the parameters a can execute a
+// transform with the parameters b.
+static int so3_fork_same_parameters(
+    const so3_parameters_t *a, const so3_parameters_t *b
+) {
+    return a->L0 == b->L0
+           && a->L == b->L
+           && a->N == b->N
+           && a->sampling_scheme == b->sampling_scheme
+           && a->n_order == b->n_order
+           && a->storage == b->storage
+           && a->n_mode == b->n_mode
+           && a->dl_method == b->dl_method
+           && a->steerable == b->steerable
+           && a->reality == b->reality;
+}
+
+// Number of harmonic coefficients per signal of a task.
+static size_t so3_fork_flmn_dist(const so3_parameters_t *parameters, int real)
+{
+    so3_parameters_t p = *parameters;
+
+    p.reality = real;
+
+    return so3_sampling_flmn_size(&p);
+}
+
+static int so3_fork_is_real(so3_fork_kind_t kind)
+{
+    return kind == SO3_FORK_INVERSE_REAL || kind == SO3_FORK_FORWARD_REAL
+           || kind == SO3_FORK_INVERSE_DIRECT_REAL || kind == SO3_FORK_FORWARD_DIRECT_REAL;
+}
+
+// Execute a task with the plan of the helper, which is replaced if it
+// does not match the parameters of the task.
+static so3_status_t so3_fork_execute(so3_plan_t **plan, const so3_fork_task_t *task)
+{
+    so3_status_t status = SO3_SUCCESS;
+    complex double *f = task->f;
+    double *fr = task->f;
+
+    if (*plan && !so3_fork_same_parameters(so3_plan_get_parameters(*plan), &task->parameters))
+    {
+        so3_plan_destroy(*plan);
+        *plan = NULL;
+    }
+    if (!*plan)
+    {
+        status = so3_plan_create_r(plan, &task->parameters, FFTW_ESTIMATE);
+        if (status != SO3_SUCCESS)
+            return status;
+    }
+
+    switch (task->kind)
+    {
+    case SO3_FORK_INVERSE:
+        status = so3_plan_execute_inverse_via_ssht_batch(*plan, f, task->flmn, task->count);
+        break;
+    case SO3_FORK_FORWARD:
+        status = so3_plan_execute_forward_via_ssht_batch(*plan, task->flmn, f, task->count);
+        break;
+    case SO3_FORK_INVERSE_REAL:
+        status = so3_plan_execute_inverse_via_ssht_real_batch(*plan, fr, task->flmn, task->count);
+        break;
+    case SO3_FORK_FORWARD_REAL:
+        status = so3_plan_execute_forward_via_ssht_real_batch(*plan, task->flmn, fr, task->count);
+        break;
+    case SO3_FORK_INVERSE_DIRECT:
+        status = so3_plan_execute_inverse_direct_batch(*plan, f, task->flmn, task->count);
+        break;
+    case SO3_FORK_FORWARD_DIRECT:
+        status = so3_plan_execute_forward_direct_batch(*plan, task->flmn, f, task->count);
+        break;
+    case SO3_FORK_INVERSE_DIRECT_REAL:
+        status = so3_plan_execute_inverse_direct_real_batch(*plan, fr, task->flmn, task->count);
+        break;
+    case SO3_FORK_FORWARD_DIRECT_REAL:
+        status = so3_plan_execute_forward_direct_real_batch(*plan, task->flmn, fr, task->count);
+        break;
+    default:
+        status = SO3_ERROR_INVALID_ARGUMENT;
+    }
+
+    // A plan whose setup failed keeps failing, so start afresh next time.
+    if (status != SO3_SUCCESS)
+    {
+        so3_plan_destroy(*plan);
+        *plan = NULL;
+    }
+
+    return status;
+}
+
+// Main loop of a helper process: execute the tasks posted by the
+// caller until it asks the helper to stop. Never returns.
+static void so3_fork_helper(so3_fork_task_t *task, sem_t *done)
+{
+    so3_plan_t *plan = NULL;
+
+#ifdef __linux__
+    // Do not outlive the caller, which would leave the helper waiting
+    // for tasks forever.
+    prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+
+    for (;;)
+    {
+        while (sem_wait(&task->start) && errno == EINTR)
+            ;
+        if (task->stop)
+            break;
+
+        task->status = so3_fork_execute(&plan, task);
+        __atomic_store_n(&task->finished, 1, __ATOMIC_RELEASE);
+        sem_post(done);
+    }
+
+    so3_plan_destroy(plan);
+
+    // Skip the exit handlers and stdio buffers of the caller.
+    _exit(0);
+}
+#endif
+
+//============================================================================
+// Pool
+//============================================================================
+
+/*!
+ * Create the shared arena and fork the helper processes. Should be
+ * called before the process starts any threads, since only the calling
+ * thread is duplicated by fork.
+ *
+ * \param[in]  nhelpers Number of helper processes, or 0 for one per
+ *                      processor.
+ * \param[in]  arena_size Number of bytes available to \link
+ *                        so3_fork_alloc \endlink.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink (also if the
+ *                pool is running),
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink,
+ *                \link SO3_ERROR_SYSTEM \endlink or
+ *                \link SO3_ERROR_UNSUPPORTED \endlink (other than on
+ *                Linux).
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_init(int nhelpers, size_t arena_size)
+{
+#ifdef __linux__
+    char name[64];
+    size_t control_size;
+    so3_fork_block_t *block;
+    int fd, h;
+
+    if (so3_fork_pool.mapping || nhelpers < 0 || arena_size == 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+    if (nhelpers == 0)
+        nhelpers = omp_get_num_procs();
+
+    control_size = sizeof(so3_fork_control_t) + nhelpers*sizeof(so3_fork_task_t);
+    control_size = (control_size + SO3_FORK_ALIGN-1) / SO3_FORK_ALIGN * SO3_FORK_ALIGN;
+    arena_size = (arena_size + SO3_FORK_ALIGN-1) / SO3_FORK_ALIGN * SO3_FORK_ALIGN + SO3_FORK_HEADER;
+
+    so3_fork_pool.helpers = calloc(nhelpers, sizeof *so3_fork_pool.helpers);
+    if (!so3_fork_pool.helpers)
+        return SO3_ERROR_OUT_OF_MEMORY;
+
+    // The name is only needed until the object is mapped.
+    snprintf(name, sizeof name, "/so3-fork-%ld", (long)getpid());
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+    {
+        free(so3_fork_pool.helpers);
+        so3_fork_pool.helpers = NULL;
+        return SO3_ERROR_SYSTEM;
+    }
+    shm_unlink(name);
+
+    so3_fork_pool.mapping_size = control_size + arena_size;
+    so3_fork_pool.mapping = MAP_FAILED;
+    if (ftruncate(fd, so3_fork_pool.mapping_size) == 0)
+        so3_fork_pool.mapping = mmap(NULL, so3_fork_pool.mapping_size,
+                                     PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (so3_fork_pool.mapping == MAP_FAILED)
+    {
+        so3_fork_pool.mapping = NULL;
+        free(so3_fork_pool.helpers);
+        so3_fork_pool.helpers = NULL;
+        return SO3_ERROR_SYSTEM;
+    }
+
+    so3_fork_pool.control = so3_fork_pool.mapping;
+    so3_fork_pool.arena = (char *)so3_fork_pool.mapping + control_size;
+    so3_fork_pool.arena_size = arena_size;
+    so3_fork_pool.broken = 0;
+
+    // The arena starts as a single free block.
+    block = (so3_fork_block_t *)so3_fork_pool.arena;
+    block->size = arena_size - SO3_FORK_HEADER;
+    block->free = 1;
+
+    sem_init(&so3_fork_pool.control->done, 1, 0);
+    for (h = 0; h < nhelpers; ++h)
+        sem_init(&so3_fork_pool.control->tasks[h].start, 1, 0);
+
+    fflush(NULL);
+    for (h = 0; h < nhelpers; ++h)
+    {
+        pid_t pid = fork();
+
+        if (pid == 0)
+            so3_fork_helper(&so3_fork_pool.control->tasks[h], &so3_fork_pool.control->done);
+        if (pid < 0)
+            break;
+
+        so3_fork_pool.helpers[h] = pid;
+        so3_fork_pool.nhelpers++;
+    }
+
+    if (so3_fork_pool.nhelpers < nhelpers)
+    {
+        so3_fork_finalize();
+        return SO3_ERROR_SYSTEM;
+    }
+
+    return SO3_SUCCESS;
+#else
+    return SO3_ERROR_UNSUPPORTED;
+#endif
+}
+
+/*!
+ * Stop the helper processes and release the shared arena, including all
+ * buffers allocated from it. The pool can be started again with \link
+ * so3_fork_init \endlink.
+ *
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_fork_finalize()
+{
+#ifdef __linux__
+    int h;
+
+    if (!so3_fork_pool.mapping)
+        return;
+
+    for (h = 0; h < so3_fork_pool.nhelpers; ++h)
+    {
+        so3_fork_pool.control->tasks[h].stop = 1;
+        sem_post(&so3_fork_pool.control->tasks[h].start);
+    }
+    for (h = 0; h < so3_fork_pool.nhelpers; ++h)
+        while (waitpid(so3_fork_pool.helpers[h], NULL, 0) < 0 && errno == EINTR)
+            ;
+
+    munmap(so3_fork_pool.mapping, so3_fork_pool.mapping_size);
+    free(so3_fork_pool.helpers);
+    memset(&so3_fork_pool, 0, sizeof so3_fork_pool);
+#endif
+}
+
+/*!
+ * Allocate a buffer from the shared arena, which can be passed to the
+ * batched functions of this file without being copied.
+ *
+ * \param[in]  size Number of bytes.
+ * \retval ptr Buffer aligned for FFTW, or NULL if the pool is not
+ *             running or the arena has no sufficient free block.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void *so3_fork_alloc(size_t size)
+{
+#ifdef __linux__
+    char *p, *end;
+
+    if (!so3_fork_pool.mapping || size == 0)
+        return NULL;
+
+    size = (size + SO3_FORK_ALIGN-1) / SO3_FORK_ALIGN * SO3_FORK_ALIGN;
+    end = so3_fork_pool.arena + so3_fork_pool.arena_size;
+
+    // First fit, splitting off the remainder if it can hold a block.
+    for (p = so3_fork_pool.arena; p < end; p += SO3_FORK_HEADER + ((so3_fork_block_t *)p)->size)
+    {
+        so3_fork_block_t *block = (so3_fork_block_t *)p;
+
+        if (!block->free || block->size < size)
+            continue;
+
+        if (block->size >= size + SO3_FORK_HEADER + SO3_FORK_ALIGN)
+        {
+            so3_fork_block_t *rest = (so3_fork_block_t *)(p + SO3_FORK_HEADER + size);
+
+            rest->size = block->size - size - SO3_FORK_HEADER;
+            rest->free = 1;
+            block->size = size;
+        }
+        block->free = 0;
+
+        return p + SO3_FORK_HEADER;
+    }
+#endif
+
+    return NULL;
+}
+
+/*!
+ * Return a buffer to the shared arena.
+ *
+ * \param[in]  ptr Buffer returned by \link so3_fork_alloc \endlink, or
+ *                 NULL.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_fork_free(void *ptr)
+{
+#ifdef __linux__
+    char *p, *end;
+    so3_fork_block_t *prev = NULL;
+
+    if (!ptr || !so3_fork_pool.mapping)
+        return;
+
+    ((so3_fork_block_t *)((char *)ptr - SO3_FORK_HEADER))->free = 1;
+
+    // Merge adjacent free blocks.
+    end = so3_fork_pool.arena + so3_fork_pool.arena_size;
+    for (p = so3_fork_pool.arena; p < end; p += SO3_FORK_HEADER + ((so3_fork_block_t *)p)->size)
+    {
+        so3_fork_block_t *block = (so3_fork_block_t *)p;
+
+        if (prev && prev->free && block->free)
+        {
+            prev->size += SO3_FORK_HEADER + block->size;
+            p = (char *)prev;
+            continue;
+        }
+        prev = block;
+    }
+#endif
+}
+
+//============================================================================
+// Dispatch
+//============================================================================
+
+#ifdef __linux__
+// Check whether size bytes at ptr lie within the arena.
+static int so3_fork_in_arena(const void *ptr, size_t size)
+{
+    const char *p = ptr;
+
+    return p >= so3_fork_pool.arena
+           && size <= so3_fork_pool.arena_size
+           && p - so3_fork_pool.arena <= so3_fork_pool.arena_size - size;
+}
+
+// Wait until all helpers with a task have finished it. Returns 0 if a
+// helper has terminated instead.
+static int so3_fork_wait(const int *assigned)
+{
+    struct timespec deadline;
+    int h, pending, alive = 1;
+
+    for (;;)
+    {
+        pending = 0;
+        for (h = 0; h < so3_fork_pool.nhelpers; ++h)
+            if (assigned[h] && !__atomic_load_n(&so3_fork_pool.control->tasks[h].finished, __ATOMIC_ACQUIRE))
+                pending++;
+        if (pending == 0 || !alive)
+            break;
+
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += SO3_FORK_POLL_NS;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        if (sem_timedwait(&so3_fork_pool.control->done, &deadline) == 0)
+            continue;
+
+        for (h = 0; h < so3_fork_pool.nhelpers; ++h)
+            if (assigned[h] && waitpid(so3_fork_pool.helpers[h], NULL, WNOHANG) != 0)
+                alive = 0;
+    }
+
+    return pending == 0;
+}
+#endif
+
+// Split a batch over the helpers and wait for the result.
+static so3_status_t so3_fork_dispatch(
+    so3_fork_kind_t kind, void *f, complex double *flmn,
+    int count, const so3_parameters_t *parameters
+) {
+#ifdef __linux__
+    so3_parameters_t p;
+    so3_status_t status;
+    size_t f_dist, flmn_dist, f_elem;
+    int *assigned;
+    int nhelpers, h;
+
+    if (!so3_fork_pool.mapping || so3_fork_pool.broken)
+        return SO3_ERROR_SYSTEM;
+    if (count < 0 || so3_sampling_check_parameters(parameters) != SO3_SUCCESS)
+        return SO3_ERROR_INVALID_ARGUMENT;
+    if (kind >= SO3_FORK_INVERSE_DIRECT
+        && (parameters->sampling_scheme != SO3_SAMPLING_MW || parameters->steerable))
+        return SO3_ERROR_UNSUPPORTED;
+    if (count == 0)
+        return SO3_SUCCESS;
+
+    // Each helper runs a single thread, so that the helpers together
+    // use the processors. Pinning would place them all on one CPU.
+    p = *parameters;
+    p.reality = so3_fork_is_real(kind);
+    p.verbosity = 0;
+    p.num_threads = 1;
+    p.numa = 0;
+
+    f_dist = so3_sampling_f_size(&p);
+    flmn_dist = so3_fork_flmn_dist(&p, p.reality);
+    f_elem = p.reality ? sizeof(double) : sizeof(complex double);
+    if (!f || !flmn
+        || !so3_fork_in_arena(f, count*f_dist*f_elem)
+        || !so3_fork_in_arena(flmn, count*flmn_dist*sizeof *flmn))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    nhelpers = so3_fork_pool.nhelpers;
+    assigned = calloc(nhelpers, sizeof *assigned);
+    if (!assigned)
+        return SO3_ERROR_OUT_OF_MEMORY;
+
+    // Contiguous ranges of signals, one per helper.
+    for (h = 0; h < nhelpers; ++h)
+    {
+        so3_fork_task_t *task = &so3_fork_pool.control->tasks[h];
+        int first = (long)count * h / nhelpers;
+        int stop = (long)count * (h+1) / nhelpers;
+
+        if (stop == first)
+            continue;
+
+        task->kind = kind;
+        task->f = (char *)f + first*f_dist*f_elem;
+        task->flmn = flmn + first*flmn_dist;
+        task->count = stop - first;
+        task->parameters = p;
+        task->status = SO3_SUCCESS;
+        task->finished = 0;
+        assigned[h] = 1;
+        sem_post(&task->start);
+    }
+
+    if (!so3_fork_wait(assigned))
+    {
+        so3_fork_pool.broken = 1;
+        free(assigned);
+        return SO3_ERROR_SYSTEM;
+    }
+
+    status = SO3_SUCCESS;
+    for (h = 0; h < nhelpers; ++h)
+        if (assigned[h] && so3_fork_pool.control->tasks[h].status != SO3_SUCCESS)
+        {
+            status = so3_fork_pool.control->tasks[h].status;
+            break;
+        }
+
+    free(assigned);
+
+    return status;
+#else
+    return SO3_ERROR_UNSUPPORTED;
+#endif
+}
+
+/*!
+ * Batched inverse Wigner transforms for complex signals via SSHT,
+ * executed by the helper processes. Blocks until all signals are done.
+ *
+ * \param[out] f Functions on sphere, one after the other, in a buffer
+ *               from \link so3_fork_alloc \endlink. Provide count times
+ *               the size given by \link so3_sampling_f_size \endlink.
+ * \param[in]  flmn Harmonic coefficients, one set after the other, in a
+ *                  buffer from \link so3_fork_alloc \endlink.
+ * \param[in]  count Number of signals.
+ * \param[in]  parameters A fully populated parameters object. The
+ *                        \link so3_parameters_t::verbosity verbosity\endlink,
+ *                        \link so3_parameters_t::num_threads num_threads\endlink
+ *                        and \link so3_parameters_t::numa numa\endlink
+ *                        fields are ignored.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink (also for
+ *                buffers outside the arena),
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink,
+ *                \link SO3_ERROR_SYSTEM \endlink (if the pool is not
+ *                running or a helper has terminated),
+ *                \link SO3_ERROR_UNSUPPORTED \endlink (other than on
+ *                Linux) or the error of a transform.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_inverse_via_ssht_batch(
+    complex double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+) {
+    return so3_fork_dispatch(SO3_FORK_INVERSE, f, (complex double *)flmn, count, parameters);
+}
+
+/*!
+ * Batched forward Wigner transforms for complex signals via SSHT,
+ * executed by the helper processes. See \link
+ * so3_fork_inverse_via_ssht_batch \endlink for the arguments and
+ * errors.
+ *
+ * \param[out] flmn Harmonic coefficients. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in]  f Functions on sphere.
+ * \param[in]  count Number of signals.
+ * \param[in]  parameters A fully populated parameters object.
+ * \retval status Status of the transforms.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_forward_via_ssht_batch(
+    complex double *flmn, const complex double *f,
+    int count, const so3_parameters_t *parameters
+) {
+    return so3_fork_dispatch(SO3_FORK_FORWARD, (complex double *)f, flmn, count, parameters);
+}
+
+/*!
+ * Batched inverse Wigner transforms for real signals via SSHT, executed
+ * by the helper processes. See \link so3_fork_inverse_via_ssht_batch
+ * \endlink for the arguments and errors.
+ *
+ * \param[out] f Functions on sphere.
+ * \param[in]  flmn Harmonic coefficients for n >= 0, each set of the
+ *                  size given by \link so3_sampling_flmn_size \endlink
+ *                  for real signals.
+ * \param[in]  count Number of signals.
+ * \param[in]  parameters A fully populated parameters object. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored.
+ * \retval status Status of the transforms.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_inverse_via_ssht_real_batch(
+    double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+) {
+    return so3_fork_dispatch(SO3_FORK_INVERSE_REAL, f, (complex double *)flmn, count, parameters);
+}
+
+/*!
+ * Batched forward Wigner transforms for real signals via SSHT, executed
+ * by the helper processes. See \link so3_fork_inverse_via_ssht_batch
+ * \endlink for the arguments and errors.
+ *
+ * \param[out] flmn Harmonic coefficients for n >= 0.
+ * \param[in]  f Functions on sphere.
+ * \param[in]  count Number of signals.
+ * \param[in]  parameters A fully populated parameters object. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored.
+ * \retval status Status of the transforms.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_forward_via_ssht_real_batch(
+    complex double *flmn, const double *f,
+    int count, const so3_parameters_t *parameters
+) {
+    return so3_fork_dispatch(SO3_FORK_FORWARD_REAL, (double *)f, flmn, count, parameters);
+}
+
+/*!
+ * Batched inverse Wigner transforms for complex signals computed
+ * directly (without using SSHT), executed by the helper processes. See
+ * \link so3_fork_inverse_via_ssht_batch \endlink for the arguments and
+ * errors.
+ *
+ * \param[out] f Functions on sphere.
+ * \param[in]  flmn Harmonic coefficients.
+ * \param[in]  count Number of signals.
+ * \param[in]  parameters A fully populated parameters object.
+ * \retval status Status of the transforms, \link
+ *                SO3_ERROR_UNSUPPORTED \endlink unless MW sampling
+ *                without the steerable flag.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_inverse_direct_batch(
+    complex double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+) {
+    return so3_fork_dispatch(SO3_FORK_INVERSE_DIRECT, f, (complex double *)flmn, count, parameters);
+}
+
+/*!
+ * Batched forward Wigner transforms for complex signals computed
+ * directly (without using SSHT), executed by the helper processes. See
+ * \link so3_fork_inverse_via_ssht_batch \endlink for the arguments and
+ * errors.
+ *
+ * \param[out] flmn Harmonic coefficients.
+ * \param[in]  f Functions on sphere.
+ * \param[in]  count Number of signals.
+ * \param[in]  parameters A fully populated parameters object.
+ * \retval status Status of the transforms, \link
+ *                SO3_ERROR_UNSUPPORTED \endlink unless MW sampling
+ *                without the steerable flag.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_forward_direct_batch(
+    complex double *flmn, const complex double *f,
+    int count, const so3_parameters_t *parameters
+) {
+    return so3_fork_dispatch(SO3_FORK_FORWARD_DIRECT, (complex double *)f, flmn, count, parameters);
+}
+
+/*!
+ * Batched inverse Wigner transforms for real signals computed directly
+ * (without using SSHT), executed by the helper processes. See \link
+ * so3_fork_inverse_via_ssht_real_batch \endlink for the arguments and
+ * errors.
+ *
+ * \param[out] f Functions on sphere.
+ * \param[in]  flmn Harmonic coefficients for n >= 0.
+ * \param[in]  count Number of signals.
+ * \param[in]  parameters A fully populated parameters object.
+ * \retval status Status of the transforms, \link
+ *                SO3_ERROR_UNSUPPORTED \endlink unless MW sampling
+ *                without the steerable flag.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_inverse_direct_real_batch(
+    double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+) {
+    return so3_fork_dispatch(SO3_FORK_INVERSE_DIRECT_REAL, f, (complex double *)flmn, count, parameters);
+}
+
+/*!
+ * Batched forward Wigner transforms for real signals computed directly
+ * (without using SSHT), executed by the helper processes. See \link
+ * so3_fork_inverse_via_ssht_real_batch \endlink for the arguments and
+ * errors.
+ *
+ * \param[out] flmn Harmonic coefficients for n >= 0.
+ * \param[in]  f Functions on sphere.
+ * \param[in]  count Number of signals.
+ * \param[in]  parameters A fully populated parameters object.
+ * \retval status Status of the transforms, \link
+ *                SO3_ERROR_UNSUPPORTED \endlink unless MW sampling
+ *                without the steerable flag.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_fork_forward_direct_real_batch(
+    complex double *flmn, const double *f,
+    int count, const so3_parameters_t *parameters
+) {
+    return so3_fork_dispatch(SO3_FORK_FORWARD_DIRECT_REAL, (double *)f, flmn, count, parameters);
+}
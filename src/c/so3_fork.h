@@ -0,0 +1,68 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_fork.h
+ *  Batched transforms executed by a pool of forked helper processes,
+ *  which share the signal and coefficient buffers with the caller.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_FORK
+#define SO3_FORK
+
+#include <stddef.h>
+#include <complex.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+
+so3_status_t so3_fork_init(int nhelpers, size_t arena_size);
+void so3_fork_finalize();
+
+void *so3_fork_alloc(size_t size);
+void so3_fork_free(void *ptr);
+
+so3_status_t so3_fork_inverse_via_ssht_batch(
+    complex double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_fork_forward_via_ssht_batch(
+    complex double *flmn, const complex double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_fork_inverse_via_ssht_real_batch(
+    double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_fork_forward_via_ssht_real_batch(
+    complex double *flmn, const double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_fork_inverse_direct_batch(
+    complex double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_fork_forward_direct_batch(
+    complex double *flmn, const complex double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_fork_inverse_direct_real_batch(
+    double *f, const complex double *flmn,
+    int count, const so3_parameters_t *parameters
+);
+
+so3_status_t so3_fork_forward_direct_real_batch(
+    complex double *flmn, const double *f,
+    int count, const so3_parameters_t *parameters
+);
+
+#endif
@@ -0,0 +1,727 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_mpi.c
+ * Wigner transforms of complex signals, distributed over the
+ * processes (ranks) of an MPI communicator, such that both the memory
+ * and the work per rank scale inversely with the number of ranks.
+ *
+ * Each rank holds a contiguous range of the n blocks of flmn (in the
+ * storage order given by the parameters) and a contiguous range of the
+ * gamma samples of f, see \link so3_mpi_get_distribution \endlink. The
+ * spherical harmonic transforms for the n of a rank are computed
+ * locally, by the separation-of-variables engine of the plans applied
+ * to the slab of these n. The FFTs over gamma need all n of a sample on
+ * the sphere, so they are performed between two distributed transposes,
+ * on a range of the samples on the sphere per rank:
+ *
+ *   flmn (n blocks) -> fn (n blocks) -> fn (samples) -> f (samples)
+ *   -> f (gamma samples)
+ *
+ * and the reverse for the forward transform.
+ *
+ * The direct transforms use the same distribution and the same
+ * computation: for MW sampling, the slabs of the 3D FFT over (m', m, n)
+ * of the direct inverse transform are those of the separation-of-
+ * variables engine, with the FFT over n performed between the
+ * transposes. The forward transform reverses this.
+ *
+ * All ranks have to call the functions of this file collectively with
+ * the same parameters.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>  // Must be before fftw3.h
+#include <fftw3.h>
+#include <mpi.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+#include "so3_sampling.h"
+#include "so3_plan.h"
+#include "so3_plan_internal.h"
+#include "so3_mpi.h"
+
+// Distribution of the data of a transform over the ranks, and the
+// scratch buffers of the calling rank.
+typedef struct {
+    // Copy of the parameters, for a complex signal.
+    so3_parameters_t parameters;
+    MPI_Comm comm;
+    int rank, nranks;
+
+    // Number of samples on the sphere (per gamma), of gamma samples and
+    // length of the FFTs over gamma (which is larger than the number of
+    // samples for steerable signals, see so3_core_inverse_via_ssht).
+    int fn_n_stride;
+    int ngamma;
+    int fftw_n;
+
+    // Ranges of the n blocks, gamma samples and samples on the sphere of
+    // the calling rank, and offset of its first n block in flmn.
+    int k_first, k_stop;
+    int g_first, g_stop;
+    int p_first, p_stop;
+    int flmn_base;
+
+    // fn of the local n blocks, and the buffers of the transposes.
+    complex double *fn, *sendbuf, *recvbuf;
+
+    // Counts and displacements of the distributed transposes.
+    int *sendcounts, *sdispls, *recvcounts, *rdispls;
+} so3_mpi_layout_t;
+
+// First of count items (n blocks, gamma samples or samples on the
+// sphere) assigned to rank r. Rank r holds [first(r), first(r+1)).
+static int so3_mpi_first(int count, int nranks, int r)
+{
+    return (long)count * r / nranks;
+}
+
+// Offset of the kth block of flmn. For k = 2N-1, the size of flmn.
+static int so3_mpi_block_offset(const so3_parameters_t *parameters, int k)
+{
+    int n, ind;
+
+    if (k == 2*parameters->N-1)
+        return so3_sampling_flmn_size(parameters);
+
+    n = so3_plan_block_n(parameters, k);
+    if (parameters->storage == SO3_STORAGE_PADDED)
+        so3_sampling_elmn2ind(&ind, 0, 0, n, parameters);
+    else
+        so3_sampling_elmn2ind(&ind, abs(n), -abs(n), n, parameters);
+
+    return ind;
+}
+
+// Combine the status of all ranks, such that either all ranks continue
+// or all return the same error, rather than some of them waiting for
+// the others in a collective operation.
+static so3_status_t so3_mpi_agree(so3_status_t status, MPI_Comm comm)
+{
+    int local = status, global;
+
+    MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MAX, comm);
+
+    return global;
+}
+
+static void so3_mpi_layout_destroy(so3_mpi_layout_t *layout)
+{
+    free(layout->fn);
+    free(layout->sendbuf);
+    free(layout->recvbuf);
+    free(layout->sendcounts);
+    free(layout->sdispls);
+    free(layout->recvcounts);
+    free(layout->rdispls);
+}
+
+// Validate the parameters and set up the distribution, including the
+// scratch buffers if requested. Collective.
+static so3_status_t so3_mpi_layout_init(
+    so3_mpi_layout_t *layout,
+    const so3_parameters_t *parameters, MPI_Comm comm, int buffers
+) {
+    so3_status_t status;
+    int L, N, nranks, rank, nlocal, buffer_size;
+
+    memset(layout, 0, sizeof *layout);
+    if (!parameters)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nranks);
+    layout->rank = rank;
+    layout->nranks = nranks;
+
+    status = so3_sampling_check_parameters(parameters);
+    if (status == SO3_SUCCESS)
+    {
+        layout->parameters = *parameters;
+        layout->parameters.reality = 0;
+        layout->comm = comm;
+
+        L = parameters->L;
+        N = parameters->N;
+        layout->fn_n_stride = parameters->sampling_scheme == SO3_SAMPLING_MW_SS
+                              ? (L+1) * 2*L
+                              : L * (2*L-1);
+        layout->ngamma = parameters->steerable ? N : 2*N-1;
+        layout->fftw_n = parameters->steerable ? 2*N : 2*N-1;
+
+        layout->k_first = so3_mpi_first(2*N-1, nranks, rank);
+        layout->k_stop = so3_mpi_first(2*N-1, nranks, rank+1);
+        layout->g_first = so3_mpi_first(layout->ngamma, nranks, rank);
+        layout->g_stop = so3_mpi_first(layout->ngamma, nranks, rank+1);
+        layout->p_first = so3_mpi_first(layout->fn_n_stride, nranks, rank);
+        layout->p_stop = so3_mpi_first(layout->fn_n_stride, nranks, rank+1);
+        layout->flmn_base = so3_mpi_block_offset(&layout->parameters, layout->k_first);
+
+        layout->sendcounts = malloc(nranks * sizeof *layout->sendcounts);
+        layout->sdispls = malloc(nranks * sizeof *layout->sdispls);
+        layout->recvcounts = malloc(nranks * sizeof *layout->recvcounts);
+        layout->rdispls = malloc(nranks * sizeof *layout->rdispls);
+        if (!layout->sendcounts || !layout->sdispls
+            || !layout->recvcounts || !layout->rdispls)
+            status = SO3_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (status == SO3_SUCCESS && buffers)
+    {
+        // The buffers of the transposes hold the local fn, all n or
+        // gamma samples of the local samples on the sphere, and the
+        // local gamma samples.
+        nlocal = layout->p_stop - layout->p_first;
+        buffer_size = MAX(MAX((layout->k_stop - layout->k_first)*layout->fn_n_stride,
+                              nlocal*layout->fftw_n),
+                          MAX((2*N-1)*nlocal,
+                              (layout->g_stop - layout->g_first)*layout->fn_n_stride));
+        layout->fn = malloc(MAX((layout->k_stop - layout->k_first)*layout->fn_n_stride, 1)
+                            * sizeof *layout->fn);
+        layout->sendbuf = malloc(MAX(buffer_size, 1) * sizeof *layout->sendbuf);
+        layout->recvbuf = malloc(MAX(buffer_size, 1) * sizeof *layout->recvbuf);
+        if (!layout->fn || !layout->sendbuf || !layout->recvbuf)
+            status = SO3_ERROR_OUT_OF_MEMORY;
+    }
+
+    status = so3_mpi_agree(status, comm);
+    if (status != SO3_SUCCESS)
+        so3_mpi_layout_destroy(layout);
+
+    return status;
+}
+
+// Exchange data between all ranks. The counts are set by the caller,
+// the displacements are computed from them.
+static void so3_mpi_alltoall(
+    so3_mpi_layout_t *layout,
+    const complex double *sendbuf, complex double *recvbuf
+) {
+    int r;
+
+    layout->sdispls[0] = layout->rdispls[0] = 0;
+    for (r = 1; r < layout->nranks; ++r)
+    {
+        layout->sdispls[r] = layout->sdispls[r-1] + layout->sendcounts[r-1];
+        layout->rdispls[r] = layout->rdispls[r-1] + layout->recvcounts[r-1];
+    }
+
+    MPI_Alltoallv((void *)sendbuf, layout->sendcounts, layout->sdispls, MPI_C_DOUBLE_COMPLEX,
+                  recvbuf, layout->recvcounts, layout->rdispls, MPI_C_DOUBLE_COMPLEX,
+                  layout->comm);
+}
+
+// In-place FFTs over gamma of count contiguous columns of length fftw_n.
+// The FFTW planner is not thread-safe, see so3_plan.c.
+static void so3_mpi_fft_gamma(
+    const so3_mpi_layout_t *layout, complex double *columns, int count, int sign
+) {
+    int fftw_n = layout->fftw_n;
+    fftw_plan plan;
+
+    if (count == 0)
+        return;
+
+    #pragma omp critical (so3_fftw_planner)
+    plan = fftw_plan_many_dft(
+            1, &fftw_n, count,
+            columns, NULL, 1, fftw_n,
+            columns, NULL, 1, fftw_n,
+            sign, FFTW_ESTIMATE
+    );
+    fftw_execute(plan);
+    #pragma omp critical (so3_fftw_planner)
+    fftw_destroy_plan(plan);
+}
+
+// Compute the local gamma samples of f from the fn of the local n
+// blocks (layout->fn), by FFTs over gamma between two transposes.
+static void so3_mpi_inverse_gamma(so3_mpi_layout_t *layout, complex double *f)
+{
+    const so3_parameters_t *parameters = &layout->parameters;
+    int nranks = layout->nranks;
+    int nblocks = 2*parameters->N-1;
+    int fn_n_stride = layout->fn_n_stride;
+    int fftw_n = layout->fftw_n;
+    int k_first = layout->k_first, k_stop = layout->k_stop;
+    int g_first = layout->g_first, g_stop = layout->g_stop;
+    int p_count = layout->p_stop - layout->p_first;
+    complex double *fn = layout->fn;
+    complex double *sendbuf = layout->sendbuf;
+    complex double *recvbuf = layout->recvbuf;
+    int r, k, g, p;
+
+    // Transpose, such that each rank receives all n of its samples on
+    // the sphere. Since the n blocks are assigned to the ranks in order,
+    // the received data is ordered by block.
+    for (r = 0; r < nranks; ++r)
+    {
+        int r_first = so3_mpi_first(fn_n_stride, nranks, r);
+        int r_count = so3_mpi_first(fn_n_stride, nranks, r+1) - r_first;
+        complex double *send = sendbuf + (k_stop-k_first)*r_first;
+
+        for (k = k_first; k < k_stop; ++k)
+            memcpy(send + (k-k_first)*r_count,
+                   fn + (k-k_first)*fn_n_stride + r_first,
+                   r_count * sizeof *send);
+
+        layout->sendcounts[r] = (k_stop-k_first)*r_count;
+        layout->recvcounts[r] = (so3_mpi_first(nblocks, nranks, r+1)
+                                 - so3_mpi_first(nblocks, nranks, r))*p_count;
+    }
+    so3_mpi_alltoall(layout, sendbuf, recvbuf);
+
+    // Arrange the columns over gamma in n-order 0, 1, 2, -2, -1, and
+    // perform the FFTs over gamma.
+    memset(sendbuf, 0, p_count*fftw_n * sizeof *sendbuf);
+    for (k = 0; k < nblocks; ++k)
+    {
+        int n = so3_plan_block_n(parameters, k);
+        int offset = n < 0 ? n + fftw_n : n;
+
+        for (p = 0; p < p_count; ++p)
+            sendbuf[offset + fftw_n*p] = recvbuf[p + p_count*k];
+    }
+    so3_mpi_fft_gamma(layout, sendbuf, p_count, FFTW_BACKWARD);
+
+    // Transpose back, such that each rank receives all samples on the
+    // sphere of its gamma samples.
+    memcpy(recvbuf, sendbuf, p_count*fftw_n * sizeof *recvbuf);
+    for (r = 0; r < nranks; ++r)
+    {
+        int r_first = so3_mpi_first(layout->ngamma, nranks, r);
+        int r_count = so3_mpi_first(layout->ngamma, nranks, r+1) - r_first;
+        complex double *send = sendbuf + p_count*r_first;
+
+        for (p = 0; p < p_count; ++p)
+            memcpy(send + p*r_count,
+                   recvbuf + fftw_n*p + r_first,
+                   r_count * sizeof *send);
+
+        layout->sendcounts[r] = p_count*r_count;
+        layout->recvcounts[r] = (so3_mpi_first(fn_n_stride, nranks, r+1)
+                                 - so3_mpi_first(fn_n_stride, nranks, r))*(g_stop-g_first);
+    }
+    so3_mpi_alltoall(layout, sendbuf, recvbuf);
+
+    for (r = 0; r < nranks; ++r)
+    {
+        int r_first = so3_mpi_first(fn_n_stride, nranks, r);
+        int r_count = so3_mpi_first(fn_n_stride, nranks, r+1) - r_first;
+        const complex double *recv = recvbuf + layout->rdispls[r];
+
+        for (p = 0; p < r_count; ++p)
+            for (g = g_first; g < g_stop; ++g)
+                f[r_first + p + fn_n_stride*(g-g_first)] = recv[g-g_first + (g_stop-g_first)*p];
+    }
+}
+
+// Compute the fn of the local n blocks (layout->fn), scaled by factor,
+// from the local gamma samples of f, by FFTs over gamma between two
+// transposes. Steerable signals only have n of the parity of N-1.
+static void so3_mpi_forward_gamma(
+    so3_mpi_layout_t *layout, const complex double *f, double factor
+) {
+    const so3_parameters_t *parameters = &layout->parameters;
+    int nranks = layout->nranks;
+    int N = parameters->N;
+    int nblocks = 2*N-1;
+    int fn_n_stride = layout->fn_n_stride;
+    int fftw_n = layout->fftw_n;
+    int ngamma = layout->ngamma;
+    int k_first = layout->k_first, k_stop = layout->k_stop;
+    int g_first = layout->g_first, g_stop = layout->g_stop;
+    int p_count = layout->p_stop - layout->p_first;
+    complex double *fn = layout->fn;
+    complex double *sendbuf = layout->sendbuf;
+    complex double *recvbuf = layout->recvbuf;
+    int r, k, g, p;
+
+    // Transpose, such that each rank receives all gamma samples of its
+    // samples on the sphere, ordered by gamma.
+    for (r = 0; r < nranks; ++r)
+    {
+        int r_first = so3_mpi_first(fn_n_stride, nranks, r);
+        int r_count = so3_mpi_first(fn_n_stride, nranks, r+1) - r_first;
+        complex double *send = sendbuf + (g_stop-g_first)*r_first;
+
+        for (g = g_first; g < g_stop; ++g)
+            memcpy(send + (g-g_first)*r_count,
+                   f + (g-g_first)*fn_n_stride + r_first,
+                   r_count * sizeof *send);
+
+        layout->sendcounts[r] = (g_stop-g_first)*r_count;
+        layout->recvcounts[r] = (so3_mpi_first(ngamma, nranks, r+1)
+                                 - so3_mpi_first(ngamma, nranks, r))*p_count;
+    }
+    so3_mpi_alltoall(layout, sendbuf, recvbuf);
+
+    // Perform the FFTs over gamma. For steerable signals, the N samples
+    // cover only half the period of the FFT over 2N, and the remaining
+    // samples are zero.
+    memset(sendbuf, 0, p_count*fftw_n * sizeof *sendbuf);
+    for (g = 0; g < ngamma; ++g)
+        for (p = 0; p < p_count; ++p)
+            sendbuf[g + fftw_n*p] = recvbuf[p + p_count*g];
+    so3_mpi_fft_gamma(layout, sendbuf, p_count, FFTW_FORWARD);
+
+    // Transpose back, such that each rank receives all samples on the
+    // sphere of its n.
+    memcpy(recvbuf, sendbuf, p_count*fftw_n * sizeof *recvbuf);
+    for (r = 0; r < nranks; ++r)
+    {
+        int r_first = so3_mpi_first(nblocks, nranks, r);
+        int r_stop = so3_mpi_first(nblocks, nranks, r+1);
+        complex double *send = sendbuf + p_count*r_first;
+
+        for (k = r_first; k < r_stop; ++k)
+        {
+            int n = so3_plan_block_n(parameters, k);
+            int offset = n < 0 ? n + fftw_n : n;
+            int zero = parameters->steerable && (n + N-1) % 2;
+
+            for (p = 0; p < p_count; ++p)
+                send[p + p_count*(k-r_first)] = zero ? 0.0 : factor*recvbuf[offset + fftw_n*p];
+        }
+
+        layout->sendcounts[r] = p_count*(r_stop-r_first);
+        layout->recvcounts[r] = (so3_mpi_first(fn_n_stride, nranks, r+1)
+                                 - so3_mpi_first(fn_n_stride, nranks, r))*(k_stop-k_first);
+    }
+    so3_mpi_alltoall(layout, sendbuf, recvbuf);
+
+    for (r = 0; r < nranks; ++r)
+    {
+        int r_first = so3_mpi_first(fn_n_stride, nranks, r);
+        int r_count = so3_mpi_first(fn_n_stride, nranks, r+1) - r_first;
+        const complex double *recv = recvbuf + layout->rdispls[r];
+
+        for (k = k_first; k < k_stop; ++k)
+            memcpy(fn + (k-k_first)*fn_n_stride + r_first,
+                   recv + (k-k_first)*r_count,
+                   r_count * sizeof *fn);
+    }
+}
+
+// Create a plan whose separation-of-variables engine computes the
+// slab of the local n blocks of a layout.
+// The forward transforms also need the quadrature weights. Ranks
+// without n blocks get no plan.
+static so3_status_t so3_mpi_plan_sov(
+    so3_plan_t **plan, so3_plan_slab_t *slab,
+    const so3_mpi_layout_t *layout, int forward
+) {
+    so3_status_t status;
+
+    *plan = NULL;
+    slab->k_first = layout->k_first;
+    slab->k_stop = layout->k_stop;
+    slab->flmn_base = layout->flmn_base;
+    if (slab->k_stop == slab->k_first)
+        return SO3_SUCCESS;
+
+    status = so3_plan_create_r(plan, &layout->parameters, FFTW_ESTIMATE);
+    if (status != SO3_SUCCESS)
+        return status;
+
+    // The FFTW planner is not thread-safe.
+    #pragma omp critical (so3_fftw_planner)
+    {
+        so3_plan_setup_sov(*plan);
+        if (forward)
+            so3_plan_setup_weights(*plan);
+    }
+    so3_plan_setup_sov_batch(*plan, 1, slab->k_stop - slab->k_first);
+
+    return (*plan)->status;
+}
+
+// Compute the inverse transform of the local n slab with the
+// separation-of-variables engine of the plans, followed by the FFTs over
+// gamma. For MW sampling, the slabs of the engine are those of the 3D
+// FFT of the direct transform, so this serves both the transforms via
+// SSHT and the direct transforms.
+static so3_status_t so3_mpi_inverse(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters, MPI_Comm comm
+) {
+    so3_mpi_layout_t layout;
+    so3_plan_slab_t slab;
+    so3_plan_t *plan = NULL;
+    so3_status_t status;
+    int nlocal;
+
+    status = so3_mpi_layout_init(&layout, parameters, comm, 1);
+    if (status != SO3_SUCCESS)
+        return status;
+
+    nlocal = layout.k_stop - layout.k_first;
+    if ((!f || !flmn) && (nlocal > 0 || layout.g_stop > layout.g_first))
+        status = SO3_ERROR_INVALID_ARGUMENT;
+    else
+        status = so3_mpi_plan_sov(&plan, &slab, &layout, 0);
+    status = so3_mpi_agree(status, comm);
+    if (status != SO3_SUCCESS)
+    {
+        so3_plan_destroy(plan);
+        so3_mpi_layout_destroy(&layout);
+        return status;
+    }
+
+    // Compute fn(a,b) for the local n, in a single pass over el. Blocks
+    // for skipped n must be zero.
+    memset(layout.fn, 0, nlocal*layout.fn_n_stride * sizeof *layout.fn);
+    if (plan)
+        so3_plan_sov_inverse(plan, layout.fn, nlocal*layout.fn_n_stride, layout.fftw_n,
+                             flmn, so3_mpi_block_offset(&layout.parameters, layout.k_stop) - layout.flmn_base,
+                             1, 0, &slab, NULL);
+
+    so3_mpi_inverse_gamma(&layout, f);
+
+    so3_plan_destroy(plan);
+    so3_mpi_layout_destroy(&layout);
+
+    return SO3_SUCCESS;
+}
+
+// Compute the forward transform of the local n slab, see
+// so3_mpi_inverse.
+static so3_status_t so3_mpi_forward(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters, MPI_Comm comm
+) {
+    so3_mpi_layout_t layout;
+    so3_plan_slab_t slab;
+    so3_plan_t *plan = NULL;
+    so3_status_t status;
+    int nlocal;
+
+    status = so3_mpi_layout_init(&layout, parameters, comm, 1);
+    if (status != SO3_SUCCESS)
+        return status;
+
+    nlocal = layout.k_stop - layout.k_first;
+    if ((!f || !flmn) && (nlocal > 0 || layout.g_stop > layout.g_first))
+        status = SO3_ERROR_INVALID_ARGUMENT;
+    else
+        status = so3_mpi_plan_sov(&plan, &slab, &layout, 1);
+    status = so3_mpi_agree(status, comm);
+    if (status != SO3_SUCCESS)
+    {
+        so3_plan_destroy(plan);
+        so3_mpi_layout_destroy(&layout);
+        return status;
+    }
+
+    so3_mpi_forward_gamma(&layout, f, 2*SO3_PI/(double)layout.ngamma);
+
+    // Compute flmn for the local n, in a single pass over el.
+    if (plan)
+        so3_plan_sov_forward(plan, flmn, so3_mpi_block_offset(&layout.parameters, layout.k_stop) - layout.flmn_base,
+                             layout.fn, nlocal*layout.fn_n_stride, layout.fftw_n,
+                             1, 0, &slab, NULL);
+
+    so3_plan_destroy(plan);
+    so3_mpi_layout_destroy(&layout);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Get the parts of flmn and f held by the calling rank in the
+ * distributed transforms. Rank r holds a contiguous range of the n
+ * blocks of flmn and of the gamma samples of f, such that the ranks
+ * together hold the full arrays in rank order. Some ranks may hold
+ * nothing if there are more ranks than n or gamma samples.
+ *
+ * \param[out] flmn_offset Offset of the first coefficient of the rank
+ *                         within the full flmn array.
+ * \param[out] flmn_size Number of coefficients held by the rank.
+ * \param[out] f_offset Offset of the first sample of the rank within
+ *                      the full f array.
+ * \param[out] f_size Number of samples held by the rank.
+ * \param[in]  parameters A fully populated parameters object. The
+ *                        \link so3_parameters_t::reality reality\endlink
+ *                        flag is ignored.
+ * \param[in]  comm Communicator of the ranks which perform the
+ *                  transforms.
+ * \retval status \link SO3_SUCCESS \endlink, \link
+ *                SO3_ERROR_INVALID_ARGUMENT \endlink or \link
+ *                SO3_ERROR_OUT_OF_MEMORY \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_mpi_get_distribution(
+    int *flmn_offset, int *flmn_size,
+    int *f_offset, int *f_size,
+    const so3_parameters_t *parameters, MPI_Comm comm
+) {
+    so3_mpi_layout_t layout;
+    so3_status_t status;
+
+    if (!flmn_offset || !flmn_size || !f_offset || !f_size)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    status = so3_mpi_layout_init(&layout, parameters, comm, 0);
+    if (status != SO3_SUCCESS)
+        return status;
+
+    *flmn_offset = layout.flmn_base;
+    *flmn_size = so3_mpi_block_offset(&layout.parameters, layout.k_stop) - layout.flmn_base;
+    *f_offset = layout.g_first * layout.fn_n_stride;
+    *f_size = (layout.g_stop - layout.g_first) * layout.fn_n_stride;
+
+    so3_mpi_layout_destroy(&layout);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Compute the inverse Wigner transform for a complex signal via SSHT,
+ * distributed over the ranks of a communicator. Collective.
+ *
+ * \param[out] f Part of the function on SO(3) held by the rank, see
+ *               \link so3_mpi_get_distribution \endlink.
+ * \param[in]  flmn Part of the harmonic coefficients held by the rank.
+ * \param[in]  parameters A fully populated parameters object, the same
+ *                        on all ranks. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored.
+ * \param[in]  comm Communicator of the ranks which perform the
+ *                  transform.
+ * \retval status \link SO3_SUCCESS \endlink, \link
+ *                SO3_ERROR_INVALID_ARGUMENT \endlink or \link
+ *                SO3_ERROR_OUT_OF_MEMORY \endlink, the same on all
+ *                ranks.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_mpi_inverse_via_ssht(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters, MPI_Comm comm
+) {
+    return so3_mpi_inverse(f, flmn, parameters, comm);
+}
+
+/*!
+ * Compute the forward Wigner transform for a complex signal via SSHT,
+ * distributed over the ranks of a communicator. Collective.
+ *
+ * \param[out] flmn Part of the harmonic coefficients held by the rank,
+ *                  see \link so3_mpi_get_distribution \endlink. If
+ *                  \link so3_parameters_t::n_mode n_mode\endlink is
+ *                  different from \link SO3_N_MODE_ALL \endlink, this
+ *                  array has to be nulled before being passed to the
+ *                  function.
+ * \param[in]  f Part of the function on SO(3) held by the rank.
+ * \param[in]  parameters A fully populated parameters object, the same
+ *                        on all ranks. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored.
+ * \param[in]  comm Communicator of the ranks which perform the
+ *                  transform.
+ * \retval status \link SO3_SUCCESS \endlink, \link
+ *                SO3_ERROR_INVALID_ARGUMENT \endlink or \link
+ *                SO3_ERROR_OUT_OF_MEMORY \endlink, the same on all
+ *                ranks.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_mpi_forward_via_ssht(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters, MPI_Comm comm
+) {
+    return so3_mpi_forward(flmn, f, parameters, comm);
+}
+
+/*!
+ * Compute the inverse Wigner transform for a complex signal directly
+ * (without using SSHT), distributed over the ranks of a communicator.
+ * Collective.
+ *
+ * Each rank accumulates the Fmnm' slabs of its n blocks and performs
+ * their 2D FFTs over (m', m) locally. The remaining FFT over n of the 3D
+ * FFT of \link so3_core_inverse_direct \endlink is performed between
+ * two distributed transposes. For MW sampling this is the computation
+ * of \link so3_mpi_inverse_via_ssht \endlink, which is used.
+ *
+ * \param[out] f Part of the function on SO(3) held by the rank, see
+ *               \link so3_mpi_get_distribution \endlink.
+ * \param[in]  flmn Part of the harmonic coefficients held by the rank.
+ * \param[in]  parameters A fully populated parameters object, the same
+ *                        on all ranks. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored.
+ * \param[in]  comm Communicator of the ranks which perform the
+ *                  transform.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink,
+ *                \link SO3_ERROR_UNSUPPORTED \endlink (unless MW sampling
+ *                without the steerable flag) or
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink, the same on all
+ *                ranks.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_mpi_inverse_direct(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters, MPI_Comm comm
+) {
+    if (parameters && (parameters->sampling_scheme != SO3_SAMPLING_MW || parameters->steerable))
+        return SO3_ERROR_UNSUPPORTED;
+
+    return so3_mpi_inverse(f, flmn, parameters, comm);
+}
+
+/*!
+ * Compute the forward Wigner transform for a complex signal directly
+ * (without using SSHT), distributed over the ranks of a communicator.
+ * Collective.
+ *
+ * The FFT over gamma of \link so3_core_forward_direct \endlink is
+ * performed between two distributed transposes. Each rank then computes
+ * the Gmnm' slabs and the coefficients of its n blocks locally, as in
+ * \link so3_mpi_forward_via_ssht \endlink.
+ *
+ * \param[out] flmn Part of the harmonic coefficients held by the rank,
+ *                  see \link so3_mpi_get_distribution \endlink.
+ * \param[in]  f Part of the function on SO(3) held by the rank.
+ * \param[in]  parameters A fully populated parameters object, the same
+ *                        on all ranks. The \link
+ *                        so3_parameters_t::reality reality\endlink flag
+ *                        is ignored.
+ * \param[in]  comm Communicator of the ranks which perform the
+ *                  transform.
+ * \retval status \link SO3_SUCCESS \endlink,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink,
+ *                \link SO3_ERROR_UNSUPPORTED \endlink (unless MW sampling
+ *                without the steerable flag) or
+ *                \link SO3_ERROR_OUT_OF_MEMORY \endlink, the same on all
+ *                ranks.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_mpi_forward_direct(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters, MPI_Comm comm
+) {
+    if (parameters && (parameters->sampling_scheme != SO3_SAMPLING_MW || parameters->steerable))
+        return SO3_ERROR_UNSUPPORTED;
+
+    return so3_mpi_forward(flmn, f, parameters, comm);
+}
@@ -0,0 +1,49 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_mpi.h
+ *  Wigner transforms via SSHT and direct Wigner transforms, distributed
+ *  over the processes of an MPI communicator. Not part of so3.h, since it requires MPI: build with
+ *  the mpi target of the makefile and link against libso3_mpi.a.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_MPI
+#define SO3_MPI
+
+#include <complex.h>
+#include <mpi.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+
+so3_status_t so3_mpi_get_distribution(
+    int *flmn_offset, int *flmn_size,
+    int *f_offset, int *f_size,
+    const so3_parameters_t *parameters, MPI_Comm comm
+);
+
+so3_status_t so3_mpi_inverse_via_ssht(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters, MPI_Comm comm
+);
+
+so3_status_t so3_mpi_forward_via_ssht(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters, MPI_Comm comm
+);
+
+so3_status_t so3_mpi_inverse_direct(
+    complex double *f, const complex double *flmn,
+    const so3_parameters_t *parameters, MPI_Comm comm
+);
+
+so3_status_t so3_mpi_forward_direct(
+    complex double *flmn, const complex double *f,
+    const so3_parameters_t *parameters, MPI_Comm comm
+);
+
+#endif
@@ -0,0 +1,233 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_mpi_test.c
+ * Checks the distributed transforms against the transforms of a single
+ * process: the transforms via SSHT for all sampling schemes, storage
+ * methods, n-orders and n-modes, with and without steerability, and the
+ * direct transforms for all storage methods, n-orders and n-modes. Every rank computes the
+ * reference transforms of the full signal and compares its part of the
+ * distributed results to them.
+ *
+ * \par Usage
+ *   \code{.sh}
+ *   mpirun -np 4 so3_mpi_test [L [N [L0 [seed]]]]
+ *   \endcode
+ *   e.g.
+ *   \code{.sh}
+ *   mpirun -np 4 so3_mpi_test 32 8 0 314
+ *   \endcode
+ *   Defaults: L = 8, N = 4, L0 = 0, seed = 1. Exits with a non-zero
+ *   status if any error exceeds the tolerance.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#include <mpi.h>
+
+#include <so3.h>
+#include "so3_mpi.h"
+
+#define TOLERANCE 1e-10
+#define MAX(a,b) ((a > b) ? (a) : (b))
+
+static double so3_mpi_test_error(const complex double *expected, const complex double *actual, int n)
+{
+    double error = 0.0;
+    int i;
+
+    for (i = 0; i < n; ++i)
+        error = MAX(error, cabs(expected[i] - actual[i]));
+
+    return error;
+}
+
+// Random coefficients of the n, el and m present for the parameters.
+// All ranks generate the same coefficients.
+static void so3_mpi_test_gen_flmn(complex double *flmn, const so3_parameters_t *parameters, int seed)
+{
+    int L0 = parameters->L0, L = parameters->L, N = parameters->N;
+    int el, m, n, ind;
+
+    srand(seed);
+    memset(flmn, 0, so3_sampling_flmn_size(parameters) * sizeof *flmn);
+    for (n = -N+1; n <= N-1; ++n)
+    {
+        if ((parameters->n_mode == SO3_N_MODE_EVEN && n % 2)
+            || (parameters->n_mode == SO3_N_MODE_ODD && !(n % 2))
+            || (parameters->n_mode == SO3_N_MODE_MAXIMUM && abs(n) < N-1)
+            || (parameters->steerable && (n + N-1) % 2))
+            continue;
+
+        for (el = MAX(L0, abs(n)); el < L; ++el)
+        {
+            if (parameters->n_mode == SO3_N_MODE_L && el != abs(n))
+                continue;
+
+            for (m = -el; m <= el; ++m)
+            {
+                so3_sampling_elmn2ind(&ind, el, m, n, parameters);
+                flmn[ind] = (2.0*rand()/RAND_MAX - 1.0) + I * (2.0*rand()/RAND_MAX - 1.0);
+            }
+        }
+    }
+}
+
+typedef void (*so3_mpi_test_core_t)(complex double *, const complex double *, const so3_parameters_t *);
+typedef so3_status_t (*so3_mpi_test_inverse_t)(complex double *, const complex double *, const so3_parameters_t *, MPI_Comm);
+typedef so3_status_t (*so3_mpi_test_forward_t)(complex double *, const complex double *, const so3_parameters_t *, MPI_Comm);
+
+// Compare a pair of distributed transforms to the transforms of a single
+// process, and the round trip to the original coefficients. Returns 1
+// (on all ranks) if any error exceeds the tolerance.
+static int so3_mpi_test_check(
+    const char *name,
+    so3_mpi_test_inverse_t inverse, so3_mpi_test_forward_t forward,
+    so3_mpi_test_core_t core_inverse, so3_mpi_test_core_t core_forward,
+    const so3_parameters_t *parameters, int seed,
+    complex double *flmn, complex double *flmn_ref, complex double *flmn_local,
+    complex double *f, complex double *f_local
+) {
+    int rank, flmn_offset, flmn_size, f_offset, f_size;
+    double errors[3];
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    so3_mpi_test_gen_flmn(flmn, parameters, seed);
+
+    if (so3_mpi_get_distribution(&flmn_offset, &flmn_size, &f_offset, &f_size,
+                                 parameters, MPI_COMM_WORLD) != SO3_SUCCESS)
+        SO3_ERROR_GENERIC("Invalid distribution.");
+
+    // Inverse transform.
+    core_inverse(f, flmn, parameters);
+    if (inverse(f_local, flmn + flmn_offset, parameters, MPI_COMM_WORLD) != SO3_SUCCESS)
+        SO3_ERROR_GENERIC("Distributed inverse transform failed.");
+    errors[0] = so3_mpi_test_error(f + f_offset, f_local, f_size);
+
+    // Forward transform of the same samples.
+    memset(flmn_ref, 0, so3_sampling_flmn_size(parameters) * sizeof *flmn_ref);
+    memset(flmn_local, 0, flmn_size * sizeof *flmn_local);
+    core_forward(flmn_ref, f, parameters);
+    if (forward(flmn_local, f + f_offset, parameters, MPI_COMM_WORLD) != SO3_SUCCESS)
+        SO3_ERROR_GENERIC("Distributed forward transform failed.");
+    errors[1] = so3_mpi_test_error(flmn_ref + flmn_offset, flmn_local, flmn_size);
+    errors[2] = so3_mpi_test_error(flmn + flmn_offset, flmn_local, flmn_size);
+
+    MPI_Allreduce(MPI_IN_PLACE, errors, 3, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    if (errors[0] > TOLERANCE || errors[1] > TOLERANCE || errors[2] > TOLERANCE)
+    {
+        if (rank == 0)
+            printf("FAILED: %s, sampling %d, storage %d, n-order %d, n-mode %d, steerable %d: "
+                   "inverse %e, forward %e, round-trip %e\n",
+                   name, parameters->sampling_scheme, parameters->storage,
+                   parameters->n_order, parameters->n_mode, parameters->steerable,
+                   errors[0], errors[1], errors[2]);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_ref, *flmn_local, *f, *f_local;
+    int L, N, L0, seed, rank, failures, total;
+    int sampling_scheme, storage, n_order, n_mode, steerable;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    L = 8;
+    N = 4;
+    L0 = 0;
+    seed = 1;
+    if (argc > 1)
+        L = atoi(argv[1]);
+    if (argc > 2)
+        N = atoi(argv[2]);
+    if (argc > 3)
+        L0 = atoi(argv[3]);
+    if (argc > 4)
+        seed = atoi(argv[4]);
+
+    parameters.L0 = L0;
+    parameters.L = L;
+    parameters.N = N;
+    parameters.dl_method = SSHT_DL_RISBO;
+
+    // Room for the largest configuration (padded storage, MW_SS).
+    flmn = malloc((2*N-1)*L*L * sizeof *flmn);
+    flmn_ref = malloc((2*N-1)*L*L * sizeof *flmn_ref);
+    flmn_local = malloc((2*N-1)*L*L * sizeof *flmn_local);
+    f = malloc((2*N-1)*(L+1)*2*L * sizeof *f);
+    f_local = malloc((2*N-1)*(L+1)*2*L * sizeof *f_local);
+    SO3_ERROR_MEM_ALLOC_CHECK(flmn);
+    SO3_ERROR_MEM_ALLOC_CHECK(flmn_ref);
+    SO3_ERROR_MEM_ALLOC_CHECK(flmn_local);
+    SO3_ERROR_MEM_ALLOC_CHECK(f);
+    SO3_ERROR_MEM_ALLOC_CHECK(f_local);
+
+    if (rank == 0)
+    {
+        int nranks;
+        MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+        printf("SO3 distributed transforms test with %d ranks, L = %d, N = %d, L0 = %d\n",
+               nranks, L, N, L0);
+    }
+
+    failures = total = 0;
+    for (sampling_scheme = 0; sampling_scheme < SO3_SAMPLING_SIZE; ++sampling_scheme)
+    for (storage = 0; storage < SO3_STORAGE_SIZE; ++storage)
+    for (n_order = 0; n_order < SO3_N_ORDER_SIZE; ++n_order)
+    for (n_mode = 0; n_mode < SO3_N_MODE_SIZE; ++n_mode)
+    for (steerable = 0; steerable < 2; ++steerable)
+    {
+        parameters.sampling_scheme = sampling_scheme;
+        parameters.storage = storage;
+        parameters.n_order = n_order;
+        parameters.n_mode = n_mode;
+        parameters.steerable = steerable;
+
+        ++total;
+        failures += so3_mpi_test_check("via SSHT",
+                                       so3_mpi_inverse_via_ssht, so3_mpi_forward_via_ssht,
+                                       so3_core_inverse_via_ssht, so3_core_forward_via_ssht,
+                                       &parameters, seed,
+                                       flmn, flmn_ref, flmn_local, f, f_local);
+
+        // The direct transforms only support MW sampling without the
+        // steerable flag.
+        if (sampling_scheme == SO3_SAMPLING_MW && !steerable)
+        {
+            ++total;
+            failures += so3_mpi_test_check("direct",
+                                           so3_mpi_inverse_direct, so3_mpi_forward_direct,
+                                           so3_core_inverse_direct, so3_core_forward_direct,
+                                           &parameters, seed,
+                                           flmn, flmn_ref, flmn_local, f, f_local);
+        }
+    }
+
+    if (rank == 0)
+        printf("%d configurations, %d failures.\n", total, failures);
+
+    free(flmn);
+    free(flmn_ref);
+    free(flmn_local);
+    free(f);
+    free(f_local);
+
+    MPI_Finalize();
+
+    return failures ? 1 : 0;
+}
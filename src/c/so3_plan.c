@@ -0,0 +1,4729 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_plan.c
+ * Reusable transform plans. A plan performs all setup that depends only
+ * on the parameters (precomputed tables, scratch buffers, quadrature
+ * weights and FFTW plans) once, so that repeated execution for the same
+ * configuration neither allocates memory nor plans FFTs.
+ *
+ * Setup of the buffers required by a particular transform is deferred
+ * until that transform is executed for the first time, so that a plan
+ * which is only ever used for, say, the direct inverse transform does
+ * not hold memory for any of the other algorithms.
+ *
+ * \note
+ *   A plan holds scratch memory and must therefore not be executed by
+ *   several threads at the same time. Create one plan per thread instead.
+ *   Parts of the transforms are parallelised internally with OpenMP,
+ *   using as many threads as are available when the plan is created.
+ *   Plans of different threads are independent: the calls into the FFTW
+ *   planner, which is not thread-safe, are serialised by the named
+ *   critical section so3_fftw_planner.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE  // For the CPU affinity interface of sched.h
+#include <sched.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>  // Must be before fftw3.h
+#include <fftw3.h>
+#include <omp.h>
+
+#include "ssht.h"
+
+#include "so3_types.h"
+#include "so3_error.h"
+#include "so3_sampling.h"
+#include "so3_dl_cache.h"
+#include "so3_schedule.h"
+#include "so3_simd.h"
+#include "so3_plan.h"
+#include "so3_plan_internal.h"
+
+// Memory for the intermediate Fmnm' of the signals of a batch which
+// are transformed together by the transforms via SSHT. Larger batches
+// are split into groups, whose stages are pipelined.
+#ifndef SO3_PLAN_BATCH_BYTES
+#define SO3_PLAN_BATCH_BYTES (64 << 20)
+#endif
+
+// Record a failed allocation in the status of the plan and abandon the
+// (void) setup routine. The caller has to check plan->status.
+#define SO3_PLAN_ALLOC_CHECK(plan, pointer)                            \
+  if ((pointer) == NULL) {                                              \
+    (plan)->status = SO3_ERROR_OUT_OF_MEMORY;                           \
+    return;                                                             \
+  }
+
+// Record a failure of the FFTW planner in the status of the plan.
+#define SO3_PLAN_FFTW_CHECK(plan, fplan)                               \
+  if ((fplan) == NULL) {                                            \
+    (plan)->status = SO3_ERROR_FFTW;                                    \
+  }
+
+//============================================================================
+// Plan creation and destruction
+//============================================================================
+
+// Initialise the threaded FFTW library, once per process. The flag
+// below is the only process-wide state of the library. Without
+// SO3_FFTW_THREADS, FFTW is single-threaded and this does nothing.
+// Returns 0 if threaded FFTW could not be initialised.
+static int so3_plan_init_fftw_threads()
+{
+#ifdef SO3_FFTW_THREADS
+    static int initialised = 0;
+    int success;
+
+    #pragma omp critical (so3_fftw_init)
+    {
+        if (!initialised)
+            initialised = fftw_init_threads();
+        success = initialised;
+    }
+
+    return success;
+#else
+    return 1;
+#endif
+}
+
+// Set the number of threads for the FFTW plans created next. Plans which
+// are executed from within the parallel loops of the transforms must be
+// planned with a single thread.
+static void so3_plan_fftw_threads(int nthreads)
+{
+#ifdef SO3_FFTW_THREADS
+    fftw_plan_with_nthreads(nthreads);
+#endif
+}
+
+#ifdef __linux__
+// Affinity mask of the process and the list of its CPUs, recorded once
+// by the first plan with the numa flag (see so3_plan_init_numa) before
+// any thread is pinned.
+static cpu_set_t so3_plan_numa_mask;
+static int so3_plan_numa_cpus[CPU_SETSIZE];
+static int so3_plan_numa_ncpus = -1;
+#endif
+
+// Record the affinity mask of the process, once per process. Without
+// the CPU affinity interface (i.e. other than on Linux) this does
+// nothing and no threads are pinned.
+static void so3_plan_init_numa()
+{
+#ifdef __linux__
+    int cpu;
+
+    #pragma omp critical (so3_numa_init)
+    {
+        if (so3_plan_numa_ncpus < 0)
+        {
+            so3_plan_numa_ncpus = 0;
+            if (sched_getaffinity(0, sizeof so3_plan_numa_mask, &so3_plan_numa_mask) == 0)
+                for (cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                    if (CPU_ISSET(cpu, &so3_plan_numa_mask))
+                        so3_plan_numa_cpus[so3_plan_numa_ncpus++] = cpu;
+        }
+    }
+#endif
+}
+
+#ifdef __linux__
+// Temporarily pin the calling thread of an OpenMP team to one CPU of the
+// recorded process mask, spreading the team evenly over the mask (and
+// so over the NUMA nodes, whose CPUs are numbered consecutively on
+// common systems). The original mask of the thread is stored in saved;
+// restore it with sched_setaffinity once done. Threads which are already
+// bound to a subset of the process, e.g. by the OpenMP runtime under
+// OMP_PROC_BIND, are left alone. Returns 1 if the thread was pinned.
+static int so3_plan_pin_thread(cpu_set_t *saved)
+{
+    cpu_set_t own;
+    long thread;
+
+    if (so3_plan_numa_ncpus <= 0
+        || sched_getaffinity(0, sizeof *saved, saved) != 0
+        || !CPU_EQUAL(saved, &so3_plan_numa_mask))
+        return 0;
+
+    thread = omp_get_thread_num();
+    CPU_ZERO(&own);
+    CPU_SET(so3_plan_numa_cpus[thread*so3_plan_numa_ncpus/omp_get_num_threads()], &own);
+
+    return sched_setaffinity(0, sizeof own, &own) == 0;
+}
+#endif
+
+/*!
+ * Create a plan for the given parameters. Reentrant variant of \link
+ * so3_plan_create \endlink, which validates the parameters and reports
+ * errors instead of terminating the program.
+ *
+ * \param[out] plan Newly created plan, or NULL on failure. Release with
+ *                  \link so3_plan_destroy \endlink.
+ * \param[in]  parameters A fully populated parameters object. A copy is
+ *                        stored in the plan, so the object may be
+ *                        modified or released afterwards.
+ * \param[in]  flags FFTW planner flags (e.g. FFTW_ESTIMATE or
+ *                   FFTW_MEASURE) used for all FFTs of the plan. The
+ *                   FFTs of the convolution with the quadrature weights
+ *                   in the direct forward transforms are planned with
+ *                   at least FFTW_MEASURE, even for FFTW_ESTIMATE.
+ * \retval status \link SO3_SUCCESS \endlink, \link
+ *                SO3_ERROR_INVALID_ARGUMENT \endlink, \link
+ *                SO3_ERROR_OUT_OF_MEMORY \endlink or \link
+ *                SO3_ERROR_FFTW \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_create_r(
+    so3_plan_t **plan, const so3_parameters_t *parameters, unsigned flags
+) {
+    so3_plan_t *p;
+    so3_status_t status;
+    int L, N, el, m, i;
+
+    if (!plan)
+        return SO3_ERROR_INVALID_ARGUMENT;
+    *plan = NULL;
+
+    status = so3_sampling_check_parameters(parameters);
+    if (status != SO3_SUCCESS)
+        return status;
+
+    if (!so3_plan_init_fftw_threads())
+        return SO3_ERROR_FFTW;
+
+    p = calloc(1, sizeof *p);
+    if (!p)
+        return SO3_ERROR_OUT_OF_MEMORY;
+
+    p->parameters = *parameters;
+    p->flags = flags;
+    p->nthreads = parameters->num_threads > 0
+                  ? parameters->num_threads
+                  : omp_get_max_threads();
+    p->status = SO3_SUCCESS;
+
+    if (parameters->numa)
+        so3_plan_init_numa();
+
+    L = parameters->L;
+    N = parameters->N;
+
+    // Reserve the costs of the longest scheduled loop (over el or n), so
+    // that the transforms do not allocate within parallel regions.
+    p->schedule = so3_schedule_create(p->nthreads);
+    if (!p->schedule || !so3_schedule_reserve(p->schedule, MAX(L, 2*N-1)))
+    {
+        so3_plan_destroy(p);
+        return SO3_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Perform precomputations.
+    p->sqrt_tbl = calloc(2*(L-1)+2, sizeof *p->sqrt_tbl);
+    p->signs = calloc(L+1, sizeof *p->signs);
+    p->exps = calloc(4, sizeof *p->exps);
+    if (!p->sqrt_tbl || !p->signs || !p->exps)
+    {
+        so3_plan_destroy(p);
+        return SO3_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (el = 0; el <= 2*L-1; ++el)
+        p->sqrt_tbl[el] = sqrt((double)el);
+    for (m = 0; m <= L-1; m += 2)
+    {
+        p->signs[m]   =  1.0;
+        p->signs[m+1] = -1.0;
+    }
+    for (i = 0; i < 4; ++i)
+        p->exps[i] = cexp(I*SO3_PION2*i);
+
+    *plan = p;
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Create a plan for the given parameters.
+ *
+ * \param[in]  parameters A fully populated parameters object. A copy is
+ *                        stored in the plan, so the object may be
+ *                        modified or released afterwards.
+ * \param[in]  flags FFTW planner flags (e.g. FFTW_ESTIMATE or
+ *                   FFTW_MEASURE), see \link so3_plan_create_r \endlink.
+ * \retval plan Newly created plan. Release with \link so3_plan_destroy
+ *              \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_plan_t *so3_plan_create(const so3_parameters_t *parameters, unsigned flags)
+{
+    so3_plan_t *plan;
+
+    switch (so3_plan_create_r(&plan, parameters, flags))
+    {
+    case SO3_SUCCESS:
+        break;
+    case SO3_ERROR_INVALID_ARGUMENT:
+        SO3_ERROR_GENERIC("Invalid parameters.");
+    case SO3_ERROR_FFTW:
+        SO3_ERROR_GENERIC("Could not initialise threaded FFTW.");
+    default:
+        SO3_ERROR_GENERIC("Memory allocation failed");
+    }
+
+    return plan;
+}
+
+// Destroy an FFTW plan which may not have been created.
+static void so3_plan_destroy_fftw_plan(fftw_plan fplan)
+{
+    if (fplan)
+        fftw_destroy_plan(fplan);
+}
+
+/*!
+ * Release a plan and all memory and FFTW plans it holds.
+ *
+ * \param[in]  plan Plan to release. May be NULL.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_plan_destroy(so3_plan_t *plan)
+{
+    if (!plan)
+        return;
+
+    // Like the planner, destroying FFTW plans is not thread-safe.
+    #pragma omp critical (so3_fftw_planner)
+    {
+        so3_plan_destroy_fftw_plan(plan->weights.plan_bwd);
+        so3_plan_destroy_fftw_plan(plan->weights.plan_fwd);
+        so3_plan_destroy_fftw_plan(plan->sov.plan_inverse);
+        so3_plan_destroy_fftw_plan(plan->sov.plan_phi);
+        so3_plan_destroy_fftw_plan(plan->sov.plan_theta);
+        so3_plan_destroy_fftw_plan(plan->inverse_via_ssht.plan);
+        so3_plan_destroy_fftw_plan(plan->inverse_via_ssht.plan_last);
+        so3_plan_destroy_fftw_plan(plan->forward_via_ssht.plan);
+        so3_plan_destroy_fftw_plan(plan->forward_via_ssht.plan_last);
+        so3_plan_destroy_fftw_plan(plan->inverse_via_ssht_real.plan);
+        so3_plan_destroy_fftw_plan(plan->inverse_via_ssht_real.plan_last);
+        so3_plan_destroy_fftw_plan(plan->forward_via_ssht_real.plan);
+        so3_plan_destroy_fftw_plan(plan->forward_via_ssht_real.plan_last);
+        so3_plan_destroy_fftw_plan(plan->inverse_direct.plan);
+        so3_plan_destroy_fftw_plan(plan->inverse_direct_real.plan);
+        so3_plan_destroy_fftw_plan(plan->forward_direct.plan_alpha_gamma);
+        so3_plan_destroy_fftw_plan(plan->forward_direct.plan_beta);
+        so3_plan_destroy_fftw_plan(plan->forward_direct_real.plan_alpha_gamma);
+        so3_plan_destroy_fftw_plan(plan->forward_direct_real.plan_beta);
+    }
+
+    free(plan->weights.kernel);
+    free(plan->weights.inout);
+
+    free(plan->sov.Fmnm);
+    free(plan->sov.mn_factors);
+    free(plan->sov.ext);
+    free(plan->sov.Fmm);
+    free(plan->sov.expsmm);
+
+    free(plan->inverse_via_ssht.fn);
+    free(plan->inverse_via_ssht.ftemp);
+
+    free(plan->forward_via_ssht.fn);
+
+    free(plan->inverse_via_ssht_real.fn);
+    free(plan->inverse_via_ssht_real.ftemp);
+
+    free(plan->forward_via_ssht_real.fn);
+
+    free(plan->inverse_direct.Fmnm);
+    free(plan->inverse_direct.mn_factors);
+    free(plan->inverse_direct.fext);
+    free(plan->inverse_direct.expsmm);
+    free(plan->inverse_direct.mm_phases);
+
+    free(plan->inverse_direct_real.Fmnm);
+    free(plan->inverse_direct_real.mn_factors);
+    free(plan->inverse_direct_real.Fmnm_shift);
+    free(plan->inverse_direct_real.fext);
+
+    free(plan->forward_direct.expsmm);
+    free(plan->forward_direct.Fmnb);
+    free(plan->forward_direct.inout);
+    free(plan->forward_direct.Fmnm);
+    free(plan->forward_direct.Gmnm);
+    free(plan->forward_direct.phases);
+
+    free(plan->forward_direct_real.expsmm);
+    free(plan->forward_direct_real.Fmnb);
+    free(plan->forward_direct_real.fft_out);
+    free(plan->forward_direct_real.inout);
+    free(plan->forward_direct_real.Fmnm);
+    free(plan->forward_direct_real.Gmnm);
+    free(plan->forward_direct_real.phases);
+    free(plan->forward_direct_real.fft_in);
+
+    free(plan->dl);
+    free(plan->dl8);
+    free(plan->dl_block.buffer);
+    free(plan->dl_block.planes);
+    free(plan->dl_block.offsets);
+    free(plan->dl_block.strides);
+    so3_schedule_destroy(plan->schedule);
+
+    free(plan->sqrt_tbl);
+    free(plan->signs);
+    free(plan->exps);
+
+    free(plan);
+}
+
+/*!
+ * Get the parameters a plan was created for.
+ *
+ * \param[in]  plan Plan.
+ * \retval parameters The plan's copy of the parameters object.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+const so3_parameters_t *so3_plan_get_parameters(const so3_plan_t *plan)
+{
+    return &plan->parameters;
+}
+
+/*!
+ * Let the direct transforms of a plan read the Wigner planes at
+ * beta = pi/2 from a cache instead of computing them by recursion.
+ * The cache is not copied and must remain open while the plan is used.
+ *
+ * \param[in]  plan Plan.
+ * \param[in]  cache Cache opened with \link so3_dl_cache_open \endlink,
+ *                   or NULL to return to the recursion.
+ * \retval success 1 if the cache is used, 0 if it does not cover the
+ *                 plan's band-limit or was computed with a different
+ *                 recursion method (in which case the recursion is used).
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_plan_set_dl_cache(so3_plan_t *plan, const so3_dl_cache_t *cache)
+{
+    if (cache
+        && (so3_dl_cache_get_L(cache) < plan->parameters.L
+            || so3_dl_cache_get_dl_method(cache) != plan->parameters.dl_method))
+    {
+        plan->dl_cache = NULL;
+        return 0;
+    }
+
+    plan->dl_cache = cache;
+
+    return 1;
+}
+
+/*!
+ * Get the utilisation statistics of the plan's threads in the loops
+ * which are balanced by the work-stealing scheduler, accumulated since
+ * the plan was created or the statistics were last reset.
+ *
+ * \param[in]  plan Plan.
+ * \param[out] stats Statistics, one entry per thread. Provide an array
+ *                   of at least as many entries as the plan has
+ *                   threads, or NULL to query their number.
+ * \retval nthreads Number of threads of the plan.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_plan_get_thread_stats(const so3_plan_t *plan, so3_schedule_stats_t *stats)
+{
+    return so3_schedule_get_stats(plan->schedule, stats);
+}
+
+/*!
+ * Reset the utilisation statistics of the plan's threads.
+ *
+ * \param[in]  plan Plan.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_plan_reset_thread_stats(so3_plan_t *plan)
+{
+    so3_schedule_reset_stats(plan->schedule);
+}
+
+//============================================================================
+// Internal setup routines
+//============================================================================
+
+static int so3_plan_fn_n_stride(const so3_parameters_t *parameters)
+{
+    int L = parameters->L;
+
+    switch (parameters->sampling_scheme)
+    {
+    case SO3_SAMPLING_MW:
+        return L * (2*L-1);
+    case SO3_SAMPLING_MW_SS:
+        return (L+1) * 2*L;
+    default:
+        SO3_ERROR_GENERIC("Invalid sampling scheme.");
+    }
+}
+
+// Allocate nslabs zeroed slabs of slab_size bytes each, or return NULL.
+// The slabs are zeroed by the threads of the plan in a static schedule,
+// so that under the first-touch policy of the operating system the pages
+// of slab i are placed on the NUMA node of the thread which processes
+// slab i in the loops with the same static schedule over the slab index
+// (an outermost array index, or the thread number for per-thread
+// scratch), rather than all on the node of the planning thread. With
+// the numa flag, the threads are pinned to their node for the first
+// touch (see so3_plan_pin_thread) and released again afterwards.
+static void *so3_plan_alloc_slabs(const so3_plan_t *plan, int nslabs, size_t slab_size)
+{
+    char *buffer;
+    int i;
+
+    buffer = malloc(MAX(nslabs*slab_size, 1));
+    if (!buffer)
+        return NULL;
+
+    #pragma omp parallel num_threads(plan->nthreads)
+    {
+#ifdef __linux__
+        cpu_set_t saved;
+        int pinned = plan->parameters.numa && so3_plan_pin_thread(&saved);
+#endif
+
+        #pragma omp for schedule(static)
+        for (i = 0; i < nslabs; ++i)
+            memset(buffer + i*slab_size, 0, slab_size);
+
+#ifdef __linux__
+        if (pinned)
+            sched_setaffinity(0, sizeof saved, &saved);
+#endif
+    }
+
+    return buffer;
+}
+
+// Allocate the buffers for the Wigner recursion at beta = pi/2.
+static void so3_plan_setup_wigner(so3_plan_t *plan)
+{
+    int L = plan->parameters.L;
+
+    if (plan->dl || plan->status != SO3_SUCCESS)
+        return;
+
+    plan->dl = ssht_dl_calloc(L, SSHT_DL_QUARTER);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->dl);
+    if (plan->parameters.dl_method == SSHT_DL_RISBO)
+    {
+        plan->dl8 = ssht_dl_calloc(L, SSHT_DL_QUARTER_EXTENDED);
+        SO3_PLAN_ALLOC_CHECK(plan, plan->dl8);
+    }
+    plan->dl_offset = ssht_dl_get_offset(L, SSHT_DL_QUARTER);
+    plan->dl_stride = ssht_dl_get_stride(L, SSHT_DL_QUARTER);
+}
+
+// Get the Wigner plane for el, such that dl_{m m'}(pi/2) is found at
+// index m + dl_offset + m'*dl_stride of the returned array for
+// 0 <= m, m' <= el. Without a cache, this advances the Wigner recursion,
+// so planes have to be requested in order of increasing el, starting
+// at L0. For el = L0 > 0, the recursion is run from 0 up to L0.
+static const double *so3_plan_get_wigner_plane(
+    so3_plan_t *plan, int el,
+    int *dl_offset, int *dl_stride
+) {
+    int L0 = plan->parameters.L0;
+    int L = plan->parameters.L;
+    double *dl = plan->dl, *dl8 = plan->dl8;
+    double *sqrt_tbl = plan->sqrt_tbl, *signs = plan->signs;
+    int eltmp;
+
+    if (plan->dl_cache)
+    {
+        *dl_offset = 0;
+        *dl_stride = el+1;
+        return so3_dl_cache_get_plane(plan->dl_cache, el);
+    }
+
+    *dl_offset = plan->dl_offset;
+    *dl_stride = plan->dl_stride;
+
+    switch (plan->parameters.dl_method)
+    {
+    case SSHT_DL_RISBO:
+        if (el != 0 && el == L0)
+        {
+            for(eltmp = 0; eltmp <= L0; ++eltmp)
+                ssht_dl_beta_risbo_eighth_table(
+                        dl8,
+                        SO3_PION2,
+                        L,
+                        SSHT_DL_QUARTER_EXTENDED,
+                        eltmp,
+                        sqrt_tbl,
+                        signs);
+        }
+        else
+        {
+            ssht_dl_beta_risbo_eighth_table(
+                    dl8,
+                    SO3_PION2,
+                    L,
+                    SSHT_DL_QUARTER_EXTENDED,
+                    el,
+                    sqrt_tbl,
+                    signs);
+        }
+        ssht_dl_beta_risbo_fill_eighth2quarter_table(
+                dl,
+                dl8, L,
+                SSHT_DL_QUARTER,
+                SSHT_DL_QUARTER_EXTENDED,
+                el,
+                signs);
+        break;
+
+    case SSHT_DL_TRAPANI:
+        if (el != 0 && el == L0)
+        {
+            for(eltmp = 0; eltmp <= L0; ++eltmp)
+                ssht_dl_halfpi_trapani_eighth_table(
+                        dl,
+                        L,
+                        SSHT_DL_QUARTER,
+                        eltmp,
+                        sqrt_tbl);
+        }
+        else
+        {
+            ssht_dl_halfpi_trapani_eighth_table(
+                    dl,
+                    L,
+                    SSHT_DL_QUARTER,
+                    el,
+                    sqrt_tbl);
+        }
+        ssht_dl_halfpi_trapani_fill_eighth2quarter_table(
+                dl,
+                L,
+                SSHT_DL_QUARTER,
+                el,
+                signs);
+        break;
+
+    default:
+        SO3_ERROR_GENERIC("Invalid dl method");
+    }
+
+    return dl;
+}
+
+// Allocate the bookkeeping for blocks of Wigner planes, with room for
+// all planes of a cache and a buffer of as many values as there are in
+// one full plane per thread.
+static void so3_plan_setup_wigner_block(so3_plan_t *plan)
+{
+    int L = plan->parameters.L;
+
+    if (plan->dl_block.planes || plan->status != SO3_SUCCESS)
+        return;
+
+    plan->dl_block.buffer = calloc(plan->nthreads*L*L, sizeof *plan->dl_block.buffer);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->dl_block.buffer);
+    plan->dl_block.planes = calloc(L, sizeof *plan->dl_block.planes);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->dl_block.planes);
+    plan->dl_block.offsets = calloc(L, sizeof *plan->dl_block.offsets);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->dl_block.offsets);
+    plan->dl_block.strides = calloc(L, sizeof *plan->dl_block.strides);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->dl_block.strides);
+}
+
+// Get the Wigner planes for a block of el = el_first, el_first+1, ...
+// up to at most el_stop-1, such that dl_{m m'}(pi/2) of the i-th of them
+// is found at index m + dl_block.offsets[i] + m'*dl_block.strides[i] of
+// dl_block.planes[i]. Returns the number of planes in the block, which
+// is at least one. Planes of a cache are referenced directly, so the
+// block extends to el_stop. Otherwise the recursion is advanced and the
+// planes are packed into dl_block.buffer for as long as they fit, so
+// blocks have to be requested in order of increasing el. With a single
+// thread, blocks consist of one plane, which is not copied.
+static int so3_plan_get_wigner_planes(so3_plan_t *plan, int el_first, int el_stop)
+{
+    int L = plan->parameters.L;
+    int buffer_size = plan->nthreads*L*L;
+    int used = 0;
+    int i, el, m, mm;
+
+    for (el = el_first; el < el_stop; ++el)
+    {
+        int dl_offset, dl_stride;
+        const double *dl;
+
+        i = el - el_first;
+        if (!plan->dl_cache
+            && i > 0
+            && (plan->nthreads == 1 || used + (el+1)*(el+1) > buffer_size))
+            break;
+
+        dl = so3_plan_get_wigner_plane(plan, el, &dl_offset, &dl_stride);
+
+        if (plan->dl_cache || plan->nthreads == 1)
+        {
+            plan->dl_block.planes[i] = dl;
+            plan->dl_block.offsets[i] = dl_offset;
+            plan->dl_block.strides[i] = dl_stride;
+            continue;
+        }
+
+        double *plane = plan->dl_block.buffer + used;
+        for (mm = 0; mm <= el; ++mm)
+            for (m = 0; m <= el; ++m)
+                plane[m + (el+1)*mm] = dl[m + dl_offset + mm*dl_stride];
+        used += (el+1)*(el+1);
+
+        plan->dl_block.planes[i] = plane;
+        plan->dl_block.offsets[i] = 0;
+        plan->dl_block.strides[i] = el+1;
+    }
+
+    return el - el_first;
+}
+
+// Estimated cost of accumulating the flmn for el in the direct forward
+// transforms: (2el+1)^2 operations for each contributing n.
+static double so3_plan_direct_el_cost(const so3_parameters_t *parameters, int el, int real)
+{
+    int N = parameters->N;
+    int n_max = MIN(N-1, el);
+    double n_count = real ? n_max+1 : 2*n_max+1;
+
+    switch (parameters->n_mode)
+    {
+    case SO3_N_MODE_EVEN:
+    case SO3_N_MODE_ODD:
+        n_count /= 2.0;
+        break;
+    case SO3_N_MODE_MAXIMUM:
+        n_count = el < N-1 ? 0.0 : (real ? 1.0 : 2.0);
+        break;
+    case SO3_N_MODE_L:
+        n_count = el >= N ? 0.0 : (real ? 1.0 : 2.0);
+        break;
+    default:
+        break;
+    }
+
+    return (2.0*el+1.0)*(2.0*el+1.0)*n_count;
+}
+
+// Compute the quadrature weights in real space and plan the FFTs
+// of length 4*L-3 for the convolution in the direct forward transforms.
+// The weights only depend on L and the sampling scheme, so they are
+// computed once per plan. The kernel is stored in FFTW order (mm >= 0
+// first, followed by mm < 0) and includes the normalisation of the
+// convolution, such that no spatial shifts are needed when applying it.
+void so3_plan_setup_weights(so3_plan_t *plan)
+{
+    int L = plan->parameters.L;
+    int mm;
+    int w_n = 4*L-3;
+    complex double *kernel;
+    fftw_plan plan_kernel;
+
+    if (plan->weights.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    plan->weights.kernel = calloc(w_n, sizeof *plan->weights.kernel);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->weights.kernel);
+    // One convolution buffer per thread.
+    plan->weights.inout = so3_plan_alloc_slabs(plan, plan->nthreads, (2*L-1)*w_n * sizeof *plan->weights.inout);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->weights.inout);
+
+    // The convolutions of all m for a given n are computed as a single
+    // batch of 2*L-1 transforms, on the buffer of the calling thread.
+    // These FFTs are executed (2*N-1)*(2*L-1) times per transform, so
+    // they are always planned with at least FFTW_MEASURE, as before
+    // plans existed.
+    so3_plan_fftw_threads(1);
+    plan->weights.plan_bwd = fftw_plan_many_dft(
+            1, &w_n, 2*L-1,
+            plan->weights.inout, NULL, 1, w_n,
+            plan->weights.inout, NULL, 1, w_n,
+            FFTW_BACKWARD, plan->flags & ~FFTW_ESTIMATE
+    );
+    SO3_PLAN_FFTW_CHECK(plan, plan->weights.plan_bwd);
+    plan->weights.plan_fwd = fftw_plan_many_dft(
+            1, &w_n, 2*L-1,
+            plan->weights.inout, NULL, 1, w_n,
+            plan->weights.inout, NULL, 1, w_n,
+            FFTW_FORWARD, plan->flags & ~FFTW_ESTIMATE
+    );
+    SO3_PLAN_FFTW_CHECK(plan, plan->weights.plan_fwd);
+
+    // Compute weights.
+    kernel = plan->weights.kernel;
+    for (mm = -2*(L-1); mm <= 2*(L-1); ++mm)
+        kernel[mm < 0 ? mm + w_n : mm] = so3_sampling_weight(&plan->parameters, mm);
+
+    // Compute IFFT of w to give wr. This is only done once, so there is
+    // no point in measuring the plan.
+    plan_kernel = fftw_plan_dft_1d(w_n, kernel, kernel, FFTW_BACKWARD, FFTW_ESTIMATE);
+    SO3_PLAN_FFTW_CHECK(plan, plan_kernel);
+    if (!plan_kernel)
+        return;
+    fftw_execute(plan_kernel);
+    fftw_destroy_plan(plan_kernel);
+
+    for (mm = 0; mm < w_n; ++mm)
+        kernel[mm] *= 4.0 * SSHT_PI * SSHT_PI / (4.0*L-3.0);
+
+    plan->weights.ready = 1;
+}
+
+// Convolve the Fmnm' of all m for a single n with the quadrature weights
+// and store the section of interest of the result (scaled to give Gmnm').
+// Element (m, m') of Fmnm and Gmnm is found at
+// (m+L-1)*m_stride + (m'+L-1)*mm_stride with the respective strides.
+// inout is the convolution buffer of the calling thread.
+static void so3_plan_weight_convolution(
+    so3_plan_t *plan, complex double *inout,
+    complex double *Gmnm, int Gmnm_m_stride, int Gmnm_mm_stride,
+    const complex double *Fmnm, int Fmnm_m_stride, int Fmnm_mm_stride
+) {
+    int L = plan->parameters.L;
+    int m, mm, r;
+    int w_n = 4*L-3;
+    const complex double *kernel = plan->weights.kernel;
+
+    // Zero-pad Fmnm' and apply spatial shift.
+    memset(inout, 0, (2*L-1)*w_n * sizeof *inout);
+    for (m = 0; m < 2*L-1; ++m)
+        for (mm = -(L-1); mm <= L-1; ++mm)
+            inout[(mm < 0 ? mm + w_n : mm) + w_n*m] =
+                Fmnm[m*Fmnm_m_stride + (mm + L-1)*Fmnm_mm_stride];
+
+    // Compute IFFT of Fmnm'.
+    fftw_execute_dft(plan->weights.plan_bwd, inout, inout);
+
+    // Compute product of Fmnm' and weight in real space.
+    for (m = 0; m < 2*L-1; ++m)
+        for (r = 0; r < w_n; ++r)
+            inout[r + w_n*m] *= kernel[r];
+
+    // Compute Gmnm' by FFT.
+    fftw_execute_dft(plan->weights.plan_fwd, inout, inout);
+
+    // Extract section of Gmnm' of interest.
+    for (m = 0; m < 2*L-1; ++m)
+        for (mm = -(L-1); mm <= L-1; ++mm)
+            Gmnm[m*Gmnm_m_stride + (mm + L-1)*Gmnm_mm_stride] =
+                inout[(mm < 0 ? mm + w_n : mm) + w_n*m];
+}
+
+// Set up the buffers and FFTW plans of the separation-of-variables
+// engine used by the transforms via SSHT. The engine walks el once and
+// applies each Wigner plane to all n, instead of computing every n
+// separately with a spin spherical harmonic transform (which repeats
+// the Wigner recursion for every n). The buffers for the blocks of n
+// are allocated by so3_plan_setup_sov_batch.
+void so3_plan_setup_sov(so3_plan_t *plan)
+{
+    int L = plan->parameters.L;
+    int ntheta, ntheta_ext, nphi, mm;
+    int mm_offset = L-1;
+    // FFTW-related variables
+    int fftw_n;
+
+    if (plan->sov.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_wigner(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    // The extended torus covers theta in [0, 2pi) with the sample
+    // spacing of the sampling scheme.
+    switch (plan->parameters.sampling_scheme)
+    {
+    case SO3_SAMPLING_MW:
+        ntheta = L;
+        ntheta_ext = 2*L-1;
+        nphi = 2*L-1;
+        break;
+    case SO3_SAMPLING_MW_SS:
+        ntheta = L+1;
+        ntheta_ext = 2*L;
+        nphi = 2*L;
+        break;
+    default:
+        SO3_ERROR_GENERIC("Invalid sampling scheme.");
+    }
+
+    plan->sov.ext = so3_plan_alloc_slabs(plan, plan->nthreads, ntheta_ext*nphi * sizeof *plan->sov.ext);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->sov.ext);
+    plan->sov.Fmm = so3_plan_alloc_slabs(plan, plan->nthreads, (2*L-1)*(2*L-1) * sizeof *plan->sov.Fmm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->sov.Fmm);
+
+    // Phase modulation to account for the sampling offset in theta.
+    plan->sov.expsmm = calloc(2*L-1, sizeof *plan->sov.expsmm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->sov.expsmm);
+    for (mm = -L+1; mm <= L-1; ++mm)
+        plan->sov.expsmm[mm + mm_offset] =
+            plan->parameters.sampling_scheme == SO3_SAMPLING_MW
+            ? cexp(I*mm*SO3_PI/(2.0*L-1.0))
+            : 1.0;
+
+    // 2D FFT to synthesise fn(theta, phi) on the extended torus. This
+    // is executed on the torus of each thread with fftw_execute_dft.
+    so3_plan_fftw_threads(1);
+    plan->sov.plan_inverse = fftw_plan_dft_2d(
+                                ntheta_ext, nphi,
+                                plan->sov.ext, plan->sov.ext,
+                                FFTW_BACKWARD,
+                                plan->flags);
+    SO3_PLAN_FFTW_CHECK(plan, plan->sov.plan_inverse);
+
+    // FFT over phi of each ring of fn. This and the FFT over theta
+    // are executed on the torus of each thread with fftw_execute_dft.
+    fftw_n = nphi;
+    plan->sov.plan_phi = fftw_plan_many_dft(
+            1, &fftw_n, ntheta,
+            plan->sov.ext, NULL, 1, nphi,
+            plan->sov.ext, NULL, 1, nphi,
+            FFTW_FORWARD, plan->flags
+    );
+    SO3_PLAN_FFTW_CHECK(plan, plan->sov.plan_phi);
+
+    // FFT over the extended theta for each m.
+    fftw_n = ntheta_ext;
+    plan->sov.plan_theta = fftw_plan_many_dft(
+            1, &fftw_n, nphi,
+            plan->sov.ext, NULL, nphi, 1,
+            plan->sov.ext, NULL, nphi, 1,
+            FFTW_FORWARD, plan->flags
+    );
+    SO3_PLAN_FFTW_CHECK(plan, plan->sov.plan_theta);
+
+    plan->sov.ntheta = ntheta;
+    plan->sov.ntheta_ext = ntheta_ext;
+    plan->sov.nphi = nphi;
+    plan->sov.ready = 1;
+}
+
+// Split the howmany columns of the FFTs over gamma into one chunk per
+// thread.
+static void so3_plan_gamma_chunks(
+    const so3_plan_t *plan, int howmany,
+    int *chunk, int *nchunks, int *last
+) {
+    *chunk = (howmany + plan->nthreads - 1) / plan->nthreads;
+    *nchunks = (howmany + *chunk - 1) / *chunk;
+    *last = howmany - (*nchunks - 1) * *chunk;
+}
+
+// The FFTs over gamma in the inverse transforms write directly into
+// the caller's signal buffer, which may differ between executions.
+// Hence, these plans are created with FFTW_UNALIGNED and executed with
+// the new-array execute functions.
+static void so3_plan_setup_inverse_via_ssht(so3_plan_t *plan, complex double *f)
+{
+    int N = plan->parameters.N;
+    int fn_n_stride, fftw_n;
+    int nchunks, last;
+    complex double *fftw_target;
+    // FFTW-related variables
+    int fftw_rank, fftw_howmany;
+    int fftw_idist, fftw_odist;
+    int fftw_istride, fftw_ostride;
+
+    if (plan->inverse_via_ssht.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_sov(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    fn_n_stride = so3_plan_fn_n_stride(&plan->parameters);
+
+    if (plan->parameters.steerable)
+    {
+        // For steerable signals, we need to supersample in n/gamma,
+        // in order to create a symmetric sampling.
+        fftw_n = 2*N; // Each transform is over 2*N
+
+        // We need to perform the FFT into a temporary buffer, because
+        // the result will be twice as large as the output we need.
+        plan->inverse_via_ssht.ftemp = malloc(2*N*fn_n_stride * sizeof *plan->inverse_via_ssht.ftemp);
+        SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_via_ssht.ftemp);
+
+        fftw_target = plan->inverse_via_ssht.ftemp;
+    }
+    else
+    {
+        fftw_n = 2*N-1; // Each transform is over 2*N-1
+
+        fftw_target = f;
+    }
+
+    plan->inverse_via_ssht.fn = calloc(fftw_n*fn_n_stride, sizeof *plan->inverse_via_ssht.fn);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_via_ssht.fn);
+
+    fftw_rank = 1; // We compute 1d transforms
+    // We need L*(2*L-1) of these transforms, split into chunks
+    so3_plan_gamma_chunks(plan, fn_n_stride, &fftw_howmany, &nchunks, &last);
+
+    // We want to transform columns
+    fftw_idist = fftw_odist = 1; // The starts of the columns are contiguous in memory
+    fftw_istride = fftw_ostride = fn_n_stride; // Distance between two elements of the same column
+
+    so3_plan_fftw_threads(1);
+    plan->inverse_via_ssht.plan = fftw_plan_many_dft(
+            fftw_rank, &fftw_n, fftw_howmany,
+            plan->inverse_via_ssht.fn, NULL, fftw_istride, fftw_idist,
+            fftw_target, NULL, fftw_ostride, fftw_odist,
+            FFTW_BACKWARD, plan->flags | FFTW_UNALIGNED
+    );
+    SO3_PLAN_FFTW_CHECK(plan, plan->inverse_via_ssht.plan);
+    if (last != fftw_howmany)
+    {
+        plan->inverse_via_ssht.plan_last = fftw_plan_many_dft(
+                fftw_rank, &fftw_n, last,
+                plan->inverse_via_ssht.fn, NULL, fftw_istride, fftw_idist,
+                fftw_target, NULL, fftw_ostride, fftw_odist,
+                FFTW_BACKWARD, plan->flags | FFTW_UNALIGNED
+        );
+        SO3_PLAN_FFTW_CHECK(plan, plan->inverse_via_ssht.plan_last);
+    }
+
+    plan->inverse_via_ssht.chunk = fftw_howmany;
+    plan->inverse_via_ssht.nchunks = nchunks;
+
+    plan->inverse_via_ssht.fn_n_stride = fn_n_stride;
+    plan->inverse_via_ssht.fftw_n = fftw_n;
+    plan->inverse_via_ssht.fn_dist = fftw_n*fn_n_stride;
+    plan->inverse_via_ssht.batch = 1;
+    plan->inverse_via_ssht.ready = 1;
+}
+
+static void so3_plan_setup_forward_via_ssht(so3_plan_t *plan)
+{
+    int N = plan->parameters.N;
+    int fn_n_stride;
+    int nchunks, last;
+    complex double *ftemp;
+    // FFTW-related variables
+    int fftw_rank, fftw_howmany;
+    int fftw_idist, fftw_odist;
+    int fftw_istride, fftw_ostride;
+    int fftw_n;
+
+    if (plan->forward_via_ssht.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_sov(plan);
+    so3_plan_setup_weights(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    fn_n_stride = so3_plan_fn_n_stride(&plan->parameters);
+
+    plan->forward_via_ssht.fn = calloc((2*N-1)*fn_n_stride, sizeof *plan->forward_via_ssht.fn);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_via_ssht.fn);
+
+    if (!plan->parameters.steerable)
+    {
+        // The FFTs read directly from the caller's signal, which is
+        // preserved by out-of-place transforms. The buffer is only
+        // needed for planning.
+        ftemp = malloc((2*N-1)*fn_n_stride * sizeof *ftemp);
+        SO3_PLAN_ALLOC_CHECK(plan, ftemp);
+
+        fftw_rank = 1;
+        fftw_n = 2*N-1;
+        so3_plan_gamma_chunks(plan, fn_n_stride, &fftw_howmany, &nchunks, &last);
+        fftw_idist = fftw_odist = 1;
+        fftw_istride = fftw_ostride = fn_n_stride;
+
+        so3_plan_fftw_threads(1);
+        plan->forward_via_ssht.plan = fftw_plan_many_dft(
+                fftw_rank, &fftw_n, fftw_howmany,
+                ftemp, NULL, fftw_istride, fftw_idist,
+                plan->forward_via_ssht.fn, NULL, fftw_ostride, fftw_odist,
+                FFTW_FORWARD, plan->flags | FFTW_UNALIGNED
+        );
+        SO3_PLAN_FFTW_CHECK(plan, plan->forward_via_ssht.plan);
+        if (last != fftw_howmany)
+        {
+            plan->forward_via_ssht.plan_last = fftw_plan_many_dft(
+                    fftw_rank, &fftw_n, last,
+                    ftemp, NULL, fftw_istride, fftw_idist,
+                    plan->forward_via_ssht.fn, NULL, fftw_ostride, fftw_odist,
+                    FFTW_FORWARD, plan->flags | FFTW_UNALIGNED
+            );
+            SO3_PLAN_FFTW_CHECK(plan, plan->forward_via_ssht.plan_last);
+        }
+
+        free(ftemp);
+
+        plan->forward_via_ssht.chunk = fftw_howmany;
+        plan->forward_via_ssht.nchunks = nchunks;
+    }
+
+    plan->forward_via_ssht.fn_n_stride = fn_n_stride;
+    plan->forward_via_ssht.fn_dist = (2*N-1)*fn_n_stride;
+    plan->forward_via_ssht.batch = 1;
+    plan->forward_via_ssht.ready = 1;
+}
+
+static void so3_plan_setup_inverse_via_ssht_real(so3_plan_t *plan, double *f)
+{
+    int N = plan->parameters.N;
+    int fn_n_stride, fftw_n;
+    int nchunks, last;
+    double *fftw_target;
+    // FFTW-related variables
+    int fftw_rank, fftw_howmany;
+    int fftw_idist, fftw_odist;
+    int fftw_istride, fftw_ostride;
+
+    if (plan->inverse_via_ssht_real.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_sov(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    fn_n_stride = so3_plan_fn_n_stride(&plan->parameters);
+
+    // Each transform is over fftw_n samples (logically; physically, fn for
+    // negative n will be omitted)
+    if (plan->parameters.steerable)
+    {
+        // For steerable signals, we need to supersample in n/gamma,
+        // in order to create a symmetric sampling.
+        fftw_n = 2*N;
+
+        // We need to perform the FFT into a temporary buffer, because
+        // the result will be twice as large as the output we need.
+        plan->inverse_via_ssht_real.ftemp = malloc(2*N*fn_n_stride * sizeof *plan->inverse_via_ssht_real.ftemp);
+        SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_via_ssht_real.ftemp);
+
+        fftw_target = plan->inverse_via_ssht_real.ftemp;
+    }
+    else
+    {
+        fftw_n = 2*N-1;
+
+        fftw_target = f;
+    }
+
+    // Only need to store for non-negative n
+    plan->inverse_via_ssht_real.fn = calloc((fftw_n/2+1)*fn_n_stride, sizeof *plan->inverse_via_ssht_real.fn);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_via_ssht_real.fn);
+
+    fftw_rank = 1; // We compute 1d transforms
+    // We need L*(2*L-1) of these transforms, split into chunks
+    so3_plan_gamma_chunks(plan, fn_n_stride, &fftw_howmany, &nchunks, &last);
+
+    // We want to transform columns
+    fftw_idist = fftw_odist = 1; // The starts of the columns are contiguous in memory
+    fftw_istride = fftw_ostride = fn_n_stride; // Distance between two elements of the same column
+
+    so3_plan_fftw_threads(1);
+    plan->inverse_via_ssht_real.plan = fftw_plan_many_dft_c2r(
+            fftw_rank, &fftw_n, fftw_howmany,
+            plan->inverse_via_ssht_real.fn, NULL, fftw_istride, fftw_idist,
+            fftw_target, NULL, fftw_ostride, fftw_odist,
+            plan->flags | FFTW_UNALIGNED
+    );
+    SO3_PLAN_FFTW_CHECK(plan, plan->inverse_via_ssht_real.plan);
+    if (last != fftw_howmany)
+    {
+        plan->inverse_via_ssht_real.plan_last = fftw_plan_many_dft_c2r(
+                fftw_rank, &fftw_n, last,
+                plan->inverse_via_ssht_real.fn, NULL, fftw_istride, fftw_idist,
+                fftw_target, NULL, fftw_ostride, fftw_odist,
+                plan->flags | FFTW_UNALIGNED
+        );
+        SO3_PLAN_FFTW_CHECK(plan, plan->inverse_via_ssht_real.plan_last);
+    }
+
+    plan->inverse_via_ssht_real.chunk = fftw_howmany;
+    plan->inverse_via_ssht_real.nchunks = nchunks;
+
+    plan->inverse_via_ssht_real.fn_n_stride = fn_n_stride;
+    plan->inverse_via_ssht_real.fftw_n = fftw_n;
+    plan->inverse_via_ssht_real.fn_dist = (fftw_n/2+1)*fn_n_stride;
+    plan->inverse_via_ssht_real.batch = 1;
+    plan->inverse_via_ssht_real.ready = 1;
+}
+
+static void so3_plan_setup_forward_via_ssht_real(so3_plan_t *plan)
+{
+    int N = plan->parameters.N;
+    int fn_n_stride;
+    int nchunks, last;
+    double *ftemp;
+    // FFTW-related variables
+    int fftw_rank, fftw_howmany;
+    int fftw_idist, fftw_odist;
+    int fftw_istride, fftw_ostride;
+    int fftw_n;
+
+    if (plan->forward_via_ssht_real.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_sov(plan);
+    so3_plan_setup_weights(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    fn_n_stride = so3_plan_fn_n_stride(&plan->parameters);
+
+    if (plan->parameters.steerable)
+    {
+        plan->forward_via_ssht_real.fn = calloc((2*N-1)*fn_n_stride, sizeof *plan->forward_via_ssht_real.fn);
+        SO3_PLAN_ALLOC_CHECK(plan, plan->forward_via_ssht_real.fn);
+    }
+    else
+    {
+        // The FFTs read directly from the caller's signal, which is
+        // preserved by out-of-place r2c transforms. The buffer is only
+        // needed for planning.
+        plan->forward_via_ssht_real.fn = malloc(N*fn_n_stride * sizeof *plan->forward_via_ssht_real.fn);
+        SO3_PLAN_ALLOC_CHECK(plan, plan->forward_via_ssht_real.fn);
+
+        ftemp = malloc((2*N-1)*fn_n_stride * sizeof *ftemp);
+        SO3_PLAN_ALLOC_CHECK(plan, ftemp);
+
+        fftw_rank = 1; // We compute 1d transforms
+        fftw_n = 2*N-1; // Each transform is over 2*N-1 (logically; physically, fn for negative n will be omitted)
+        // We need L*(2*L-1) of these transforms, split into chunks
+        so3_plan_gamma_chunks(plan, fn_n_stride, &fftw_howmany, &nchunks, &last);
+
+        // We want to transform columns
+        fftw_idist = fftw_odist = 1; // The starts of the columns are contiguous in memory
+        fftw_istride = fftw_ostride = fn_n_stride; // Distance between two elements of the same column
+
+        so3_plan_fftw_threads(1);
+        plan->forward_via_ssht_real.plan = fftw_plan_many_dft_r2c(
+                fftw_rank, &fftw_n, fftw_howmany,
+                ftemp, NULL, fftw_istride, fftw_idist,
+                plan->forward_via_ssht_real.fn, NULL, fftw_ostride, fftw_odist,
+                plan->flags | FFTW_UNALIGNED
+        );
+        SO3_PLAN_FFTW_CHECK(plan, plan->forward_via_ssht_real.plan);
+        if (last != fftw_howmany)
+        {
+            plan->forward_via_ssht_real.plan_last = fftw_plan_many_dft_r2c(
+                    fftw_rank, &fftw_n, last,
+                    ftemp, NULL, fftw_istride, fftw_idist,
+                    plan->forward_via_ssht_real.fn, NULL, fftw_ostride, fftw_odist,
+                    plan->flags | FFTW_UNALIGNED
+            );
+            SO3_PLAN_FFTW_CHECK(plan, plan->forward_via_ssht_real.plan_last);
+        }
+
+        free(ftemp);
+
+        plan->forward_via_ssht_real.chunk = fftw_howmany;
+        plan->forward_via_ssht_real.nchunks = nchunks;
+    }
+
+    plan->forward_via_ssht_real.fn_n_stride = fn_n_stride;
+    plan->forward_via_ssht_real.fn_dist = (plan->parameters.steerable ? 2*N-1 : N)*fn_n_stride;
+    plan->forward_via_ssht_real.batch = 1;
+    plan->forward_via_ssht_real.ready = 1;
+}
+
+static void so3_plan_setup_inverse_direct(so3_plan_t *plan)
+{
+    int L = plan->parameters.L;
+    int N = plan->parameters.N;
+    int mm;
+
+    if (plan->inverse_direct.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_wigner(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    // Fmnm' is processed in slabs of m', fext in slabs of n. Only
+    // m' >= 0 is stored, the rest follows by symmetry.
+    plan->inverse_direct.Fmnm = so3_plan_alloc_slabs(plan, L, (2*L-1)*(2*N-1) * sizeof *plan->inverse_direct.Fmnm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct.Fmnm);
+    plan->inverse_direct.mn_factors = calloc((2*L-1)*(2*N-1), sizeof *plan->inverse_direct.mn_factors);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct.mn_factors);
+    plan->inverse_direct.fext = so3_plan_alloc_slabs(plan, 2*N-1, (2*L-1)*(2*L-1) * sizeof *plan->inverse_direct.fext);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct.fext);
+    plan->inverse_direct.mm_phases = so3_plan_alloc_slabs(plan, plan->nthreads, (2*L-1) * sizeof *plan->inverse_direct.mm_phases);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct.mm_phases);
+
+    // Phase modulation to account for the sampling offset.
+    plan->inverse_direct.expsmm = calloc(2*L-1, sizeof *plan->inverse_direct.expsmm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct.expsmm);
+    for (mm = -L+1; mm <= L-1; ++mm)
+        plan->inverse_direct.expsmm[mm + L-1] = cexp(I*mm*SO3_PI/(2.0*L-1.0));
+
+    // The 3D FFT is executed outside of any parallel loop.
+    so3_plan_fftw_threads(plan->nthreads);
+    plan->inverse_direct.plan = fftw_plan_dft_3d(
+                                    2*N-1, 2*L-1, 2*L-1,
+                                    plan->inverse_direct.fext, plan->inverse_direct.fext,
+                                    FFTW_BACKWARD,
+                                    plan->flags);
+    SO3_PLAN_FFTW_CHECK(plan, plan->inverse_direct.plan);
+
+    plan->inverse_direct.batch = 1;
+    plan->inverse_direct.ready = 1;
+}
+
+static void so3_plan_setup_inverse_direct_real(so3_plan_t *plan)
+{
+    int L = plan->parameters.L;
+    int N = plan->parameters.N;
+
+    if (plan->inverse_direct_real.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_wigner(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    // Fmnm' and its shifted copy are processed in slabs of m'.
+    plan->inverse_direct_real.Fmnm = so3_plan_alloc_slabs(plan, 2*L-1, (2*L-1)*N * sizeof *plan->inverse_direct_real.Fmnm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct_real.Fmnm);
+    plan->inverse_direct_real.mn_factors = calloc((2*L-1)*N, sizeof *plan->inverse_direct_real.mn_factors);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct_real.mn_factors);
+    plan->inverse_direct_real.Fmnm_shift = so3_plan_alloc_slabs(plan, 2*L-1, (2*L-1)*N * sizeof *plan->inverse_direct_real.Fmnm_shift);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct_real.Fmnm_shift);
+    plan->inverse_direct_real.fext = so3_plan_alloc_slabs(plan, 2*L-1, (2*L-1)*(2*N-1) * sizeof *plan->inverse_direct_real.fext);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->inverse_direct_real.fext);
+
+    // The redundant dimension needs to be the last one.
+    so3_plan_fftw_threads(plan->nthreads);
+    plan->inverse_direct_real.plan = fftw_plan_dft_c2r_3d(
+                                        2*L-1, 2*L-1, 2*N-1,
+                                        plan->inverse_direct_real.Fmnm_shift,
+                                        plan->inverse_direct_real.fext,
+                                        plan->flags);
+    SO3_PLAN_FFTW_CHECK(plan, plan->inverse_direct_real.plan);
+
+    plan->inverse_direct_real.batch = 1;
+    plan->inverse_direct_real.ready = 1;
+}
+
+// Phases of the flmn accumulation of the direct forward transforms,
+// exps[(m-n) mod 4] for the n_count values of n from n_first, followed
+// by the same phases times (-1)^m, which is the m-dependent sign of the
+// Wigner symmetry for m' < 0. The kernel then needs no conditionals.
+static complex double *so3_plan_setup_flmn_phases(so3_plan_t *plan, int n_first, int n_count)
+{
+    int L = plan->parameters.L;
+    int m_stride = 2*L-1;
+    int m_offset = L-1;
+    complex double *phases;
+    int m, n;
+
+    phases = calloc(2*n_count*m_stride, sizeof *phases);
+    if (!phases)
+        return NULL;
+
+    for (n = n_first; n < n_first + n_count; ++n)
+        for (m = -L+1; m <= L-1; ++m)
+        {
+            complex double phase = plan->exps[((m-n)%4 + 4)%4];
+
+            phases[m + m_offset + m_stride*(n - n_first)] = phase;
+            phases[m + m_offset + m_stride*(n - n_first + n_count)] =
+                plan->signs[abs(m)] * phase;
+        }
+
+    return phases;
+}
+
+static void so3_plan_setup_forward_direct(so3_plan_t *plan)
+{
+    int L = plan->parameters.L;
+    int N = plan->parameters.N;
+    int mm;
+    int mm_offset = L-1;
+
+    if (plan->forward_direct.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_wigner(plan);
+    so3_plan_setup_wigner_block(plan);
+    so3_plan_setup_weights(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    plan->forward_direct.expsmm = calloc(2*L-1, sizeof *plan->forward_direct.expsmm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct.expsmm);
+    for (mm = -L+1; mm <= L-1; ++mm)
+        plan->forward_direct.expsmm[mm + mm_offset] = cexp(-I*mm*SSHT_PI/(2.0*L-1.0));
+
+    // Fmn(b), Fmnm' and Gmnm' are processed in slabs of n.
+    plan->forward_direct.Fmnb = so3_plan_alloc_slabs(plan, 2*N-1, (2*L-1)*(2*L-1) * sizeof *plan->forward_direct.Fmnb);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct.Fmnb);
+    plan->forward_direct.inout = so3_plan_alloc_slabs(plan, plan->nthreads, (2*L-1)*(2*N-1) * sizeof *plan->forward_direct.inout);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct.inout);
+    plan->forward_direct.Fmnm = so3_plan_alloc_slabs(plan, 2*N-1, (2*L-1)*(2*L-1) * sizeof *plan->forward_direct.Fmnm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct.Fmnm);
+    plan->forward_direct.Gmnm = so3_plan_alloc_slabs(plan, 2*N-1, (2*L-1)*(2*L-1) * sizeof *plan->forward_direct.Gmnm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct.Gmnm);
+    plan->forward_direct.phases = so3_plan_setup_flmn_phases(plan, -N+1, 2*N-1);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct.phases);
+
+    so3_plan_fftw_threads(1);
+    plan->forward_direct.plan_alpha_gamma = fftw_plan_dft_2d(
+                                                2*N-1, 2*L-1,
+                                                plan->forward_direct.inout,
+                                                plan->forward_direct.inout,
+                                                FFTW_FORWARD,
+                                                plan->flags);
+    SO3_PLAN_FFTW_CHECK(plan, plan->forward_direct.plan_alpha_gamma);
+    plan->forward_direct.plan_beta = fftw_plan_dft_1d(
+                                        2*L-1,
+                                        plan->forward_direct.inout,
+                                        plan->forward_direct.inout,
+                                        FFTW_FORWARD,
+                                        plan->flags);
+    SO3_PLAN_FFTW_CHECK(plan, plan->forward_direct.plan_beta);
+
+    plan->forward_direct.batch = 1;
+    plan->forward_direct.ready = 1;
+}
+
+static void so3_plan_setup_forward_direct_real(so3_plan_t *plan)
+{
+    int L = plan->parameters.L;
+    int N = plan->parameters.N;
+    int mm;
+    int mm_offset = L-1;
+
+    if (plan->forward_direct_real.ready || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_setup_wigner(plan);
+    so3_plan_setup_wigner_block(plan);
+    so3_plan_setup_weights(plan);
+    if (plan->status != SO3_SUCCESS)
+        return;
+
+    plan->forward_direct_real.expsmm = calloc(2*L-1, sizeof *plan->forward_direct_real.expsmm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct_real.expsmm);
+    for (mm = -L+1; mm <= L-1; ++mm)
+        plan->forward_direct_real.expsmm[mm + mm_offset] = cexp(-I*mm*SSHT_PI/(2.0*L-1.0));
+
+    // Fmn(b), Fmnm' and Gmnm' are processed in slabs of n.
+    plan->forward_direct_real.Fmnb = so3_plan_alloc_slabs(plan, N, (2*L-1)*(2*L-1) * sizeof *plan->forward_direct_real.Fmnb);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct_real.Fmnb);
+    plan->forward_direct_real.fft_in_dist = ((2*L-1)*(2*N-1) + 1) / 2 * 2;
+    plan->forward_direct_real.fft_in = so3_plan_alloc_slabs(plan, plan->nthreads,
+                                                           plan->forward_direct_real.fft_in_dist
+                                                           * sizeof *plan->forward_direct_real.fft_in);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct_real.fft_in);
+    plan->forward_direct_real.fft_out = so3_plan_alloc_slabs(plan, plan->nthreads, (2*L-1)*N * sizeof *plan->forward_direct_real.fft_out);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct_real.fft_out);
+    plan->forward_direct_real.inout = so3_plan_alloc_slabs(plan, plan->nthreads, (2*L-1) * sizeof *plan->forward_direct_real.inout);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct_real.inout);
+    plan->forward_direct_real.Fmnm = so3_plan_alloc_slabs(plan, N, (2*L-1)*(2*L-1) * sizeof *plan->forward_direct_real.Fmnm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct_real.Fmnm);
+    plan->forward_direct_real.Gmnm = so3_plan_alloc_slabs(plan, N, (2*L-1)*(2*L-1) * sizeof *plan->forward_direct_real.Gmnm);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct_real.Gmnm);
+    plan->forward_direct_real.phases = so3_plan_setup_flmn_phases(plan, 0, N);
+    SO3_PLAN_ALLOC_CHECK(plan, plan->forward_direct_real.phases);
+
+    // Redundant dimension needs to be last
+    so3_plan_fftw_threads(1);
+    plan->forward_direct_real.plan_alpha_gamma = fftw_plan_dft_r2c_2d(
+                                                    2*L-1, 2*N-1,
+                                                    plan->forward_direct_real.fft_in,
+                                                    plan->forward_direct_real.fft_out,
+                                                    plan->flags);
+    SO3_PLAN_FFTW_CHECK(plan, plan->forward_direct_real.plan_alpha_gamma);
+    plan->forward_direct_real.plan_beta = fftw_plan_dft_1d(
+                                            2*L-1,
+                                            plan->forward_direct_real.inout,
+                                            plan->forward_direct_real.inout,
+                                            FFTW_FORWARD,
+                                            plan->flags);
+    SO3_PLAN_FFTW_CHECK(plan, plan->forward_direct_real.plan_beta);
+
+    plan->forward_direct_real.batch = 1;
+    plan->forward_direct_real.ready = 1;
+}
+
+// Replace the contents of a scratch buffer by size zeros.
+static void so3_plan_resize_buffer(so3_plan_t *plan, complex double **buffer, size_t size)
+{
+    free(*buffer);
+    *buffer = calloc(size, sizeof **buffer);
+    if (!*buffer)
+        plan->status = SO3_ERROR_OUT_OF_MEMORY;
+}
+
+// Make room in the buffers of the separation-of-variables engine for a
+// group of signals with nblocks blocks of n each (see
+// so3_plan_sov_nblocks), which share each Wigner plane, and return the
+// size of the group, which is at most count. The group is limited such
+// that the Fmnm' of its signals take up at most SO3_PLAN_BATCH_BYTES.
+int so3_plan_setup_sov_batch(so3_plan_t *plan, int count, int nblocks)
+{
+    int L = plan->parameters.L;
+    size_t Fmnm_dist = (size_t)(2*L-1)*(2*L-1)*MAX(nblocks, 1);
+    int group = MAX(1, MIN(count, (int)(SO3_PLAN_BATCH_BYTES / (Fmnm_dist * sizeof(complex double)))));
+
+    if (plan->status != SO3_SUCCESS)
+        return group;
+
+    if (group*nblocks > plan->sov.nblocks)
+    {
+        so3_plan_resize_buffer(plan, &plan->sov.Fmnm, group*Fmnm_dist);
+        so3_plan_resize_buffer(plan, &plan->sov.mn_factors, (size_t)group*(2*L-1)*nblocks);
+        plan->sov.nblocks = group*nblocks;
+    }
+    // The synthesis and analysis are scheduled over the blocks of all
+    // signals.
+    if (!so3_schedule_reserve(plan->schedule, group*nblocks))
+        plan->status = SO3_ERROR_OUT_OF_MEMORY;
+
+    return group;
+}
+
+// Make room for a group of signals in the fn buffer of one of the
+// transforms via SSHT, whose blocks have fn_dist values each.
+static void so3_plan_setup_fn_batch(
+    so3_plan_t *plan, complex double **fn, int *batch, int fn_dist, int group
+) {
+    if (group <= *batch || plan->status != SO3_SUCCESS)
+        return;
+
+    so3_plan_resize_buffer(plan, fn, (size_t)group*fn_dist);
+    *batch = group;
+}
+
+// Make room in a buffer of one of the direct transforms for a group of
+// signals which share each Wigner plane, and return the size of the
+// group, which is at most count. The buffer is processed in nslabs
+// slabs, each of which holds slab_dist values of each of the *batch
+// signals there is room for. The group is limited such that the buffer
+// takes up at most SO3_PLAN_BATCH_BYTES. If factors is given, it is
+// resized along with the buffer, to factors_dist values per signal.
+static int so3_plan_setup_direct_batch(
+    so3_plan_t *plan, complex double **buffer, int *batch, int nslabs, size_t slab_dist,
+    complex double **factors, size_t factors_dist, int count
+) {
+    size_t signal_bytes = nslabs*slab_dist * sizeof **buffer;
+    int group = MAX(1, MIN(count, (int)(SO3_PLAN_BATCH_BYTES / signal_bytes)));
+
+    if (group <= *batch || plan->status != SO3_SUCCESS)
+        return group;
+
+    free(*buffer);
+    *buffer = so3_plan_alloc_slabs(plan, nslabs, group*slab_dist * sizeof **buffer);
+    if (!*buffer)
+    {
+        plan->status = SO3_ERROR_OUT_OF_MEMORY;
+        return group;
+    }
+    if (factors)
+        so3_plan_resize_buffer(plan, factors, group*factors_dist);
+    *batch = group;
+
+    return group;
+}
+
+//============================================================================
+// Plan preparation and FFTW wisdom
+//============================================================================
+
+/*!
+ * Perform the setup of the selected transforms matching the \link
+ * so3_parameters_t::reality reality\endlink flag of the plan's
+ * parameters (forward and inverse) up front, instead of on their first
+ * execution. In particular, this creates the FFTW plans, which
+ * accumulates the corresponding FFTW wisdom, and allocates the scratch
+ * buffers of the transforms.
+ *
+ * The direct transforms are only set up for MW sampling without
+ * steerability, the only configuration they support, even if \link
+ * SO3_PLAN_PREPARE_DIRECT \endlink is requested.
+ *
+ * \param[in]  plan Plan to prepare.
+ * \param[in]  algorithms Bitwise or of \link SO3_PLAN_PREPARE_VIA_SSHT
+ *                        \endlink and \link SO3_PLAN_PREPARE_DIRECT
+ *                        \endlink, or \link SO3_PLAN_PREPARE_ALL \endlink.
+ * \retval status \link SO3_SUCCESS \endlink, \link
+ *                SO3_ERROR_OUT_OF_MEMORY \endlink or \link
+ *                SO3_ERROR_FFTW \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_prepare(so3_plan_t *plan, unsigned algorithms)
+{
+    int N = plan->parameters.N;
+    int fn_n_stride = so3_plan_fn_n_stride(&plan->parameters);
+    int via_ssht, direct;
+
+    via_ssht = algorithms & SO3_PLAN_PREPARE_VIA_SSHT;
+    direct = (algorithms & SO3_PLAN_PREPARE_DIRECT)
+        && plan->parameters.sampling_scheme == SO3_SAMPLING_MW
+        && !plan->parameters.steerable;
+
+    // The FFTW planner is not thread-safe.
+    #pragma omp critical (so3_fftw_planner)
+    {
+        if (plan->parameters.reality)
+        {
+            // The inverse via SSHT plans its FFT on the output buffer.
+            double *f;
+
+            if (via_ssht && !plan->inverse_via_ssht_real.ready
+                && plan->status == SO3_SUCCESS)
+            {
+                f = malloc((2*N-1)*fn_n_stride * sizeof *f);
+                if (f)
+                    so3_plan_setup_inverse_via_ssht_real(plan, f);
+                else
+                    plan->status = SO3_ERROR_OUT_OF_MEMORY;
+                free(f);
+            }
+            if (via_ssht)
+                so3_plan_setup_forward_via_ssht_real(plan);
+            if (direct)
+            {
+                so3_plan_setup_inverse_direct_real(plan);
+                so3_plan_setup_forward_direct_real(plan);
+            }
+        }
+        else
+        {
+            // The inverse via SSHT plans its FFT on the output buffer.
+            complex double *f;
+
+            if (via_ssht && !plan->inverse_via_ssht.ready
+                && plan->status == SO3_SUCCESS)
+            {
+                f = malloc((2*N-1)*fn_n_stride * sizeof *f);
+                if (f)
+                    so3_plan_setup_inverse_via_ssht(plan, f);
+                else
+                    plan->status = SO3_ERROR_OUT_OF_MEMORY;
+                free(f);
+            }
+            if (via_ssht)
+                so3_plan_setup_forward_via_ssht(plan);
+            if (direct)
+            {
+                so3_plan_setup_inverse_direct(plan);
+                so3_plan_setup_forward_direct(plan);
+            }
+        }
+    }
+
+    // The buffers of the separation of variables, for single signals.
+    if (via_ssht)
+        so3_plan_setup_sov_batch(plan, 1, so3_plan_sov_nblocks(&plan->parameters, NULL,
+                                                               plan->parameters.reality));
+
+    return plan->status;
+}
+
+/*!
+ * Import FFTW wisdom from a file, e.g. one written by \link
+ * so3_plan_export_wisdom \endlink or the so3_wisdom program. Wisdom is
+ * global to the process and is used by all plans created afterwards,
+ * including the temporary plans of the so3_core routines (FFTW uses
+ * available wisdom of equal or greater planning rigour).
+ *
+ * \param[in]  filename Name of the wisdom file.
+ * \retval success 1 if the wisdom was imported, 0 if the file could not
+ *                 be read or does not contain valid wisdom.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_plan_import_wisdom(const char *filename)
+{
+    FILE *file;
+    int success;
+
+    file = fopen(filename, "r");
+    if (!file)
+        return 0;
+
+    #pragma omp critical (so3_fftw_planner)
+    success = fftw_import_wisdom_from_file(file);
+    fclose(file);
+
+    return success;
+}
+
+/*!
+ * Export all FFTW wisdom accumulated by the process to a file.
+ *
+ * \param[in]  filename Name of the wisdom file. An existing file is
+ *                      overwritten.
+ * \retval success 1 if the wisdom was written, 0 otherwise.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_plan_export_wisdom(const char *filename)
+{
+    FILE *file;
+
+    file = fopen(filename, "w");
+    if (!file)
+        return 0;
+
+    #pragma omp critical (so3_fftw_planner)
+    fftw_export_wisdom_to_file(file);
+
+    return fclose(file) == 0;
+}
+
+//============================================================================
+// Transforms via SSHT
+//============================================================================
+
+// Check whether the transforms via SSHT skip a given n for the
+// n-mode of the parameters.
+static int so3_plan_sov_skip_n(const so3_parameters_t *parameters, int n)
+{
+    so3_n_mode_t n_mode = parameters->n_mode;
+    int N = parameters->N;
+
+    return (n_mode == SO3_N_MODE_EVEN && n % 2)
+           || (n_mode == SO3_N_MODE_ODD && !(n % 2))
+           || (n_mode == SO3_N_MODE_MAXIMUM && abs(n) < N-1);
+}
+
+// Check whether the transforms via SSHT skip a given el for a given n,
+// i.e. whether flmn vanishes for all m. Besides the n skipped by
+// so3_plan_sov_skip_n and all |n| > el, this is the case for all
+// |n| != el in N_MODE_L.
+static int so3_plan_sov_skip_eln(const so3_parameters_t *parameters, int el, int n)
+{
+    return abs(n) > el
+           || so3_plan_sov_skip_n(parameters, n)
+           || (parameters->n_mode == SO3_N_MODE_L && abs(n) != el);
+}
+
+// Value of n of the kth block of flmn, in the storage order of the
+// parameters for a complex signal.
+int so3_plan_block_n(const so3_parameters_t *parameters, int k)
+{
+    if (parameters->n_order == SO3_N_ORDER_ZERO_FIRST)
+        return k % 2 ? -(k+1)/2 : k/2;
+    else
+        return k - parameters->N + 1;
+}
+
+// Number of blocks of n the separation-of-variables engine computes for
+// each signal: those of a slab, or those of all n (n >= 0 for real
+// signals).
+int so3_plan_sov_nblocks(const so3_parameters_t *parameters, const so3_plan_slab_t *slab, int real)
+{
+    if (slab)
+        return slab->k_stop - slab->k_first;
+
+    return real ? parameters->N : 2*parameters->N-1;
+}
+
+// Value of n of the jth block of the separation-of-variables engine.
+// Without a slab, the blocks are in order of increasing n.
+static int so3_plan_sov_block_n(
+    const so3_parameters_t *parameters, const so3_plan_slab_t *slab, int real, int j
+) {
+    if (slab)
+        return so3_plan_block_n(parameters, slab->k_first + j);
+
+    return real ? j : j - parameters->N + 1;
+}
+
+// Kinds of FFTs over gamma.
+typedef enum {
+    SO3_PLAN_GAMMA_DFT,         // inverse, complex fn to complex f
+    SO3_PLAN_GAMMA_C2R,         // inverse, complex fn to real f
+    SO3_PLAN_GAMMA_DFT_FORWARD, // forward, complex f to complex fn
+    SO3_PLAN_GAMMA_R2C          // forward, real f to complex fn
+} so3_plan_gamma_t;
+
+// The FFTs over gamma of a group of signals. Each item of work is one
+// chunk of columns of one signal, and the threads take the items in
+// any order. This allows the FFTs of one group to be executed by
+// threads which would otherwise wait within the separation of
+// variables of another group (see so3_plan_gamma_job_help).
+struct so3_plan_gamma_job {
+    so3_plan_gamma_t type;
+    fftw_plan plan, plan_last;
+    int chunk, nchunks;
+    void *f;
+    int f_dist;
+    complex double *fn;
+    int fn_dist;
+    // Number of rows of fn and factor which they are scaled by after a
+    // forward FFT.
+    int nrows, fn_n_stride;
+    double factor;
+    int count;
+    // Next item to be taken.
+    int next;
+};
+
+// Set up the FFTs over gamma between fn and f for count signals, which
+// are fn_dist and f_dist values apart.
+static void so3_plan_gamma_job_init(
+    so3_plan_gamma_job_t *job,
+    const so3_plan_t *plan, so3_plan_gamma_t type,
+    void *f, int f_dist,
+    complex double *fn, int fn_dist,
+    int count
+) {
+    int N = plan->parameters.N;
+
+    switch (type)
+    {
+    case SO3_PLAN_GAMMA_DFT:
+        job->plan = plan->inverse_via_ssht.plan;
+        job->plan_last = plan->inverse_via_ssht.plan_last;
+        job->chunk = plan->inverse_via_ssht.chunk;
+        job->nchunks = plan->inverse_via_ssht.nchunks;
+        break;
+    case SO3_PLAN_GAMMA_C2R:
+        job->plan = plan->inverse_via_ssht_real.plan;
+        job->plan_last = plan->inverse_via_ssht_real.plan_last;
+        job->chunk = plan->inverse_via_ssht_real.chunk;
+        job->nchunks = plan->inverse_via_ssht_real.nchunks;
+        break;
+    case SO3_PLAN_GAMMA_DFT_FORWARD:
+        job->plan = plan->forward_via_ssht.plan;
+        job->plan_last = plan->forward_via_ssht.plan_last;
+        job->chunk = plan->forward_via_ssht.chunk;
+        job->nchunks = plan->forward_via_ssht.nchunks;
+        job->nrows = 2*N-1;
+        break;
+    case SO3_PLAN_GAMMA_R2C:
+        job->plan = plan->forward_via_ssht_real.plan;
+        job->plan_last = plan->forward_via_ssht_real.plan_last;
+        job->chunk = plan->forward_via_ssht_real.chunk;
+        job->nchunks = plan->forward_via_ssht_real.nchunks;
+        job->nrows = N;
+        break;
+    }
+
+    job->type = type;
+    job->f = f;
+    job->f_dist = f_dist;
+    job->fn = fn;
+    job->fn_dist = fn_dist;
+    job->fn_n_stride = so3_plan_fn_n_stride(&plan->parameters);
+    job->factor = 2*SO3_PI/(double)(2*N-1);
+    job->count = count;
+    job->next = 0;
+}
+
+// Execute one item of the FFTs over gamma.
+static void so3_plan_gamma_job_run(so3_plan_gamma_job_t *job, int item)
+{
+    int fn_n_stride = job->fn_n_stride;
+    int k = item / job->nchunks, c = item % job->nchunks;
+    int last = c == job->nchunks-1 && job->plan_last;
+    fftw_plan fplan = last ? job->plan_last : job->plan;
+    complex double *fn = job->fn + (size_t)k*job->fn_dist + c*job->chunk;
+    size_t f_offset = (size_t)k*job->f_dist + c*job->chunk;
+    int howmany, i, j;
+
+    // Out-of-place forward transforms preserve their input.
+    switch (job->type)
+    {
+    case SO3_PLAN_GAMMA_DFT:
+        fftw_execute_dft(fplan, fn, (complex double *)job->f + f_offset);
+        return;
+    case SO3_PLAN_GAMMA_C2R:
+        fftw_execute_dft_c2r(fplan, fn, (double *)job->f + f_offset);
+        return;
+    case SO3_PLAN_GAMMA_DFT_FORWARD:
+        fftw_execute_dft(fplan, (complex double *)job->f + f_offset, fn);
+        break;
+    case SO3_PLAN_GAMMA_R2C:
+        fftw_execute_dft_r2c(fplan, (double *)job->f + f_offset, fn);
+        break;
+    }
+
+    // Normalise the columns of the chunk.
+    howmany = last ? fn_n_stride - c*job->chunk : job->chunk;
+    for (i = 0; i < job->nrows; ++i)
+        for (j = 0; j < howmany; ++j)
+            fn[i*fn_n_stride + j] *= job->factor;
+}
+
+// Execute items of the FFTs over gamma until all have been taken or,
+// if plane_el is not NULL, until *plane_el equals el. job may be NULL.
+// Called by the threads of a team in between their own work.
+static void so3_plan_gamma_job_help(
+    so3_plan_gamma_job_t *job, const int *plane_el, int el
+) {
+    int item, current;
+
+    if (!job)
+        return;
+
+    for (;;)
+    {
+        if (plane_el)
+        {
+            #pragma omp atomic read
+            current = *plane_el;
+            if (current == el)
+                return;
+        }
+
+        #pragma omp atomic capture
+        item = job->next++;
+        if (item >= job->count*job->nchunks)
+            return;
+
+        so3_plan_gamma_job_run(job, item);
+    }
+}
+
+// Execute all FFTs over gamma of a job on the threads of the plan.
+static void so3_plan_gamma_job_execute(so3_plan_t *plan, so3_plan_gamma_job_t *job)
+{
+    #pragma omp parallel num_threads(plan->nthreads)
+    so3_plan_gamma_job_help(job, NULL, 0);
+}
+
+// Compute fn(theta, phi) from flmn for all n, for count signals whose
+// flmn and fn are flmn_dist and fn_dist values apart. The blocks of fn
+// are stored in n-order 0, 1, 2, ..., -2, -1, where fftw_n is the
+// number of blocks. For real signals, only the blocks for n >= 0 are
+// computed. If slab is not NULL, only the blocks of the slab are
+// computed, and stored as described for so3_plan_slab_t. Blocks for
+// skipped n are not touched.
+//
+// Each Wigner plane is computed by one thread and then applied by all
+// threads, which are assigned different m', to all signals, so that the
+// plane is reused while it is in cache. Each thread thus does the same
+// amount of work for all n, even though the number of el that
+// contribute to Fmnm' decreases with |n|. The subsequent synthesis of
+// each n of each signal costs the same, and is distributed over the
+// threads, each of which uses its own extended torus.
+//
+// The FFTs over gamma of the previous group of signals, pending, are
+// executed by the threads which wait for a Wigner plane, and the rest
+// of them before the synthesis, such that both stages overlap. pending
+// may be NULL.
+void so3_plan_sov_inverse(
+    so3_plan_t *plan,
+    complex double *fn, int fn_dist, int fftw_n,
+    const complex double *flmn, int flmn_dist,
+    int count, int real, const so3_plan_slab_t *slab,
+    so3_plan_gamma_job_t *pending
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L0 = parameters->L0;
+    int L = parameters->L;
+    int N = parameters->N;
+    int ntheta = plan->sov.ntheta;
+    int ntheta_ext = plan->sov.ntheta_ext;
+    int nphi = plan->sov.nphi;
+    int fn_n_stride = ntheta * nphi;
+
+    double *signs = plan->signs;
+    complex double *exps = plan->exps;
+    complex double *expsmm = plan->sov.expsmm;
+    complex double *Fmnm = plan->sov.Fmnm;
+    complex double *mn_factors = plan->sov.mn_factors;
+
+    int m_offset = L-1;
+    int m_stride = 2*L-1;
+    int mm_offset = L-1;
+    int mm_stride = 2*L-1;
+    int n_min = real ? 0 : -N+1;
+    int nblocks = so3_plan_sov_nblocks(parameters, slab, real);
+    int flmn_base = slab ? slab->flmn_base : 0;
+    // Distance between the blocks of consecutive signals.
+    size_t Fmnm_dist = (size_t)m_stride*mm_stride*nblocks;
+    size_t mn_dist = (size_t)m_stride*nblocks;
+
+    // Shared between the threads.
+    const double *dl;
+    int dl_offset, dl_stride;
+    // Last el whose Wigner plane has been computed.
+    int plane_el = L0-1;
+
+    #pragma omp parallel num_threads(plan->nthreads)
+    {
+        int el, m, n, mm, k, j; // mm for m', k for the signal, j for the block
+        int first, last, i;
+        int thread = omp_get_thread_num();
+        complex double *ext = plan->sov.ext + thread*ntheta_ext*nphi;
+
+        // Compute Fmnm' for all n, sharing each Wigner plane between them.
+        #pragma omp for schedule(static)
+        for (j = 0; j < nblocks; ++j)
+            for (k = 0; k < count; ++k)
+                memset(Fmnm + k*Fmnm_dist + m_stride*mm_stride*j, 0,
+                       m_stride*mm_stride * sizeof *Fmnm);
+
+        for (el = L0; el <= L-1; ++el)
+        {
+            // Blocks which may contribute, i.e. those of |n| <= el.
+            // Without a slab, they are consecutive.
+            int j_start = slab ? 0 : MAX(n_min, -el) - n_min;
+            int j_stop  = slab ? nblocks-1 : MIN(N-1, el) - n_min;
+
+            // Factor which depends only on el.
+            double elfactor = (2.0*el+1.0)/(8.0*SO3_PI*SO3_PI);
+
+            // Compute Wigner plane, while the other threads execute
+            // pending FFTs.
+            #pragma omp single nowait
+            {
+                dl = so3_plan_get_wigner_plane(plan, el, &dl_offset, &dl_stride);
+                #pragma omp atomic write
+                plane_el = el;
+            }
+            so3_plan_gamma_job_help(pending, &plane_el, el);
+            #pragma omp barrier
+
+            // Factors which do not depend on m'.
+            #pragma omp for schedule(static)
+            for (j = j_start; j <= j_stop; ++j)
+            {
+                n = so3_plan_sov_block_n(parameters, slab, real, j);
+                if (so3_plan_sov_skip_eln(parameters, el, n))
+                    continue;
+
+                for (m = -el; m <= el; ++m)
+                {
+                    int ind;
+                    if (real)
+                        so3_sampling_elmn2ind_real(&ind, el, m, n, parameters);
+                    else
+                        so3_sampling_elmn2ind(&ind, el, m, n, parameters);
+                    int mod = ((n-m)%4 + 4)%4;
+                    for (k = 0; k < count; ++k)
+                        mn_factors[k*mn_dist + m + m_offset + m_stride*j] =
+                            flmn[k*flmn_dist + ind - flmn_base] * exps[mod];
+                }
+            }
+
+            #pragma omp for schedule(static)
+            for (mm = 0; mm <= el; ++mm)
+            {
+                // These signs are needed for the symmetry relations of
+                // Wigner symbols.
+                double elmmsign = signs[el] * signs[mm];
+
+                for (j = j_start; j <= j_stop; ++j)
+                {
+                    n = so3_plan_sov_block_n(parameters, slab, real, j);
+                    if (so3_plan_sov_skip_eln(parameters, el, n))
+                        continue;
+
+                    double elnsign = n >= 0 ? 1.0 : elmmsign;
+                    // Factor which does not depend on m.
+                    double elnmm_factor = elfactor * elnsign
+                                          * dl[abs(n) + dl_offset + mm*dl_stride];
+
+                    for (k = 0; k < count; ++k)
+                    {
+                        complex double *Fmm = Fmnm + k*Fmnm_dist + m_stride*(
+                                                     mm + mm_offset + mm_stride*j);
+                        complex double *mn_factors_n = mn_factors + k*mn_dist
+                                                       + m_stride*j;
+
+                        so3_simd_accumulate_fmnm(
+                            Fmm + m_offset, mn_factors_n + m_offset,
+                            dl + dl_offset + mm*dl_stride,
+                            el, elnmm_factor * elmmsign, elnmm_factor);
+                    }
+                }
+            }
+        }
+
+        // Synthesise fn(theta, phi) for each n of each signal. Each n
+        // costs the same, apart from skipped n, which cost nothing.
+        #pragma omp single
+        {
+            double *cost = so3_schedule_costs(plan->schedule, count*nblocks);
+            for (i = 0; i < count*nblocks; ++i)
+                cost[i] = so3_plan_sov_skip_n(parameters,
+                                              so3_plan_sov_block_n(parameters, slab, real, i % nblocks))
+                          ? 0.0 : 1.0;
+            so3_schedule_partition(plan->schedule);
+        }
+
+        so3_plan_gamma_job_help(pending, NULL, 0);
+
+        while (so3_schedule_next(plan->schedule, thread, &first, &last))
+        {
+            for (i = first; i < last; ++i)
+            {
+                complex double *Fmm;
+                int offset;
+
+                k = i / nblocks;
+                j = i % nblocks;
+                n = so3_plan_sov_block_n(parameters, slab, real, j);
+                if (so3_plan_sov_skip_n(parameters, n))
+                    continue;
+
+                Fmm = Fmnm + k*Fmnm_dist + m_stride*mm_stride*j;
+
+                // Use symmetry to compute Fmnm' for negative m'.
+                for (mm = -L+1; mm < 0; ++mm)
+                    for (m = -L+1; m <= L-1; ++m)
+                        Fmm[m + m_offset + m_stride*(mm + mm_offset)] =
+                            signs[abs(m+n)%2]
+                            * Fmm[m + m_offset + m_stride*(-mm + mm_offset)];
+
+                // Apply phase modulation to account for sampling offset and
+                // spatial shift onto the extended torus.
+                memset(ext, 0, ntheta_ext*nphi * sizeof *ext);
+                for (mm = -L+1; mm <= L-1; ++mm)
+                {
+                    int mm_shift = mm < 0 ? ntheta_ext : 0;
+                    complex double *ext_mm = ext + nphi*(mm + mm_shift);
+                    const complex double *Fmm_mm = Fmm + m_offset + m_stride*(mm + mm_offset);
+
+                    so3_simd_scale(ext_mm, Fmm_mm, expsmm[mm + mm_offset], L);
+                    so3_simd_scale(ext_mm + nphi-L+1, Fmm_mm - L+1, expsmm[mm + mm_offset], L-1);
+                }
+
+                fftw_execute_dft(plan->sov.plan_inverse, ext, ext);
+
+                // The conditional applies the spatial transform, so that we store
+                // the results in n-order 0, 1, 2, -2, -1 (or in the order of
+                // the slab)
+                offset = slab ? j : (n < 0 ? n + fftw_n : n);
+
+                // The first ntheta rings of the extended torus are the samples.
+                memcpy(fn + k*fn_dist + offset*fn_n_stride, ext, fn_n_stride * sizeof *fn);
+            }
+        }
+    }
+}
+
+// Compute flmn from fn(theta, phi) for count signals, stored as in
+// so3_plan_sov_inverse and scaled such that fn is 2pi times the Fourier
+// coefficient in gamma. The flmn of all n which are not skipped are
+// overwritten, with zeros for the el skipped by so3_plan_sov_skip_eln.
+// If slab is not NULL, only the flmn of the blocks of the slab are
+// computed, from the fn stored as described for so3_plan_slab_t.
+//
+// The analysis of each n of each signal is distributed over the
+// threads, each of which uses its own extended torus and convolution
+// buffers. The threads then share each Wigner plane, apply it to all
+// signals and write the flmn of disjoint n, so no synchronisation
+// beyond one barrier per el is needed.
+//
+// The FFTs over gamma of the next group of signals, pending, are
+// executed by the threads which wait for a Wigner plane, and the rest
+// of them at the end, such that both stages overlap. pending may be
+// NULL.
+void so3_plan_sov_forward(
+    so3_plan_t *plan,
+    complex double *flmn, int flmn_dist,
+    const complex double *fn, int fn_dist, int fftw_n,
+    int count, int real, const so3_plan_slab_t *slab,
+    so3_plan_gamma_job_t *pending
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L0 = parameters->L0;
+    int L = parameters->L;
+    int N = parameters->N;
+    int ntheta = plan->sov.ntheta;
+    int ntheta_ext = plan->sov.ntheta_ext;
+    int nphi = plan->sov.nphi;
+    int fn_n_stride = ntheta * nphi;
+    // Samples b and theta_reflect - b lie symmetrically about theta = pi.
+    int theta_reflect = parameters->sampling_scheme == SO3_SAMPLING_MW ? 2*L-2 : 2*L;
+
+    double *signs = plan->signs;
+    complex double *exps = plan->exps;
+    complex double *expsmm = plan->sov.expsmm;
+    complex double *Gmnm = plan->sov.Fmnm;
+
+    int m_offset = L-1;
+    int m_stride = 2*L-1;
+    int mm_offset = L-1;
+    int mm_stride = 2*L-1;
+    int n_min = real ? 0 : -N+1;
+    int nblocks = so3_plan_sov_nblocks(parameters, slab, real);
+    int flmn_base = slab ? slab->flmn_base : 0;
+    // Distance between the blocks of consecutive signals.
+    size_t Gmnm_dist = (size_t)m_stride*mm_stride*nblocks;
+
+    double norm_factor = 1.0/nphi/ntheta_ext/(2.0*SO3_PI);
+    // Blocks for which Gmnm' is computed, i.e. those of |n| < L. Without
+    // a slab, they are consecutive.
+    int j_first = slab ? 0 : MAX(n_min, -L+1) - n_min;
+    int j_count = slab ? nblocks : MIN(N-1, L-1) - MAX(n_min, -L+1) + 1;
+
+    // Shared between the threads.
+    const double *dl;
+    int dl_offset, dl_stride;
+    // Last el whose Wigner plane has been computed.
+    int plane_el = L0-1;
+
+    #pragma omp parallel num_threads(plan->nthreads)
+    {
+        int el, m, n, mm, b, k, j; // mm for m', k for the signal, j for the block
+        int first, last, i;
+        int thread = omp_get_thread_num();
+        complex double *ext = plan->sov.ext + thread*ntheta_ext*nphi;
+        complex double *Fmm = plan->sov.Fmm + thread*m_stride*mm_stride;
+        complex double *inout = plan->weights.inout + thread*m_stride*(4*L-3);
+
+        // Compute Gmnm' for each n of each signal. Each n costs the
+        // same, apart from skipped n, which cost nothing.
+        #pragma omp single
+        {
+            double *cost = so3_schedule_costs(plan->schedule, count*j_count);
+            for (i = 0; i < count*j_count; ++i)
+            {
+                n = so3_plan_sov_block_n(parameters, slab, real, j_first + i % j_count);
+                cost[i] = so3_plan_sov_skip_n(parameters, n) || abs(n) >= L ? 0.0 : 1.0;
+            }
+            so3_schedule_partition(plan->schedule);
+        }
+
+        while (so3_schedule_next(plan->schedule, thread, &first, &last))
+        {
+            for (i = first; i < last; ++i)
+            {
+                int offset;
+
+                k = i / j_count;
+                j = j_first + i % j_count;
+                n = so3_plan_sov_block_n(parameters, slab, real, j);
+                if (so3_plan_sov_skip_n(parameters, n) || abs(n) >= L)
+                    continue;
+
+                // The conditional applies the spatial transform, because the fn
+                // are stored in n-order 0, 1, 2, -2, -1 (or in the order of
+                // the slab)
+                offset = slab ? j : (n < 0 ? n + fftw_n : n);
+
+                // Compute Fourier transform over phi, i.e. compute Fmn(b).
+                memcpy(ext, fn + k*fn_dist + offset*fn_n_stride, fn_n_stride * sizeof *ext);
+                fftw_execute_dft(plan->sov.plan_phi, ext, ext);
+
+                // Extend Fmn(b) periodically.
+                for (b = ntheta; b < ntheta_ext; ++b)
+                    for (m = -L+1; m <= L-1; ++m)
+                    {
+                        int m_shift = m < 0 ? nphi : 0;
+                        ext[m + m_shift + nphi*b] =
+                            signs[abs(m+n)%2]
+                            * ext[m + m_shift + nphi*(theta_reflect - b)];
+                    }
+
+                // Compute Fourier transform over theta, i.e. compute Fmnm'.
+                fftw_execute_dft(plan->sov.plan_theta, ext, ext);
+
+                // Apply spatial shift, normalisation factor and phase
+                // modulation to account for sampling offset.
+                for (m = -L+1; m <= L-1; ++m)
+                {
+                    int m_shift = m < 0 ? nphi : 0;
+                    for (mm = -L+1; mm <= L-1; ++mm)
+                    {
+                        int mm_shift = mm < 0 ? ntheta_ext : 0;
+                        Fmm[mm + mm_offset + mm_stride*(m + m_offset)] =
+                            ext[m + m_shift + nphi*(mm + mm_shift)]
+                            * norm_factor * conj(expsmm[mm + mm_offset]);
+                    }
+                }
+
+                // Compute Gmnm' by convolution implemented as product in
+                // real space.
+                so3_plan_weight_convolution(
+                    plan, inout,
+                    Gmnm + k*Gmnm_dist + m_stride*mm_stride*j, 1, m_stride,
+                    Fmm, mm_stride, 1);
+            }
+        }
+
+        // Compute flmn.
+        #pragma omp for schedule(static)
+        for (j = 0; j < nblocks; ++j)
+        {
+            n = so3_plan_sov_block_n(parameters, slab, real, j);
+            if (so3_plan_sov_skip_n(parameters, n))
+                continue;
+
+            for (el = abs(n); el < L; ++el)
+                for (m = -el; m <= el; ++m)
+                {
+                    int ind;
+                    if (real)
+                        so3_sampling_elmn2ind_real(&ind, el, m, n, parameters);
+                    else
+                        so3_sampling_elmn2ind(&ind, el, m, n, parameters);
+                    for (k = 0; k < count; ++k)
+                        flmn[k*flmn_dist + ind - flmn_base] = 0.0;
+                }
+        }
+
+        for (el = L0; el < L; ++el)
+        {
+            // Blocks which may contribute, i.e. those of |n| <= el.
+            // Without a slab, they are consecutive.
+            int j_start = slab ? 0 : MAX(n_min, -el) - n_min;
+            int j_stop  = slab ? nblocks-1 : MIN(N-1, el) - n_min;
+
+            // Compute Wigner plane, while the other threads execute
+            // pending FFTs.
+            #pragma omp single nowait
+            {
+                dl = so3_plan_get_wigner_plane(plan, el, &dl_offset, &dl_stride);
+                #pragma omp atomic write
+                plane_el = el;
+            }
+            so3_plan_gamma_job_help(pending, &plane_el, el);
+            #pragma omp barrier
+
+            // All n cost the same for a given el.
+            #pragma omp for schedule(static)
+            for (j = j_start; j <= j_stop; ++j)
+            {
+                n = so3_plan_sov_block_n(parameters, slab, real, j);
+                if (so3_plan_sov_skip_eln(parameters, el, n))
+                    continue;
+
+                for (mm = -el; mm <= el; ++mm)
+                {
+                    // These signs are needed for the symmetry relations of
+                    // Wigner symbols.
+                    double elmmsign = signs[el] * signs[abs(mm)];
+                    double mmsign = mm >= 0 ? 1.0 : signs[el] * signs[abs(n)];
+                    double elnsign = n >= 0 ? 1.0 : elmmsign;
+
+                    // Factor which does not depend on m.
+                    double elnmm_factor = mmsign * elnsign
+                                          * dl[abs(n) + dl_offset + abs(mm)*dl_stride];
+
+                    for (m = -el; m <= el; ++m)
+                    {
+                        mmsign = mm >= 0 ? 1.0 : signs[el] * signs[abs(m)];
+                        double elmsign = m >= 0 ? 1.0 : elmmsign;
+                        int ind;
+                        if (real)
+                            so3_sampling_elmn2ind_real(&ind, el, m, n, parameters);
+                        else
+                            so3_sampling_elmn2ind(&ind, el, m, n, parameters);
+                        int mod = ((m-n)%4 + 4)%4;
+                        // Factor which does not depend on the signal.
+                        complex double factor =
+                            exps[mod]
+                            * elnmm_factor
+                            * mmsign * elmsign
+                            * dl[abs(m) + dl_offset + abs(mm)*dl_stride];
+                        const complex double *Gmm = Gmnm + m + m_offset + m_stride*(
+                                                           mm + mm_offset + mm_stride*j);
+
+                        for (k = 0; k < count; ++k)
+                            flmn[k*flmn_dist + ind - flmn_base] += factor * Gmm[k*Gmnm_dist];
+                    }
+                }
+            }
+        }
+
+        so3_plan_gamma_job_help(pending, NULL, 0);
+    }
+}
+
+// Number of harmonic coefficients of a complex or real signal.
+static int so3_plan_flmn_dist(const so3_parameters_t *parameters, int real)
+{
+    so3_parameters_t flmn_parameters = *parameters;
+
+    flmn_parameters.reality = real;
+    return so3_sampling_flmn_size(&flmn_parameters);
+}
+
+/*!
+ * Compute inverse Wigner transform for a complex signal via SSHT.
+ *
+ * \note
+ *   The spin spherical harmonic transforms for all n are computed in a
+ *   single pass over el by a separation of variables, such that each
+ *   Wigner plane is computed only once.
+ *
+ * \param[in]  plan Plan created for the parameters of the transform. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_inverse_via_ssht_real
+ *                  \endlink instead for real signals.
+ * \param[out] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in]  flmn Harmonic coefficients.
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_via_ssht(
+    so3_plan_t *plan,
+    complex double *f, const complex double *flmn
+) {
+    return so3_plan_execute_inverse_via_ssht_batch(plan, f, flmn, 1);
+}
+
+/*!
+ * Compute inverse Wigner transforms for several complex signals via
+ * SSHT.
+ *
+ * \note
+ *   The signals are transformed in groups, whose size is limited by the
+ *   memory required for their intermediate results. Each Wigner plane
+ *   is computed once per group and applied to all of its signals while
+ *   it is in cache.
+ *
+ * \param[in]  plan Plan created for the parameters of the transforms. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_inverse_via_ssht_real_batch
+ *                  \endlink instead for real signals.
+ * \param[out] f Functions on sphere, one after the other. Provide a buffer of
+ *               count times the size given by \link so3_sampling_f_size
+ *               \endlink.
+ * \param[in]  flmn Harmonic coefficients, one set after the other, each of
+ *                  the size given by \link so3_sampling_flmn_size \endlink for
+ *                  complex signals.
+ * \param[in]  count Number of signals.
+ * \retval status \link SO3_SUCCESS \endlink, \link SO3_ERROR_INVALID_ARGUMENT
+ *                \endlink if count is negative, or the error which made the
+ *                setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_via_ssht_batch(
+    so3_plan_t *plan,
+    complex double *f, const complex double *flmn,
+    int count
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L, N;
+    so3_storage_t storage;
+    int steerable;
+    int verbosity;
+
+    // Iterators
+    int k, j;
+    // Number of signals transformed together, and number of the group
+    int group, size, stage;
+    // FFTs over gamma of a group
+    so3_plan_gamma_job_t job, *pending;
+    // Intermediate results
+    complex double *fn, *ftemp;
+    // Stride for several arrays
+    int fn_n_stride;
+    int fftw_n;
+    // Distances between consecutive signals
+    int f_dist, flmn_dist, fn_dist;
+
+    L = parameters->L;
+    N = parameters->N;
+    storage = parameters->storage;
+    verbosity = parameters->verbosity;
+    steerable = parameters->steerable;
+
+    if (count < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    // Print messages depending on verbosity level.
+    if (verbosity > 0) {
+        printf("%sComputing inverse transform using MW sampling with\n", SO3_PROMPT);
+        printf("%sparameters  (L, N, reality) = (%d, %d, FALSE)\n", SO3_PROMPT, L, N);
+        if (verbosity > 1)
+            printf("%sUsing routine so3_core_mw_inverse_via_ssht with storage method %d...\n"
+                    , SO3_PROMPT
+                    , storage);
+    }
+
+    if (!plan->inverse_via_ssht.ready)
+    {
+        // The FFTW planner is not thread-safe.
+        #pragma omp critical (so3_fftw_planner)
+        so3_plan_setup_inverse_via_ssht(plan, f);
+    }
+    group = so3_plan_setup_sov_batch(plan, count, so3_plan_sov_nblocks(parameters, NULL, 0));
+    so3_plan_setup_fn_batch(plan, &plan->inverse_via_ssht.fn, &plan->inverse_via_ssht.batch,
+                            plan->inverse_via_ssht.fn_dist,
+                            count > group ? 2*group : group);
+    if (plan->status != SO3_SUCCESS)
+        return plan->status;
+
+    fn = plan->inverse_via_ssht.fn;
+    ftemp = plan->inverse_via_ssht.ftemp;
+    fn_n_stride = plan->inverse_via_ssht.fn_n_stride;
+    fftw_n = plan->inverse_via_ssht.fftw_n;
+    fn_dist = plan->inverse_via_ssht.fn_dist;
+    f_dist = so3_sampling_f_size(parameters);
+    flmn_dist = so3_plan_flmn_dist(parameters, 0);
+
+    // Consecutive groups use alternate fn blocks, such that the FFTs over
+    // gamma of one group overlap with the separation of variables of the
+    // next one.
+    pending = NULL;
+    for (k = 0, stage = 0; k < count; k += group, ++stage)
+    {
+        complex double *fn_g = fn + (size_t)(stage%2)*group*fn_dist;
+
+        size = MIN(group, count - k);
+
+        // Compute fn(a,b)
+
+        // Blocks for skipped n must be zero.
+        memset(fn_g, 0, (size_t)size*fn_dist * sizeof *fn);
+
+        so3_plan_sov_inverse(plan, fn_g, fn_dist, fftw_n,
+                             flmn + (size_t)k*flmn_dist, flmn_dist, size, 0, NULL, pending);
+        pending = NULL;
+
+        if (steerable)
+        {
+            for (j = 0; j < size; ++j)
+            {
+                so3_plan_gamma_job_init(&job, plan, SO3_PLAN_GAMMA_DFT, ftemp, 0,
+                                        fn_g + (size_t)j*fn_dist, fn_dist, 1);
+                so3_plan_gamma_job_execute(plan, &job);
+                memcpy(f + (size_t)(k+j)*f_dist, ftemp, N*fn_n_stride * sizeof(complex double));
+            }
+        }
+        else
+        {
+            so3_plan_gamma_job_init(&job, plan, SO3_PLAN_GAMMA_DFT, f + (size_t)k*f_dist, f_dist,
+                                    fn_g, fn_dist, size);
+            pending = &job;
+        }
+    }
+    // The FFTs of the last group have nothing to overlap with.
+    if (pending)
+        so3_plan_gamma_job_execute(plan, pending);
+
+    if (verbosity > 0)
+        printf("%sInverse transform computed!\n", SO3_PROMPT);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Compute forward Wigner transform for a complex signal via SSHT.
+ *
+ * \note
+ *   The spin spherical harmonic transforms for all n are computed in a
+ *   single pass over el by a separation of variables, such that each
+ *   Wigner plane is computed only once.
+ *
+ * \param[in]  plan Plan created for the parameters of the transform. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_forward_via_ssht_real
+ *                  \endlink instead for real signals.
+ * \param[out] flmn Harmonic coefficients. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_via_ssht(
+    so3_plan_t *plan,
+    complex double *flmn, const complex double *f
+) {
+    return so3_plan_execute_forward_via_ssht_batch(plan, flmn, f, 1);
+}
+
+/*!
+ * Compute forward Wigner transforms for several complex signals via
+ * SSHT.
+ *
+ * \note
+ *   The signals are transformed in groups, whose size is limited by the
+ *   memory required for their intermediate results. Each Wigner plane
+ *   is computed once per group and applied to all of its signals while
+ *   it is in cache.
+ *
+ * \param[in]  plan Plan created for the parameters of the transforms. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_forward_via_ssht_real_batch
+ *                  \endlink instead for real signals.
+ * \param[out] flmn Harmonic coefficients, one set after the other, each of
+ *                  the size given by \link so3_sampling_flmn_size \endlink for
+ *                  complex signals. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in]  f Functions on sphere, one after the other, each of the size
+ *               given by \link so3_sampling_f_size \endlink.
+ * \param[in]  count Number of signals.
+ * \retval status \link SO3_SUCCESS \endlink, \link SO3_ERROR_INVALID_ARGUMENT
+ *                \endlink if count is negative, or the error which made the
+ *                setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_via_ssht_batch(
+    so3_plan_t *plan,
+    complex double *flmn, const complex double *f,
+    int count
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L, N;
+    so3_storage_t storage;
+    int steerable;
+    int verbosity;
+
+    // Iterators
+    int i, k;
+    // Number of signals transformed together, and number of the group
+    int group, size, stage;
+    // FFTs over gamma of a group
+    so3_plan_gamma_job_t job, *pending;
+    // Intermediate results
+    complex double *fn;
+    // Stride for several arrays
+    int fn_n_stride;
+    // Distances between consecutive signals
+    int f_dist, flmn_dist, fn_dist;
+
+    L = parameters->L;
+    N = parameters->N;
+    storage = parameters->storage;
+    verbosity = parameters->verbosity;
+    steerable = parameters->steerable;
+
+    if (count < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    // Print messages depending on verbosity level.
+    if (verbosity > 0) {
+        printf("%sComputing forward transform using MW sampling with\n", SO3_PROMPT);
+        printf("%sparameters  (L, N, reality) = (%d, %d, FALSE)\n", SO3_PROMPT, L, N);
+        if (verbosity > 1)
+            printf("%sUsing routine so3_core_mw_forward_via_ssht with storage method %d...\n"
+                    , SO3_PROMPT
+                    , storage);
+    }
+
+    if (!plan->forward_via_ssht.ready)
+    {
+        // The FFTW planner is not thread-safe.
+        #pragma omp critical (so3_fftw_planner)
+        so3_plan_setup_forward_via_ssht(plan);
+    }
+    group = so3_plan_setup_sov_batch(plan, count, so3_plan_sov_nblocks(parameters, NULL, 0));
+    so3_plan_setup_fn_batch(plan, &plan->forward_via_ssht.fn, &plan->forward_via_ssht.batch,
+                            plan->forward_via_ssht.fn_dist,
+                            count > group ? 2*group : group);
+    if (plan->status != SO3_SUCCESS)
+        return plan->status;
+
+    fn = plan->forward_via_ssht.fn;
+    fn_n_stride = plan->forward_via_ssht.fn_n_stride;
+    fn_dist = plan->forward_via_ssht.fn_dist;
+    f_dist = so3_sampling_f_size(parameters);
+    flmn_dist = so3_plan_flmn_dist(parameters, 0);
+
+    // Consecutive groups use alternate fn blocks, such that the FFTs over
+    // gamma of the next group overlap with the separation of variables of
+    // the current one.
+    for (k = 0, stage = 0; k < count; k += group, ++stage)
+    {
+        complex double *fn_g = fn + (size_t)(stage%2)*group*fn_dist;
+
+        size = MIN(group, count - k);
+
+        if (steerable)
+        {
+            memset(fn_g, 0, (size_t)size*fn_dist * sizeof *fn);
+
+            // Each thread sums over gamma for its own samples.
+            #pragma omp parallel for num_threads(plan->nthreads) schedule(static)
+            for (i = 0; i < size*fn_n_stride; ++i)
+            {
+                int g, n, offset;
+                int j = i / fn_n_stride, s = i % fn_n_stride;
+                complex double *fn_j = fn_g + (size_t)j*fn_dist;
+                const complex double *f_j = f + (size_t)(k+j)*f_dist;
+
+                for (n = -N+1; n < N; n+=2)
+                {
+                    // The conditional applies the spatial transform, because the fn
+                    // are to be stored in n-order 0, 1, 2, -2, -1
+                    offset = (n < 0 ? n + 2*N-1 : n);
+
+                    for (g = 0; g < N; ++g)
+                    {
+                        double gamma = g * SO3_PI / N;
+                        double weight = 2*SO3_PI/N;
+                        fn_j[offset * fn_n_stride + s] += weight*f_j[g * fn_n_stride + s]*cexp(-I*n*gamma);
+                    }
+                }
+            }
+        }
+        else if (stage == 0)
+        {
+            // The FFTs of the first group have nothing to overlap with.
+            so3_plan_gamma_job_init(&job, plan, SO3_PLAN_GAMMA_DFT_FORWARD, (complex double *)f, f_dist,
+                                    fn_g, fn_dist, size);
+            so3_plan_gamma_job_execute(plan, &job);
+        }
+
+        pending = NULL;
+        if (!steerable && k + group < count)
+        {
+            so3_plan_gamma_job_init(&job, plan, SO3_PLAN_GAMMA_DFT_FORWARD,
+                                    (complex double *)f + (size_t)(k+group)*f_dist, f_dist,
+                                    fn + (size_t)((stage+1)%2)*group*fn_dist, fn_dist,
+                                    MIN(group, count - k - group));
+            pending = &job;
+        }
+
+        so3_plan_sov_forward(plan, flmn + (size_t)k*flmn_dist, flmn_dist,
+                             fn_g, fn_dist, 2*N-1, size, 0, NULL, pending);
+    }
+
+    if (verbosity > 0)
+        printf("%sForward transform computed!\n", SO3_PROMPT);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Compute inverse Wigner transform for a real signal via SSHT.
+ *
+ * \note
+ *   The spin spherical harmonic transforms for all n are computed in a
+ *   single pass over el by a separation of variables, such that each
+ *   Wigner plane is computed only once.
+ *
+ * \param[in]  plan Plan created for the parameters of the transform. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_inverse_via_ssht
+ *                  \endlink instead for complex signals.
+ * \param[out] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in] flmn Harmonic coefficients for n >= 0. Note that for n = 0, these have to
+ *                 respect the symmetry flm0* = (-1)^(m+n)*fl-m0, and hence fl00 has to be real.
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_via_ssht_real(
+    so3_plan_t *plan,
+    double *f, const complex double *flmn
+) {
+    return so3_plan_execute_inverse_via_ssht_real_batch(plan, f, flmn, 1);
+}
+
+/*!
+ * Compute inverse Wigner transforms for several real signals via SSHT.
+ *
+ * \note
+ *   The signals are transformed in groups, whose size is limited by the
+ *   memory required for their intermediate results. Each Wigner plane
+ *   is computed once per group and applied to all of its signals while
+ *   it is in cache.
+ *
+ * \param[in]  plan Plan created for the parameters of the transforms. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_inverse_via_ssht_batch
+ *                  \endlink instead for complex signals.
+ * \param[out] f Functions on sphere, one after the other. Provide a buffer of
+ *               count times the size given by \link so3_sampling_f_size
+ *               \endlink.
+ * \param[in]  flmn Harmonic coefficients for n >= 0, one set after the other,
+ *                  each of the size given by \link so3_sampling_flmn_size
+ *                  \endlink for real signals. Note that for n = 0, these have to
+ *                  respect the symmetry flm0* = (-1)^(m+n)*fl-m0, and hence fl00
+ *                  has to be real.
+ * \param[in]  count Number of signals.
+ * \retval status \link SO3_SUCCESS \endlink, \link SO3_ERROR_INVALID_ARGUMENT
+ *                \endlink if count is negative, or the error which made the
+ *                setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_via_ssht_real_batch(
+    so3_plan_t *plan,
+    double *f, const complex double *flmn,
+    int count
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L, N;
+    so3_storage_t storage;
+    int steerable;
+    int verbosity;
+
+    // Iterators
+    int k, j;
+    // Number of signals transformed together, and number of the group
+    int group, size, stage;
+    // FFTs over gamma of a group
+    so3_plan_gamma_job_t job, *pending;
+    // Intermediate results
+    complex double *fn;
+    double *ftemp;
+    // Stride for several arrays
+    int fn_n_stride;
+    int fftw_n;
+    // Distances between consecutive signals
+    int f_dist, flmn_dist, fn_dist;
+
+    L = parameters->L;
+    N = parameters->N;
+    storage = parameters->storage;
+    verbosity = parameters->verbosity;
+    steerable = parameters->steerable;
+
+    if (count < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    // Print messages depending on verbosity level.
+    if (verbosity > 0) {
+        printf("%sComputing inverse transform using MW sampling with\n", SO3_PROMPT);
+        printf("%sparameters  (L, N, reality) = (%d, %d, FALSE)\n", SO3_PROMPT, L, N);
+        if (verbosity > 1)
+            printf("%sUsing routine so3_core_mw_inverse_via_ssht_real with storage method %d...\n"
+                    , SO3_PROMPT
+                    , storage);
+    }
+
+    if (!plan->inverse_via_ssht_real.ready)
+    {
+        // The FFTW planner is not thread-safe.
+        #pragma omp critical (so3_fftw_planner)
+        so3_plan_setup_inverse_via_ssht_real(plan, f);
+    }
+    group = so3_plan_setup_sov_batch(plan, count, so3_plan_sov_nblocks(parameters, NULL, 1));
+    so3_plan_setup_fn_batch(plan, &plan->inverse_via_ssht_real.fn, &plan->inverse_via_ssht_real.batch,
+                            plan->inverse_via_ssht_real.fn_dist,
+                            count > group ? 2*group : group);
+    if (plan->status != SO3_SUCCESS)
+        return plan->status;
+
+    fn = plan->inverse_via_ssht_real.fn;
+    ftemp = plan->inverse_via_ssht_real.ftemp;
+    fn_n_stride = plan->inverse_via_ssht_real.fn_n_stride;
+    fftw_n = plan->inverse_via_ssht_real.fftw_n;
+    fn_dist = plan->inverse_via_ssht_real.fn_dist;
+    f_dist = so3_sampling_f_size(parameters);
+    flmn_dist = so3_plan_flmn_dist(parameters, 1);
+
+    // Consecutive groups use alternate fn blocks, such that the FFTs over
+    // gamma of one group overlap with the separation of variables of the
+    // next one.
+    pending = NULL;
+    for (k = 0, stage = 0; k < count; k += group, ++stage)
+    {
+        complex double *fn_g = fn + (size_t)(stage%2)*group*fn_dist;
+
+        size = MIN(group, count - k);
+
+        // Compute fn(a,b)
+
+        // Blocks for skipped n must be zero (the c2r FFT destroys its input).
+        memset(fn_g, 0, (size_t)size*fn_dist * sizeof *fn);
+
+        so3_plan_sov_inverse(plan, fn_g, fn_dist, fftw_n,
+                             flmn + (size_t)k*flmn_dist, flmn_dist, size, 1, NULL, pending);
+        pending = NULL;
+
+        if (steerable)
+        {
+            for (j = 0; j < size; ++j)
+            {
+                so3_plan_gamma_job_init(&job, plan, SO3_PLAN_GAMMA_C2R, ftemp, 0,
+                                        fn_g + (size_t)j*fn_dist, fn_dist, 1);
+                so3_plan_gamma_job_execute(plan, &job);
+                memcpy(f + (size_t)(k+j)*f_dist, ftemp, N*fn_n_stride * sizeof *f);
+            }
+        }
+        else
+        {
+            so3_plan_gamma_job_init(&job, plan, SO3_PLAN_GAMMA_C2R, f + (size_t)k*f_dist, f_dist,
+                                    fn_g, fn_dist, size);
+            pending = &job;
+        }
+    }
+    // The FFTs of the last group have nothing to overlap with.
+    if (pending)
+        so3_plan_gamma_job_execute(plan, pending);
+
+    if (verbosity > 0)
+        printf("%sInverse transform computed!\n", SO3_PROMPT);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Compute forward Wigner transform for a real signal via SSHT.
+ *
+ * \note
+ *   The spin spherical harmonic transforms for all n are computed in a
+ *   single pass over el by a separation of variables, such that each
+ *   Wigner plane is computed only once.
+ *
+ * \param[in]  plan Plan created for the parameters of the transform. The \link
+ *                  so3_parameters_t::reality reality \endlink flag
+ *                  is ignored. Use \link so3_plan_execute_forward_via_ssht
+ *                  \endlink instead for complex signals.
+ * \param[out] flmn Harmonic coefficients. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_via_ssht_real(
+    so3_plan_t *plan,
+    complex double *flmn, const double *f
+) {
+    return so3_plan_execute_forward_via_ssht_real_batch(plan, flmn, f, 1);
+}
+
+/*!
+ * Compute forward Wigner transforms for several real signals via SSHT.
+ *
+ * \note
+ *   The signals are transformed in groups, whose size is limited by the
+ *   memory required for their intermediate results. Each Wigner plane
+ *   is computed once per group and applied to all of its signals while
+ *   it is in cache.
+ *
+ * \param[in]  plan Plan created for the parameters of the transforms. The \link
+ *                  so3_parameters_t::reality reality \endlink flag
+ *                  is ignored. Use \link so3_plan_execute_forward_via_ssht_batch
+ *                  \endlink instead for complex signals.
+ * \param[out] flmn Harmonic coefficients for n >= 0, one set after the other,
+ *                  each of the size given by \link so3_sampling_flmn_size
+ *                  \endlink for real signals. If \link so3_parameters_t::n_mode
+ *                  n_mode \endlink is different from \link SO3_N_MODE_ALL
+ *                  \endlink, this array has to be nulled before being past to
+ *                  the function.
+ * \param[in]  f Functions on sphere, one after the other, each of the size
+ *               given by \link so3_sampling_f_size \endlink.
+ * \param[in]  count Number of signals.
+ * \retval status \link SO3_SUCCESS \endlink, \link SO3_ERROR_INVALID_ARGUMENT
+ *                \endlink if count is negative, or the error which made the
+ *                setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_via_ssht_real_batch(
+    so3_plan_t *plan,
+    complex double *flmn, const double *f,
+    int count
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L, N;
+    so3_storage_t storage;
+    int steerable;
+    int verbosity;
+
+    // Iterators
+    int i, k;
+    // Number of signals transformed together, and number of the group
+    int group, size, stage;
+    // FFTs over gamma of a group
+    so3_plan_gamma_job_t job, *pending;
+    // Intermediate results
+    complex double *fn;
+    // Stride for several arrays
+    int fn_n_stride;
+    // Distances between consecutive signals
+    int f_dist, flmn_dist, fn_dist;
+
+    L = parameters->L;
+    N = parameters->N;
+    storage = parameters->storage;
+    steerable = parameters->steerable;
+    verbosity = parameters->verbosity;
+
+    if (count < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    // Print messages depending on verbosity level.
+    if (verbosity > 0) {
+        printf("%sComputing forward transform using MW sampling with\n", SO3_PROMPT);
+        printf("%sparameters  (L, N, reality) = (%d, %d, FALSE)\n", SO3_PROMPT, L, N);
+        if (verbosity > 1)
+            printf("%sUsing routine so3_core_mw_forward_via_ssht_real with storage method %d...\n"
+                    , SO3_PROMPT
+                    , storage);
+    }
+
+    if (!plan->forward_via_ssht_real.ready)
+    {
+        // The FFTW planner is not thread-safe.
+        #pragma omp critical (so3_fftw_planner)
+        so3_plan_setup_forward_via_ssht_real(plan);
+    }
+    group = so3_plan_setup_sov_batch(plan, count, so3_plan_sov_nblocks(parameters, NULL, 1));
+    so3_plan_setup_fn_batch(plan, &plan->forward_via_ssht_real.fn, &plan->forward_via_ssht_real.batch,
+                            plan->forward_via_ssht_real.fn_dist,
+                            count > group ? 2*group : group);
+    if (plan->status != SO3_SUCCESS)
+        return plan->status;
+
+    fn = plan->forward_via_ssht_real.fn;
+    fn_n_stride = plan->forward_via_ssht_real.fn_n_stride;
+    fn_dist = plan->forward_via_ssht_real.fn_dist;
+    f_dist = so3_sampling_f_size(parameters);
+    flmn_dist = so3_plan_flmn_dist(parameters, 1);
+
+    // Consecutive groups use alternate fn blocks, such that the FFTs over
+    // gamma of the next group overlap with the separation of variables of
+    // the current one.
+    for (k = 0, stage = 0; k < count; k += group, ++stage)
+    {
+        complex double *fn_g = fn + (size_t)(stage%2)*group*fn_dist;
+
+        size = MIN(group, count - k);
+
+        if (steerable)
+        {
+            memset(fn_g, 0, (size_t)size*fn_dist * sizeof *fn);
+
+            // Each thread sums over gamma for its own samples.
+            #pragma omp parallel for num_threads(plan->nthreads) schedule(static)
+            for (i = 0; i < size*fn_n_stride; ++i)
+            {
+                int g, n, offset;
+                int j = i / fn_n_stride, s = i % fn_n_stride;
+                complex double *fn_j = fn_g + (size_t)j*fn_dist;
+                const double *f_j = f + (size_t)(k+j)*f_dist;
+
+                for (n = -N+1; n < N; n+=2)
+                {
+                    // The conditional applies the spatial transform, because the fn
+                    // are to be stored in n-order 0, 1, 2, -2, -1
+                    offset = (n < 0 ? n + 2*N-1 : n);
+
+                    for (g = 0; g < N; ++g)
+                    {
+                        double gamma = g * SO3_PI / N;
+                        double weight = 2*SO3_PI/N;
+                        fn_j[offset * fn_n_stride + s] += weight*f_j[g * fn_n_stride + s]*cexp(-I*n*gamma);
+                    }
+                }
+            }
+        }
+        else if (stage == 0)
+        {
+            // The FFTs of the first group have nothing to overlap with.
+            so3_plan_gamma_job_init(&job, plan, SO3_PLAN_GAMMA_R2C, (double *)f, f_dist,
+                                    fn_g, fn_dist, size);
+            so3_plan_gamma_job_execute(plan, &job);
+        }
+
+        pending = NULL;
+        if (!steerable && k + group < count)
+        {
+            so3_plan_gamma_job_init(&job, plan, SO3_PLAN_GAMMA_R2C,
+                                    (double *)f + (size_t)(k+group)*f_dist, f_dist,
+                                    fn + (size_t)((stage+1)%2)*group*fn_dist, fn_dist,
+                                    MIN(group, count - k - group));
+            pending = &job;
+        }
+
+        so3_plan_sov_forward(plan, flmn + (size_t)k*flmn_dist, flmn_dist,
+                             fn_g, fn_dist, 2*N-1, size, 1, NULL, pending);
+    }
+
+    if (verbosity > 0)
+        printf("%sForward transform computed!\n", SO3_PROMPT);
+
+    return SO3_SUCCESS;
+}
+
+//============================================================================
+// Direct transforms
+//============================================================================
+
+// Direct inverse transforms of count complex signals. Either f and
+// flmn are given, or the separate real and imaginary parts f_re, f_im
+// and flmn_re, flmn_im of a single signal, with the other pointers set
+// to NULL. The split layout is converted where the coefficients are
+// gathered and where the signal is extracted from the extended torus,
+// so it needs no extra passes over the data. The Fmnm' of a group of
+// signals are accumulated in a single pass over el, such that each
+// Wigner plane is applied to all signals of the group.
+static so3_status_t so3_plan_inverse_direct(
+    so3_plan_t *plan,
+    complex double *f, double *f_re, double *f_im,
+    const complex double *flmn, const double *flmn_re, const double *flmn_im,
+    int count
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L0, L, N;
+    so3_storage_t storage;
+    so3_n_mode_t n_mode;
+    int verbosity;
+
+    L0 = parameters->L0;
+    L = parameters->L;
+    N = parameters->N;
+    storage = parameters->storage;
+    // TODO: Add optimisations for all n-modes.
+    n_mode = parameters->n_mode;
+    verbosity = parameters->verbosity;
+
+    if (count < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    // Print messages depending on verbosity level.
+    if (verbosity > 0)
+    {
+        printf("%sComputing inverse transform using MW sampling with\n", SO3_PROMPT);
+        printf("%sparameters  (L, N, reality) = (%d, %d, FALSE)\n", SO3_PROMPT, L, N);
+        if (verbosity > 1)
+            printf("%sUsing routine so3_core_mw_inverse_direct with storage method %d...\n"
+                    , SO3_PROMPT
+                    , storage);
+    }
+
+    // Iterators
+    int el, m, n, mm; // mm for m'
+    int k, j;
+    // Number of signals transformed together
+    int group, size;
+
+    if (!plan->inverse_direct.ready)
+    {
+        // The FFTW planner is not thread-safe.
+        #pragma omp critical (so3_fftw_planner)
+        so3_plan_setup_inverse_direct(plan);
+    }
+    group = so3_plan_setup_direct_batch(plan, &plan->inverse_direct.Fmnm, &plan->inverse_direct.batch,
+                                        L, (size_t)(2*L-1)*(2*N-1),
+                                        &plan->inverse_direct.mn_factors, (size_t)(2*L-1)*(2*N-1),
+                                        count);
+    if (plan->status != SO3_SUCCESS)
+        return plan->status;
+
+    double *signs = plan->signs;
+    complex double *exps = plan->exps;
+
+    // Fmnm' of the signals of a group. Each slab of m' holds the blocks
+    // of all of them.
+    // TODO: Currently m is fastest-varying, then n, then m'.
+    // Should this order be changed to m-m'-n?
+    complex double *Fmnm = plan->inverse_direct.Fmnm;
+    int batch = plan->inverse_direct.batch;
+    int m_offset = L-1;
+    int m_stride = 2*L-1;
+    int n_offset = N-1;
+    int n_stride = 2*N-1;
+    int mm_offset = L-1;
+    int mm_stride = 2*L-1;
+
+    // Distances between consecutive signals
+    int f_dist = so3_sampling_f_size(parameters);
+    int flmn_dist = so3_plan_flmn_dist(parameters, 0);
+
+    int n_start, n_stop, n_inc;
+
+    const double *dl;
+    int dl_offset, dl_stride;
+
+    complex double *mn_factors = plan->inverse_direct.mn_factors;
+
+    complex double *fext = plan->inverse_direct.fext;
+    complex double *expsmm = plan->inverse_direct.expsmm;
+    int a,b,g;
+    int a_stride = 2*L-1;
+    int b_ext_stride = 2*L-1;
+    int b_stride = L;
+
+    // Range of n of the extended torus.
+    switch (n_mode)
+    {
+    case SO3_N_MODE_ALL:
+    case SO3_N_MODE_L:
+        n_start = -N+1;
+        n_stop  =  N-1;
+        n_inc = 1;
+        break;
+    case SO3_N_MODE_EVEN:
+        n_start = ((N-1) % 2 == 0) ? -N+1 : -N+2;
+        n_stop  = ((N-1) % 2 == 0) ?  N-1 :  N-2;
+        n_inc = 2;
+        break;
+    case SO3_N_MODE_ODD:
+        n_start = ((N-1) % 2 != 0) ? -N+1 : -N+2;
+        n_stop  = ((N-1) % 2 != 0) ?  N-1 :  N-2;
+        n_inc = 2;
+        break;
+    case SO3_N_MODE_MAXIMUM:
+        n_start = -N+1;
+        n_stop  =  N-1;
+        n_inc = MAX(1,2*N - 2);
+        break;
+    default:
+        SO3_ERROR_GENERIC("Invalid n-mode.");
+    }
+
+    for (k = 0; k < count; k += group)
+    {
+        size = MIN(group, count - k);
+
+        // Compute Fmnm'
+
+        // TODO: SSHT starts this loop from MAX(L0, abs(spin)).
+        // Can we use a similar optimisation? el can probably
+        // be limited by n, but then we'd need to switch the
+        // loop order, which means we'd have to recompute the
+        // Wigner plane for each n. That seems wrong?
+        // Each Wigner plane is computed by one thread and then applied by
+        // all threads, which own disjoint slabs of Fmnm' for different m',
+        // to all signals of the group.
+        #pragma omp parallel num_threads(plan->nthreads) \
+                private(el, m, n, mm, j, n_start, n_stop, n_inc)
+        {
+            #pragma omp for schedule(static)
+            for (mm = 0; mm < L; ++mm)
+                memset(Fmnm + (size_t)m_stride*n_stride*batch*mm, 0,
+                       (size_t)size*m_stride*n_stride * sizeof *Fmnm);
+
+            for (el = L0; el <= L-1; ++el)
+            {
+                // Compute Wigner plane.
+                #pragma omp single
+                dl = so3_plan_get_wigner_plane(plan, el, &dl_offset, &dl_stride);
+
+                // Compute Fmnm' contribution for current el.
+
+                // Factor which depends only on el.
+                double elfactor = (2.0*el+1.0)/(8.0*SO3_PI*SO3_PI);
+
+                switch (n_mode)
+                {
+                case SO3_N_MODE_ALL:
+                    n_start = MAX(-N+1,-el);
+                    n_stop  = MIN( N-1, el);
+                    n_inc = 1;
+                    break;
+                case SO3_N_MODE_EVEN:
+                    n_start = MAX(-N+1,-el);
+                    n_start += (-n_start)%2;
+                    n_stop  = MIN( N-1, el);
+                    n_stop  -=  n_stop%2;
+                    n_inc = 2;
+                    break;
+                case SO3_N_MODE_ODD:
+                    n_start = MAX(-N+1,-el);
+                    n_start += 1+n_start%2;
+                    n_stop  = MIN( N-1, el);
+                    n_stop  -= 1-n_stop%2;
+                    n_inc = 2;
+                    break;
+                case SO3_N_MODE_MAXIMUM:
+                    if (el < N-1)
+                        continue;
+                    n_start = -N+1;
+                    n_stop  =  N-1;
+                    n_inc = MAX(1,2*N-2);
+                    break;
+                case SO3_N_MODE_L:
+                    if (el >= N)
+                        continue;
+                    n_start = -el;
+                    n_stop  =  el;
+                    n_inc = MAX(1,2*el);
+                    break;
+                default:
+                    SO3_ERROR_GENERIC("Invalid n-mode.");
+                }
+
+                // Factors which do not depend on m'.
+                #pragma omp for schedule(static)
+                for (n = n_start; n <= n_stop; n += n_inc)
+                    for (m = -el; m <= el; ++m)
+                    {
+                        int ind;
+                        so3_sampling_elmn2ind(&ind, el, m, n, parameters);
+                        int mod = ((n-m)%4 + 4)%4;
+                        for (j = 0; j < size; ++j)
+                        {
+                            size_t jind = (size_t)(k+j)*flmn_dist + ind;
+                            complex double coefficient = flmn
+                                                         ? flmn[jind]
+                                                         : flmn_re[jind] + I*flmn_im[jind];
+                            mn_factors[m + m_offset + m_stride*(
+                                       n + n_offset + n_stride*(
+                                       j))] =
+                                coefficient * exps[mod];
+                        }
+                    }
+
+                #pragma omp for schedule(static)
+                for (mm = 0; mm <= el; ++mm)
+                {
+                    // These signs are needed for the symmetry relations of
+                    // Wigner symbols.
+                    double elmmsign = signs[el] * signs[mm];
+
+                    // TODO: If the conditional for elnsign is a bottleneck
+                    // this loop can be split up just like the inner loop.
+                    for (n = n_start; n <= n_stop; n += n_inc)
+                    {
+                        double elnsign = n >= 0 ? 1.0 : elmmsign;
+                        // Factor which does not depend on m.
+                        double elnmm_factor = elfactor * elnsign
+                                              * dl[abs(n) + dl_offset + mm*dl_stride];
+                        for (j = 0; j < size; ++j)
+                            so3_simd_accumulate_fmnm(
+                                Fmnm + m_offset + m_stride*(
+                                       n + n_offset + n_stride*(
+                                       j + batch*(
+                                       mm))),
+                                mn_factors + m_offset + m_stride*(
+                                             n + n_offset + n_stride*(
+                                             j)),
+                                dl + dl_offset + mm*dl_stride,
+                                el, elnmm_factor * elmmsign, elnmm_factor);
+                    }
+                }
+            }
+
+        }
+
+        for (j = 0; j < size; ++j)
+        {
+            size_t f_offset = (size_t)(k+j)*f_dist;
+
+            // Fill the extended torus from Fmnm' in a single pass, row by
+            // row: apply the phase modulation to account for the sampling
+            // offset and the spatial shift, and obtain the rows of negative
+            // m' from those of m' > 0 by symmetry,
+            // Fmnm'(-m') = (-1)^(m+n) Fmnm'(m'). The sign of m is part of
+            // the phases of the row, which are computed once for all n.
+            // The rows of skipped n are zeroed, so every element of fext
+            // is written exactly once.
+            #pragma omp parallel for num_threads(plan->nthreads) schedule(static) private(m, n)
+            for (mm = -L+1; mm <= L-1; ++mm)
+            {
+                complex double *mm_phases = plan->inverse_direct.mm_phases
+                                            + omp_get_thread_num()*m_stride;
+                complex double mmfactor = expsmm[mm + mm_offset];
+                int mm_shift = mm < 0 ? 2*L-1 : 0;
+
+                if (mm < 0)
+                    for (m = -L+1; m <= L-1; ++m)
+                        mm_phases[m + m_offset] = mmfactor * signs[abs(m)%2];
+
+                for (n = -N+1; n <= N-1; ++n)
+                {
+                    int n_shift = n < 0 ? 2*N-1 : 0;
+                    complex double *ext = fext + m_stride*(
+                                                 mm + mm_shift + mm_stride*(
+                                                 n + n_shift));
+                    const complex double *Fm = Fmnm + m_offset + m_stride*(
+                                                      n + n_offset + n_stride*(
+                                                      j + batch*(
+                                                      abs(mm))));
+
+                    if (n < n_start || n > n_stop || (n - n_start) % n_inc)
+                        memset(ext, 0, m_stride * sizeof *ext);
+                    else if (mm >= 0)
+                    {
+                        so3_simd_scale(ext, Fm, mmfactor, L);
+                        so3_simd_scale(ext + L, Fm - L+1, mmfactor, L-1);
+                    }
+                    else
+                    {
+                        double nsign = signs[abs(n)%2];
+
+                        so3_simd_modulate(ext, Fm, mm_phases + m_offset, nsign, L);
+                        so3_simd_modulate(ext + L, Fm - L+1, mm_phases, nsign, L-1);
+                    }
+                }
+            }
+
+            // Perform 3D FFT.
+            fftw_execute(plan->inverse_direct.plan);
+
+            // Extract f from the extended torus.
+            #pragma omp parallel for num_threads(plan->nthreads) private(a, b)
+            for (g = 0; g < 2*N-1; ++g)
+                for (b = 0; b < L; ++b)
+                {
+                    const complex double *row = fext + a_stride*(
+                                                       b + b_ext_stride*(
+                                                       g));
+                    size_t offset = f_offset + a_stride*(
+                                               b + b_stride*(
+                                               g));
+
+                    if (f)
+                        memcpy(f + offset, row, a_stride * sizeof *f);
+                    else
+                        for (a = 0; a < 2*L-1; ++a)
+                        {
+                            f_re[offset + a] = creal(row[a]);
+                            f_im[offset + a] = cimag(row[a]);
+                        }
+                }
+        }
+    }
+
+    if (verbosity > 0)
+        printf("%sInverse transform computed!\n", SO3_PROMPT);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Compute inverse Wigner transform for a complex signal directly (without using
+ * SSHT).
+ *
+ * \param[in]  plan Plan created for the parameters of the transform. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_inverse_direct_real
+ *                  \endlink instead for real signals.
+ * \param[out] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in]  flmn Harmonic coefficients.
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_direct(
+    so3_plan_t *plan,
+    complex double *f, const complex double *flmn
+) {
+    return so3_plan_inverse_direct(plan, f, NULL, NULL, flmn, NULL, NULL, 1);
+}
+
+/*!
+ * Compute inverse Wigner transforms for several complex signals directly
+ * (without using SSHT).
+ *
+ * \note
+ *   The signals are transformed in groups, whose size is limited by the
+ *   memory required for their Fmnm'. Each Wigner plane is computed once
+ *   per group and applied to all of its signals while it is in cache.
+ *
+ * \param[in]  plan Plan created for the parameters of the transforms. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_inverse_direct_real_batch
+ *                  \endlink instead for real signals.
+ * \param[out] f Functions on sphere, one after the other. Provide a buffer of
+ *               count times the size (2*L-1)*L*(2*N-1).
+ * \param[in]  flmn Harmonic coefficients, one set after the other, each of
+ *                  the size given by \link so3_sampling_flmn_size \endlink for
+ *                  complex signals.
+ * \param[in]  count Number of signals.
+ * \retval status \link SO3_SUCCESS \endlink, \link SO3_ERROR_INVALID_ARGUMENT
+ *                \endlink if count is negative, or the error which made the
+ *                setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_direct_batch(
+    so3_plan_t *plan,
+    complex double *f, const complex double *flmn,
+    int count
+) {
+    return so3_plan_inverse_direct(plan, f, NULL, NULL, flmn, NULL, NULL, count);
+}
+
+/*!
+ * Compute inverse Wigner transform for a complex signal directly, with
+ * the signal and the coefficients stored as separate arrays of real and
+ * imaginary parts (split layout), e.g. as held by MATLAB.
+ *
+ * \param[in]  plan Plan created for the parameters of the transform.
+ * \param[out] f_re Real part of the function on sphere. Provide a buffer
+ *                  of size (2*L-1)*L*(2*N-1).
+ * \param[out] f_im Imaginary part of the function on sphere, of the same
+ *                  size.
+ * \param[in]  flmn_re Real parts of the harmonic coefficients.
+ * \param[in]  flmn_im Imaginary parts of the harmonic coefficients.
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_direct_split(
+    so3_plan_t *plan,
+    double *f_re, double *f_im,
+    const double *flmn_re, const double *flmn_im
+) {
+    return so3_plan_inverse_direct(plan, NULL, f_re, f_im, NULL, flmn_re, flmn_im, 1);
+}
+
+// Direct forward transforms of count complex signals. Either flmn and
+// f are given, or the separate real and imaginary parts flmn_re,
+// flmn_im and f_re, f_im of a single signal, with the other pointers set
+// to NULL. The split layout is converted where the signal is copied into
+// the FFT buffers and where the coefficients are accumulated. The Gmnm'
+// of a group of signals are computed one after the other, and then
+// accumulated in a single pass over el, such that each Wigner plane is
+// applied to all signals of the group.
+static so3_status_t so3_plan_forward_direct(
+    so3_plan_t *plan,
+    complex double *flmn, double *flmn_re, double *flmn_im,
+    const complex double *f, const double *f_re, const double *f_im,
+    int count
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L0, L, N;
+    so3_storage_t storage;
+    so3_n_mode_t n_mode;
+    int verbosity;
+
+    L0 = parameters->L0;
+    L = parameters->L;
+    N = parameters->N;
+    storage = parameters->storage;
+    // TODO: Add optimisations for all n-modes.
+    n_mode = parameters->n_mode;
+    verbosity = parameters->verbosity;
+
+    if (count < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    // Print messages depending on verbosity level.
+    if (verbosity > 0) {
+        printf("%sComputing forward transform using MW sampling with\n", SO3_PROMPT);
+        printf("%sparameters  (L, N, reality) = (%d, %d, FALSE)\n", SO3_PROMPT, L, N);
+        if (verbosity > 1)
+            printf("%sUsing routine so3_core_mw_forward_direct with storage method %d...\n"
+                    , SO3_PROMPT
+                    , storage);
+    }
+
+    int m_stride = 2*L-1;
+    int m_offset = L-1;
+    // unused: int n_stride = 2*N-1;
+    int n_offset = N-1;
+    int mm_stride = 2*L-1;
+    int mm_offset = L-1;
+    int a_stride = 2*L-1;
+    int b_stride = L;
+    int bext_stride = 2*L-1;
+    // unused: int g_stride = 2*N-1;
+
+    int n_start, n_stop, n_inc;
+
+    switch (n_mode)
+    {
+    case SO3_N_MODE_ALL:
+    case SO3_N_MODE_L:
+        n_start = -N+1;
+        n_stop  =  N-1;
+        n_inc = 1;
+        break;
+    case SO3_N_MODE_EVEN:
+        n_start = ((N-1) % 2 == 0) ? -N+1 : -N+2;
+        n_stop  = ((N-1) % 2 == 0) ?  N-1 :  N-2;
+        n_inc = 2;
+        break;
+    case SO3_N_MODE_ODD:
+        n_start = ((N-1) % 2 != 0) ? -N+1 : -N+2;
+        n_stop  = ((N-1) % 2 != 0) ?  N-1 :  N-2;
+        n_inc = 2;
+        break;
+    case SO3_N_MODE_MAXIMUM:
+        n_start = -N+1;
+        n_stop  =  N-1;
+        n_inc = MAX(1,2*N - 2);
+        break;
+    default:
+        SO3_ERROR_GENERIC("Invalid n-mode.");
+    }
+
+    int k, j;
+    // Number of signals transformed together
+    int group, size;
+
+    if (!plan->forward_direct.ready)
+    {
+        // The FFTW planner is not thread-safe.
+        #pragma omp critical (so3_fftw_planner)
+        so3_plan_setup_forward_direct(plan);
+    }
+    group = so3_plan_setup_direct_batch(plan, &plan->forward_direct.Gmnm, &plan->forward_direct.batch,
+                                        2*N-1, (size_t)(2*L-1)*(2*L-1), NULL, 0, count);
+    if (plan->status != SO3_SUCCESS)
+        return plan->status;
+
+    double *signs = plan->signs;
+    complex double *phases = plan->forward_direct.phases;
+    complex double *expsmm = plan->forward_direct.expsmm;
+
+    int el, m, n, mm; // mm is for m'
+
+    // Gmnm' of the signals of a group. Each slab of n holds the blocks
+    // of all of them.
+    complex double *Gmnm = plan->forward_direct.Gmnm;
+    int batch = plan->forward_direct.batch;
+
+    // Distances between consecutive signals
+    int f_dist = so3_sampling_f_size(parameters);
+    int flmn_dist = so3_plan_flmn_dist(parameters, 0);
+
+    double norm_factor = 1.0/(2.0*L-1.0)/(2.0*N-1.0);
+
+    complex double *Fmnm = plan->forward_direct.Fmnm;
+    int b, g;
+    int w_dist = (2*L-1)*(4*L-3);
+    int el_first, el_count, first, last;
+
+    for (k = 0; k < count; k += group)
+    {
+        size = MIN(group, count - k);
+
+        for (j = 0; j < size; ++j)
+        {
+            size_t f_offset = (size_t)(k+j)*f_dist;
+
+            // Compute Fourier transform over alpha and gamma, i.e. compute Fmn(b).
+            // Each thread uses its own slice of inout, for the FFTs over alpha
+            // and gamma as well as for those over beta.
+            complex double *Fmnb = plan->forward_direct.Fmnb;
+            int inout_dist = (2*L-1)*(2*N-1);
+
+            #pragma omp parallel for num_threads(plan->nthreads) private(g, m, n)
+            for (b = 0; b < L; ++b)
+            {
+                complex double *inout = plan->forward_direct.inout
+                                        + omp_get_thread_num()*inout_dist;
+
+                // TODO: This memcpy loop could probably be avoided by using
+                // a more elaborate FFTW plan which performs the FFT directly
+                // over the 1st and 3rd dimensions of f.
+                for (g = 0; g < 2*N-1; ++g)
+                {
+                    size_t offset = f_offset + a_stride*(
+                                               b + b_stride*(
+                                               g));
+                    int a;
+
+                    if (f)
+                        memcpy(inout + g*a_stride, f + offset, a_stride*sizeof(*f));
+                    else
+                        for (a = 0; a < 2*L-1; ++a)
+                            inout[a + g*a_stride] = f_re[offset + a] + I*f_im[offset + a];
+                }
+                fftw_execute_dft(plan->forward_direct.plan_alpha_gamma, inout, inout);
+
+                // Apply spatial shift and normalisation factor
+                for (n = n_start; n <= n_stop; n += n_inc)
+                {
+                    int n_shift = n < 0 ? 2*N-1 : 0;
+                    for (m = -L+1; m <= L-1; ++m)
+                    {
+                        int m_shift = m < 0 ? 2*L-1 : 0;
+                        Fmnb[b + bext_stride*(
+                             m + m_offset + m_stride*(
+                             n + n_offset))] =
+                            inout[m + m_shift + m_stride*(
+                                  n + n_shift)] * norm_factor;
+                    }
+                }
+            }
+
+            // Extend Fmnb periodically.
+            #pragma omp parallel for num_threads(plan->nthreads) private(m, b)
+            for (n = n_start; n <= n_stop; n += n_inc)
+                for (m = -L+1; m <= L-1; ++m)
+                {
+                    int signmn = signs[abs(m+n)%2];
+                    for (b = L; b < 2*L-1; ++b)
+                        Fmnb[b + bext_stride*(
+                             m + m_offset + m_stride*(
+                             n + n_offset))] =
+                            signmn
+                            * Fmnb[(2*L-2-b) + bext_stride*(
+                                   m + m_offset + m_stride*(
+                                   n + n_offset))];
+                }
+
+
+            // Compute Fourier transform over beta, i.e. compute Fmnm'.
+            #pragma omp parallel for num_threads(plan->nthreads) private(m)
+            for (n = n_start; n <= n_stop; n += n_inc)
+                for (m = -L+1; m <= L-1; ++m)
+                {
+                    complex double *inout = plan->forward_direct.inout
+                                            + omp_get_thread_num()*inout_dist;
+
+                    memcpy(inout,
+                           Fmnb + 0 + bext_stride*(
+                                  m + m_offset + m_stride*(
+                                  n + n_offset)),
+                           bext_stride*sizeof(*Fmnb));
+                    fftw_execute_dft(plan->forward_direct.plan_beta, inout, inout);
+
+                    // Apply spatial shift, normalisation factor and phase
+                    // modulation to account for sampling offset.
+                    complex double *Fmm = Fmnm + mm_offset + mm_stride*(
+                                                 m + m_offset + m_stride*(
+                                                 n + n_offset));
+                    so3_simd_modulate(Fmm, inout, expsmm + mm_offset, 1.0/(2.0*L-1.0), L);
+                    so3_simd_modulate(Fmm - L+1, inout + L, expsmm, 1.0/(2.0*L-1.0), L-1);
+                }
+
+            // Compute Gmnm' by convolution implemented as product in real space.
+            #pragma omp parallel for num_threads(plan->nthreads)
+            for (n = n_start; n <= n_stop; n += n_inc)
+                so3_plan_weight_convolution(
+                    plan, plan->weights.inout + omp_get_thread_num()*w_dist,
+                    Gmnm + m_stride*mm_stride*(j + batch*(n + n_offset)), 1, m_stride,
+                    Fmnm + mm_stride*m_stride*(n + n_offset), mm_stride, 1);
+        }
+
+        // Compute flmn.
+        #pragma omp parallel for num_threads(plan->nthreads) private(el, m, j)
+        for (n = -N+1; n <= N-1; ++n)
+            for (el = abs(n); el < L; ++el)
+                for (m = -el; m <= el; ++m)
+                {
+                    int ind;
+                    so3_sampling_elmn2ind(&ind, el, m, n, parameters);
+                    for (j = 0; j < size; ++j)
+                        if (flmn)
+                            flmn[(size_t)(k+j)*flmn_dist + ind] = 0.0;
+                        else
+                            flmn_re[ind] = flmn_im[ind] = 0.0;
+                }
+
+        // The el range is split across threads by the work-stealing
+        // scheduler, according to the cost of each el, and each thread
+        // accumulates the coefficients of its own el. The Wigner planes are
+        // obtained in blocks by a single thread (which advances the
+        // recursion), or all at once if they are read from a cache. Each
+        // row of a plane is applied to all signals of the group.
+        #pragma omp parallel num_threads(plan->nthreads) \
+                private(el, m, n, mm, j, n_start, n_stop, n_inc, el_first, el_count, first, last)
+        {
+            int thread = omp_get_thread_num();
+
+            for (el_first = L0; el_first < L; el_first += el_count)
+            {
+                #pragma omp single copyprivate(el_count)
+                {
+                    double *cost;
+
+                    el_count = so3_plan_get_wigner_planes(plan, el_first, L);
+                    cost = so3_schedule_costs(plan->schedule, el_count);
+                    for (el = el_first; el < el_first + el_count; ++el)
+                        cost[el - el_first] = so3_plan_direct_el_cost(parameters, el, 0);
+                    so3_schedule_partition(plan->schedule);
+                }
+
+                while (so3_schedule_next(plan->schedule, thread, &first, &last))
+                {
+                    for (el = el_first + first; el < el_first + last; ++el)
+                    {
+                        // Wigner plane of the current el.
+                        const double *dl = plan->dl_block.planes[el - el_first];
+                        int dl_offset = plan->dl_block.offsets[el - el_first];
+                        int dl_stride = plan->dl_block.strides[el - el_first];
+
+                        // Compute flmn for current el.
+
+                        switch (n_mode)
+                        {
+                        case SO3_N_MODE_ALL:
+                            n_start = MAX(-N+1,-el);
+                            n_stop  = MIN( N-1, el);
+                            n_inc = 1;
+                            break;
+                        case SO3_N_MODE_EVEN:
+                            n_start = MAX(-N+1,-el);
+                            n_start += (-n_start)%2;
+                            n_stop  = MIN( N-1, el);
+                            n_stop  -=  n_stop%2;
+                            n_inc = 2;
+                            break;
+                        case SO3_N_MODE_ODD:
+                            n_start = MAX(-N+1,-el);
+                            n_start += 1+n_start%2;
+                            n_stop  = MIN( N-1, el);
+                            n_stop  -= 1-n_stop%2;
+                            n_inc = 2;
+                            break;
+                        case SO3_N_MODE_MAXIMUM:
+                            if (el < N-1)
+                                continue;
+                            n_start = -N+1;
+                            n_stop  =  N-1;
+                            n_inc = MAX(1,2*N-2);
+                            break;
+                        case SO3_N_MODE_L:
+                            if (el >= N)
+                                continue;
+                            n_start = -el;
+                            n_stop  =  el;
+                            n_inc = MAX(1,2*el);
+                            break;
+                        default:
+                            SO3_ERROR_GENERIC("Invalid n-mode.");
+                        }
+
+                        for (mm = -el; mm <= el; ++mm)
+                        {
+                            // These signs are needed for the symmetry relations of
+                            // Wigner symbols. For m' < 0, the sign of each m is
+                            // signs[el] * signs[abs(m)], and the latter is part of
+                            // the phases.
+                            double elmmsign = signs[el] * signs[abs(mm)];
+                            double elsign = mm >= 0 ? 1.0 : signs[el];
+                            const complex double *mm_phases = phases + m_offset
+                                                              + (mm >= 0 ? 0 : m_stride*(2*N-1));
+
+                            for (n = n_start; n <= n_stop; n += n_inc)
+                            {
+                                double mmsign = mm >= 0 ? 1.0 : signs[el] * signs[abs(n)];
+                                double elnsign = n >= 0 ? 1.0 : elmmsign;
+
+                                // Factor which does not depend on m.
+                                double elnmm_factor = mmsign * elnsign * elsign
+                                                      * dl[abs(n) + dl_offset + abs(mm)*dl_stride];
+
+                                // The coefficients of el and n are contiguous in m.
+                                int ind;
+                                so3_sampling_elmn2ind(&ind, el, 0, n, parameters);
+                                for (j = 0; j < size; ++j)
+                                {
+                                    const complex double *Gm = Gmnm + m_offset + m_stride*(
+                                                                      mm + mm_offset + mm_stride*(
+                                                                      j + batch*(
+                                                                      n + n_offset)));
+
+                                    if (flmn)
+                                        so3_simd_accumulate_flmn(
+                                            flmn + (size_t)(k+j)*flmn_dist + ind, Gm,
+                                            mm_phases + m_stride*(n + n_offset),
+                                            dl + dl_offset + abs(mm)*dl_stride, el,
+                                            elnmm_factor * elmmsign, elnmm_factor);
+                                    else
+                                        so3_simd_accumulate_flmn_split(
+                                            flmn_re + ind, flmn_im + ind, Gm,
+                                            mm_phases + m_stride*(n + n_offset),
+                                            dl + dl_offset + abs(mm)*dl_stride, el,
+                                            elnmm_factor * elmmsign, elnmm_factor);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                // The planes of this block are replaced by the next one.
+                #pragma omp barrier
+            }
+        }
+    }
+
+    if (verbosity > 0)
+        printf("%sForward transform computed!\n", SO3_PROMPT);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Compute forward Wigner transform for a complex signal directly (without using
+ * SSHT).
+ *
+ * \param[in]  plan Plan created for the parameters of the transform. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_forward_direct_real
+ *                  \endlink instead for real signals.
+ * \param[out] flmn Harmonic coefficients. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being passed to the function.
+ * \param[in] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_direct(
+    so3_plan_t *plan,
+    complex double *flmn, const complex double *f
+) {
+    return so3_plan_forward_direct(plan, flmn, NULL, NULL, f, NULL, NULL, 1);
+}
+
+/*!
+ * Compute forward Wigner transforms for several complex signals directly
+ * (without using SSHT).
+ *
+ * \note
+ *   The signals are transformed in groups, whose size is limited by the
+ *   memory required for their Gmnm'. Each Wigner plane is computed once
+ *   per group and applied to all of its signals while it is in cache.
+ *
+ * \param[in]  plan Plan created for the parameters of the transforms. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_forward_direct_real_batch
+ *                  \endlink instead for real signals.
+ * \param[out] flmn Harmonic coefficients, one set after the other, each of
+ *                  the size given by \link so3_sampling_flmn_size \endlink for
+ *                  complex signals.
+ * \param[in]  f Functions on sphere, one after the other, each of size
+ *               (2*L-1)*L*(2*N-1).
+ * \param[in]  count Number of signals.
+ * \retval status \link SO3_SUCCESS \endlink, \link SO3_ERROR_INVALID_ARGUMENT
+ *                \endlink if count is negative, or the error which made the
+ *                setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_direct_batch(
+    so3_plan_t *plan,
+    complex double *flmn, const complex double *f,
+    int count
+) {
+    return so3_plan_forward_direct(plan, flmn, NULL, NULL, f, NULL, NULL, count);
+}
+
+/*!
+ * Compute forward Wigner transform for a complex signal directly, with
+ * the signal and the coefficients stored as separate arrays of real and
+ * imaginary parts (split layout), e.g. as held by MATLAB.
+ *
+ * \param[in]  plan Plan created for the parameters of the transform.
+ * \param[out] flmn_re Real parts of the harmonic coefficients. If \link
+ *                     so3_parameters_t::n_mode n_mode \endlink is different
+ *                     from \link SO3_N_MODE_ALL \endlink, this array has to
+ *                     be nulled before being passed to the function.
+ * \param[out] flmn_im Imaginary parts of the harmonic coefficients, with
+ *                     the same requirement.
+ * \param[in]  f_re Real part of the function on sphere, of size
+ *                  (2*L-1)*L*(2*N-1).
+ * \param[in]  f_im Imaginary part of the function on sphere.
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_direct_split(
+    so3_plan_t *plan,
+    double *flmn_re, double *flmn_im,
+    const double *f_re, const double *f_im
+) {
+    return so3_plan_forward_direct(plan, NULL, flmn_re, flmn_im, NULL, f_re, f_im, 1);
+}
+
+/*!
+ * Compute inverse Wigner transform for a real signal directly (without using
+ * SSHT).
+ *
+ * \param[in]  plan Plan created for the parameters of the transform. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_inverse_direct
+ *                  \endlink instead for complex signals.
+ * \param[out] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \param[in] flmn Harmonic coefficients for n >= 0. Note that for n = 0, these have to
+ *                 respect the symmetry flm0* = (-1)^(m+n)*fl-m0, and hence fl00 has to be real.
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_direct_real(
+    so3_plan_t *plan,
+    double *f, const complex double *flmn
+) {
+    return so3_plan_execute_inverse_direct_real_batch(plan, f, flmn, 1);
+}
+
+/*!
+ * Compute inverse Wigner transforms for several real signals directly
+ * (without using SSHT).
+ *
+ * \note
+ *   The signals are transformed in groups, whose size is limited by the
+ *   memory required for their Fmnm'. Each Wigner plane is computed once
+ *   per group and applied to all of its signals while it is in cache.
+ *
+ * \param[in]  plan Plan created for the parameters of the transforms. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_inverse_direct_batch
+ *                  \endlink instead for complex signals.
+ * \param[out] f Functions on sphere, one after the other. Provide a buffer of
+ *               count times the size (2*L-1)*L*(2*N-1).
+ * \param[in]  flmn Harmonic coefficients for n >= 0, one set after the
+ *                  other, each of the size given by \link
+ *                  so3_sampling_flmn_size \endlink for real signals. See
+ *                  \link so3_plan_execute_inverse_direct_real \endlink for
+ *                  the symmetry they have to respect.
+ * \param[in]  count Number of signals.
+ * \retval status \link SO3_SUCCESS \endlink, \link SO3_ERROR_INVALID_ARGUMENT
+ *                \endlink if count is negative, or the error which made the
+ *                setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_inverse_direct_real_batch(
+    so3_plan_t *plan,
+    double *f, const complex double *flmn,
+    int count
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L0, L, N;
+    so3_storage_t storage;
+    so3_n_mode_t n_mode;
+    int verbosity;
+
+    L0 = parameters->L0;
+    L = parameters->L;
+    N = parameters->N;
+    storage = parameters->storage;
+    // TODO: Add optimisations for all n-modes.
+    n_mode = parameters->n_mode;
+    verbosity = parameters->verbosity;
+
+    if (count < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    // Print messages depending on verbosity level.
+    if (verbosity > 0)
+    {
+        printf("%sComputing inverse transform using MW sampling with\n", SO3_PROMPT);
+        printf("%sparameters  (L, N, reality) = (%d, %d, FALSE)\n", SO3_PROMPT, L, N);
+        if (verbosity > 1)
+            printf("%sUsing routine so3_core_mw_inverse_direct with storage method %d...\n"
+                    , SO3_PROMPT
+                    , storage);
+    }
+
+    // Iterators
+    int el, m, n, mm; // mm for m'
+    int k, j;
+    // Number of signals transformed together
+    int group, size;
+
+    if (!plan->inverse_direct_real.ready)
+    {
+        // The FFTW planner is not thread-safe.
+        #pragma omp critical (so3_fftw_planner)
+        so3_plan_setup_inverse_direct_real(plan);
+    }
+    group = so3_plan_setup_direct_batch(plan, &plan->inverse_direct_real.Fmnm, &plan->inverse_direct_real.batch,
+                                        2*L-1, (size_t)(2*L-1)*N,
+                                        &plan->inverse_direct_real.mn_factors, (size_t)(2*L-1)*N,
+                                        count);
+    if (plan->status != SO3_SUCCESS)
+        return plan->status;
+
+    double *signs = plan->signs;
+    complex double *exps = plan->exps;
+
+    // Fmnm' of the signals of a group. Each slab of m' holds the blocks
+    // of all of them.
+    // TODO: Currently m is fastest-varying, then n, then m'.
+    // Should this order be changed to m-m'-n?
+    complex double *Fmnm = plan->inverse_direct_real.Fmnm;
+    int batch = plan->inverse_direct_real.batch;
+    int m_offset = L-1;
+    int m_stride = 2*L-1;
+    int n_offset = 0;
+    int n_stride = N;
+    int mm_offset = L-1;
+    // unused: int mm_stride = 2*L-1;
+
+    // Distances between consecutive signals
+    int f_dist = so3_sampling_f_size(parameters);
+    int flmn_dist = so3_plan_flmn_dist(parameters, 1);
+
+    int n_start, n_stop, n_inc;
+
+    const double *dl;
+    int dl_offset, dl_stride;
+
+    complex double *mn_factors = plan->inverse_direct_real.mn_factors;
+
+    // Shifted Fmnm' (input of the c2r FFT, which destroys it).
+    complex double *Fmnm_shift = plan->inverse_direct_real.Fmnm_shift;
+
+    // Function values on the extended torus.
+    double *fext = plan->inverse_direct_real.fext;
+
+    int a,b,g;
+    int a_stride = 2*L-1;
+    // unused: int b_ext_stride = 2*L-1;
+    int b_stride = L;
+    int g_stride = 2*N-1;
+
+    // Range of n of the extended torus.
+    switch (n_mode)
+    {
+    case SO3_N_MODE_ALL:
+    case SO3_N_MODE_L:
+        n_start = 0;
+        n_stop  = N-1;
+        n_inc = 1;
+        break;
+    case SO3_N_MODE_EVEN:
+        n_start = 0;
+        n_stop  = ((N-1) % 2 == 0) ?  N-1 :  N-2;
+        n_inc = 2;
+        break;
+    case SO3_N_MODE_ODD:
+        n_start = 1;
+        n_stop  = ((N-1) % 2 != 0) ?  N-1 :  N-2;
+        n_inc = 2;
+        break;
+    case SO3_N_MODE_MAXIMUM:
+        n_start = N-1;
+        n_stop  = N-1;
+        n_inc = 1;
+        break;
+    default:
+        SO3_ERROR_GENERIC("Invalid n-mode.");
+    }
+
+    for (k = 0; k < count; k += group)
+    {
+        size = MIN(group, count - k);
+
+        // Compute Fmnm'
+
+        // TODO: SSHT starts this loop from MAX(L0, abs(spin)).
+        // Can we use a similar optimisation? el can probably
+        // be limited by n, but then we'd need to switch the
+        // loop order, which means we'd have to recompute the
+        // Wigner plane for each n. That seems wrong?
+        // Each Wigner plane is computed by one thread and then applied by
+        // all threads, which own disjoint slabs of Fmnm' for different m',
+        // to all signals of the group.
+        #pragma omp parallel num_threads(plan->nthreads) \
+                private(el, m, n, mm, j, n_start, n_stop, n_inc)
+        {
+            #pragma omp for schedule(static)
+            for (mm = 0; mm < 2*L-1; ++mm)
+                memset(Fmnm + (size_t)m_stride*n_stride*batch*mm, 0,
+                       (size_t)size*m_stride*n_stride * sizeof *Fmnm);
+
+            for (el = L0; el <= L-1; ++el)
+            {
+                // Compute Wigner plane.
+                #pragma omp single
+                dl = so3_plan_get_wigner_plane(plan, el, &dl_offset, &dl_stride);
+
+                // Compute Fmnm' contribution for current el.
+
+                // Factor which depends only on el.
+                double elfactor = (2.0*el+1.0)/(8.0*SO3_PI*SO3_PI);
+
+
+                switch (n_mode)
+                {
+                case SO3_N_MODE_ALL:
+                    n_start = 0;
+                    n_stop  = MIN( N-1, el);
+                    n_inc = 1;
+                    break;
+                case SO3_N_MODE_EVEN:
+                    n_start = 0;
+                    n_stop  = MIN( N-1, el);
+                    n_stop  -=  n_stop%2;
+                    n_inc = 2;
+                    break;
+                case SO3_N_MODE_ODD:
+                    n_start = 1;
+                    n_stop  = MIN( N-1, el);
+                    n_stop  -= 1-n_stop%2;
+                    n_inc = 2;
+                    break;
+                case SO3_N_MODE_MAXIMUM:
+                    if (el < N-1)
+                        continue;
+                    n_start = N-1;
+                    n_stop  = N-1;
+                    n_inc = 1;
+                    break;
+                case SO3_N_MODE_L:
+                    if (el >= N)
+                        continue;
+                    n_start = el;
+                    n_stop  = el;
+                    n_inc = 1;
+                    break;
+                default:
+                    SO3_ERROR_GENERIC("Invalid n-mode.");
+                }
+
+                // Factors which do not depend on m'.
+                #pragma omp for schedule(static)
+                for (n = n_start; n <= n_stop; n += n_inc)
+                    for (m = -el; m <= el; ++m)
+                    {
+                        int ind;
+                        so3_sampling_elmn2ind_real(&ind, el, m, n, parameters);
+                        int mod = ((n-m)%4 + 4)%4;
+                        for (j = 0; j < size; ++j)
+                            mn_factors[m + m_offset + m_stride*(
+                                       n + n_offset + n_stride*(
+                                       j))] =
+                                flmn[(size_t)(k+j)*flmn_dist + ind] * exps[mod];
+                    }
+
+                #pragma omp for schedule(static)
+                for (mm = 0; mm <= el; ++mm)
+                {
+                    // These signs are needed for the symmetry relations of
+                    // Wigner symbols.
+                    double elmmsign = signs[el] * signs[mm];
+
+                    for (n = n_start; n <= n_stop; n += n_inc)
+                    {
+                        // Factor which does not depend on m.
+                        double elnmm_factor = elfactor
+                                              * dl[n + dl_offset + mm*dl_stride];
+                        for (j = 0; j < size; ++j)
+                            so3_simd_accumulate_fmnm(
+                                Fmnm + m_offset + m_stride*(
+                                       n + n_offset + n_stride*(
+                                       j + batch*(
+                                       mm + mm_offset))),
+                                mn_factors + m_offset + m_stride*(
+                                             n + n_offset + n_stride*(
+                                             j)),
+                                dl + dl_offset + mm*dl_stride,
+                                el, elnmm_factor * elmmsign, elnmm_factor);
+                    }
+                }
+            }
+
+        }
+
+        for (j = 0; j < size; ++j)
+        {
+            size_t f_offset = (size_t)(k+j)*f_dist;
+
+            // Use symmetry to compute Fmnm' for negative m'.
+            #pragma omp parallel for num_threads(plan->nthreads) private(m, n)
+            for (mm = -L+1; mm < 0; ++mm)
+                for (n = n_start; n <= n_stop; n += n_inc)
+                    for (m = -L+1; m <= L-1; ++m)
+                        Fmnm[m + m_offset + m_stride*(
+                             n + n_offset + n_stride*(
+                             j + batch*(
+                             mm + mm_offset)))] =
+                            signs[abs(m+n)%2]
+                            * Fmnm[m + m_offset + m_stride*(
+                                   n + n_offset + n_stride*(
+                                   j + batch*(
+                                   -mm + mm_offset)))];
+
+            // Apply phase modulation to account for sampling offset.
+            #pragma omp parallel for num_threads(plan->nthreads) private(m, n)
+            for (mm = -L+1; mm <= L-1; ++mm)
+            {
+                complex double mmfactor = cexp(I*mm*SO3_PI/(2.0*L-1.0));
+                for (n = n_start; n <= n_stop; n += n_inc)
+                    for (m = -L+1; m <= L-1; ++m)
+                        Fmnm[m + m_offset + m_stride*(
+                             n + n_offset + n_stride*(
+                             j + batch*(
+                             mm + mm_offset)))] *= mmfactor;
+            }
+
+            #pragma omp parallel for num_threads(plan->nthreads)
+            for (mm = 0; mm < 2*L-1; ++mm)
+                memset(Fmnm_shift + N*(2*L-1)*mm, 0, N*(2*L-1) * sizeof *Fmnm_shift);
+
+            // Apply spatial shift.
+            // This also reshapes the array to make n the inner dimension.
+            #pragma omp parallel for num_threads(plan->nthreads) private(m, n)
+            for (mm = -L+1; mm <= L-1; ++mm)
+            {
+                int mm_shift = mm < 0 ? 2*L-1 : 0;
+                for (n = n_start; n <= n_stop; n += n_inc)
+                {
+                    for (m = -L+1; m <= L-1; ++m)
+                    {
+                        int m_shift = m < 0 ? 2*L-1 : 0;
+                        Fmnm_shift[n + n_stride*(
+                                   m + m_shift + m_stride*(
+                                   mm + mm_shift))] =
+                            Fmnm[m + m_offset + m_stride*(
+                                 n + n_offset + n_stride*(
+                                 j + batch*(
+                                 mm + mm_offset)))];
+                    }
+                }
+            }
+
+            // Perform 3D FFT.
+            fftw_execute(plan->inverse_direct_real.plan);
+
+            // Extract f from the extended torus.
+            // Again, we reshape the array in the process.
+            #pragma omp parallel for num_threads(plan->nthreads) private(a, b)
+            for (g = 0; g < 2*N-1; ++g)
+                for (b = 0; b < L; ++b)
+                    for (a = 0; a < 2*L-1; ++a)
+                        f[f_offset + a + a_stride*(
+                          b + b_stride*(
+                          g))] = fext[g + g_stride*(
+                                      a + a_stride*(
+                                      b))];
+        }
+    }
+
+    if (verbosity > 0)
+        printf("%sInverse transform computed!\n", SO3_PROMPT);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Compute forward Wigner transform for a real signal directly (without using
+ * SSHT).
+ *
+ * \param[in]  plan Plan created for the parameters of the transform. The \link
+ *                  so3_parameters_t::reality reality \endlink flag
+ *                  is ignored. Use \link so3_plan_execute_forward_direct
+ *                  \endlink instead for complex signals.
+ * \param[out] flmn Harmonic coefficients. If \link so3_parameters_t::n_mode n_mode
+ *                  \endlink is different from \link SO3_N_MODE_ALL \endlink,
+ *                  this array has to be nulled before being past to the function.
+ * \param[in] f Function on sphere. Provide a buffer of size (2*L-1)*L*(2*N-1).
+ * \retval status \link SO3_SUCCESS \endlink, or the error which made
+ *                the setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_direct_real(
+    so3_plan_t *plan,
+    complex double *flmn, const double *f
+) {
+    return so3_plan_execute_forward_direct_real_batch(plan, flmn, f, 1);
+}
+
+/*!
+ * Compute forward Wigner transforms for several real signals directly
+ * (without using SSHT).
+ *
+ * \note
+ *   The signals are transformed in groups, whose size is limited by the
+ *   memory required for their Gmnm'. Each Wigner plane is computed once
+ *   per group and applied to all of its signals while it is in cache.
+ *
+ * \param[in]  plan Plan created for the parameters of the transforms. The \link
+ *                  so3_parameters_t::reality reality\endlink flag
+ *                  is ignored. Use \link so3_plan_execute_forward_direct_batch
+ *                  \endlink instead for complex signals.
+ * \param[out] flmn Harmonic coefficients for n >= 0, one set after the
+ *                  other, each of the size given by \link
+ *                  so3_sampling_flmn_size \endlink for real signals.
+ * \param[in]  f Functions on sphere, one after the other, each of size
+ *               (2*L-1)*L*(2*N-1).
+ * \param[in]  count Number of signals.
+ * \retval status \link SO3_SUCCESS \endlink, \link SO3_ERROR_INVALID_ARGUMENT
+ *                \endlink if count is negative, or the error which made the
+ *                setup of the plan fail.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_plan_execute_forward_direct_real_batch(
+    so3_plan_t *plan,
+    complex double *flmn, const double *f,
+    int count
+) {
+    const so3_parameters_t *parameters = &plan->parameters;
+    int L0, L, N;
+    so3_storage_t storage;
+    so3_n_mode_t n_mode;
+    int verbosity;
+
+    L0 = parameters->L0;
+    L = parameters->L;
+    N = parameters->N;
+    storage = parameters->storage;
+    // TODO: Add optimisations for all n-modes.
+    n_mode = parameters->n_mode;
+    verbosity = parameters->verbosity;
+
+    if (count < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    // Print messages depending on verbosity level.
+    if (verbosity > 0) {
+        printf("%sComputing forward transform using MW sampling with\n", SO3_PROMPT);
+        printf("%sparameters  (L, N, reality) = (%d, %d, FALSE)\n", SO3_PROMPT, L, N);
+        if (verbosity > 1)
+            printf("%sUsing routine so3_core_mw_forward_direct with storage method %d...\n"
+                    , SO3_PROMPT
+                    , storage);
+    }
+
+    int m_stride = 2*L-1;
+    int m_offset = L-1;
+    int n_offset = 0;
+    int n_stride = N;
+    int mm_stride = 2*L-1;
+    int mm_offset = L-1;
+    int a_stride = 2*L-1;
+    int b_stride = L;
+    int bext_stride = 2*L-1;
+    int g_stride = 2*N-1;
+
+    int n_start, n_stop, n_inc;
+
+    switch (n_mode)
+    {
+    case SO3_N_MODE_ALL:
+    case SO3_N_MODE_L:
+        n_start = 0;
+        n_stop  = N-1;
+        n_inc = 1;
+        break;
+    case SO3_N_MODE_EVEN:
+        n_start = 0;
+        n_stop  = ((N-1) % 2 == 0) ?  N-1 :  N-2;
+        n_inc = 2;
+        break;
+    case SO3_N_MODE_ODD:
+        n_start = 1;
+        n_stop  = ((N-1) % 2 != 0) ?  N-1 :  N-2;
+        n_inc = 2;
+        break;
+    case SO3_N_MODE_MAXIMUM:
+        n_start = N-1;
+        n_stop  = N-1;
+        n_inc = 1;
+        break;
+    default:
+        SO3_ERROR_GENERIC("Invalid n-mode.");
+    }
+
+    int k, j;
+    // Number of signals transformed together
+    int group, size;
+
+    if (!plan->forward_direct_real.ready)
+    {
+        // The FFTW planner is not thread-safe.
+        #pragma omp critical (so3_fftw_planner)
+        so3_plan_setup_forward_direct_real(plan);
+    }
+    group = so3_plan_setup_direct_batch(plan, &plan->forward_direct_real.Gmnm, &plan->forward_direct_real.batch,
+                                        N, (size_t)(2*L-1)*(2*L-1), NULL, 0, count);
+    if (plan->status != SO3_SUCCESS)
+        return plan->status;
+
+    double *signs = plan->signs;
+    complex double *phases = plan->forward_direct_real.phases;
+    complex double *expsmm = plan->forward_direct_real.expsmm;
+
+    int el, m, n, mm; // mm is for m'
+
+    // Gmnm' of the signals of a group. Each slab of n holds the blocks
+    // of all of them.
+    complex double *Gmnm = plan->forward_direct_real.Gmnm;
+    int batch = plan->forward_direct_real.batch;
+
+    // Distances between consecutive signals
+    int f_dist = so3_sampling_f_size(parameters);
+    int flmn_dist = so3_plan_flmn_dist(parameters, 1);
+
+    double norm_factor = 1.0/(2.0*L-1.0)/(2.0*N-1.0);
+
+    complex double *Fmnm = plan->forward_direct_real.Fmnm;
+    int a, b, g;
+    int w_dist = (2*L-1)*(4*L-3);
+    int el_first, el_count, first, last;
+
+    for (k = 0; k < count; k += group)
+    {
+        size = MIN(group, count - k);
+
+        for (j = 0; j < size; ++j)
+        {
+            size_t f_offset = (size_t)(k+j)*f_dist;
+
+            // Compute Fourier transform over alpha and gamma, i.e. compute Fmn(b).
+            // Each thread uses its own slices of fft_in and fft_out.
+            complex double *Fmnb = plan->forward_direct_real.Fmnb;
+            int fft_in_dist = plan->forward_direct_real.fft_in_dist;
+            int fft_out_dist = (2*L-1)*N;
+
+            #pragma omp parallel for num_threads(plan->nthreads) private(a, g, m, n)
+            for (b = 0; b < L; ++b)
+            {
+                double *fft_in = plan->forward_direct_real.fft_in
+                                 + omp_get_thread_num()*fft_in_dist;
+                complex double *fft_out = plan->forward_direct_real.fft_out
+                                          + omp_get_thread_num()*fft_out_dist;
+
+                // TODO: This loop could probably be avoided by using
+                // a more elaborate FFTW plan which performs the FFT directly
+                // over the 1st and 3rd dimensions of f.
+                // Instead, for each index in the 2nd dimension, we copy the
+                // corresponding values in the 1st and 3rd dimension into a
+                // new 2D array, to perform a standard 2D FFT there. While
+                // we're at it, we also reshape that array such that gamma
+                // is the inner dimension, as required by FFTW.
+                for (a = 0; a < 2*L-1; ++a)
+                    for (g = 0; g < 2*N-1; ++g)
+                        fft_in[g + g_stride*(
+                               a)] =
+                            f[f_offset + a + a_stride*(
+                              b + b_stride*(
+                              g))];
+
+                fftw_execute_dft_r2c(plan->forward_direct_real.plan_alpha_gamma, fft_in, fft_out);
+
+                // Apply spatial shift and normalisation factor, while
+                // reshaping the dimensions once more.
+                for (n = n_start; n <= n_stop; n += n_inc)
+                {
+                    for (m = -L+1; m <= L-1; ++m)
+                    {
+                        int m_shift = m < 0 ? 2*L-1 : 0;
+                        Fmnb[b + bext_stride*(
+                             m + m_offset + m_stride*(
+                             n + n_offset))] =
+                            fft_out[n + n_stride*(
+                                    m + m_shift)] * norm_factor;
+                    }
+                }
+            }
+
+            // Extend Fmnb periodically.
+            #pragma omp parallel for num_threads(plan->nthreads) private(m, b)
+            for (n = n_start; n <= n_stop; n += n_inc)
+                for (m = -L+1; m <= L-1; ++m)
+                {
+                    int signmn = signs[abs(m+n)%2];
+                    for (b = L; b < 2*L-1; ++b)
+                        Fmnb[b + bext_stride*(
+                             m + m_offset + m_stride*(
+                             n + n_offset))] =
+                            signmn
+                            * Fmnb[(2*L-2-b) + bext_stride*(
+                                   m + m_offset + m_stride*(
+                                   n + n_offset))];
+                }
+
+            // Compute Fourier transform over beta, i.e. compute Fmnm'.
+            #pragma omp parallel for num_threads(plan->nthreads) private(m)
+            for (n = n_start; n <= n_stop; n += n_inc)
+                for (m = -L+1; m <= L-1; ++m)
+                {
+                    complex double *inout = plan->forward_direct_real.inout
+                                            + omp_get_thread_num()*(2*L-1);
+
+                    memcpy(inout,
+                           Fmnb + 0 + bext_stride*(
+                                  m + m_offset + m_stride*(
+                                  n + n_offset)),
+                           bext_stride*sizeof(*Fmnb));
+                    fftw_execute_dft(plan->forward_direct_real.plan_beta, inout, inout);
+
+                    // Apply spatial shift, normalisation factor and phase
+                    // modulation to account for sampling offset.
+                    complex double *Fmm = Fmnm + mm_offset + mm_stride*(
+                                                 m + m_offset + m_stride*(
+                                                 n + n_offset));
+                    so3_simd_modulate(Fmm, inout, expsmm + mm_offset, 1.0/(2.0*L-1.0), L);
+                    so3_simd_modulate(Fmm - L+1, inout + L, expsmm, 1.0/(2.0*L-1.0), L-1);
+                }
+
+            // Compute Gmnm' by convolution implemented as product in real space.
+            #pragma omp parallel for num_threads(plan->nthreads)
+            for (n = n_start; n <= n_stop; n += n_inc)
+                so3_plan_weight_convolution(
+                    plan, plan->weights.inout + omp_get_thread_num()*w_dist,
+                    Gmnm + m_stride*mm_stride*(j + batch*(n + n_offset)), 1, m_stride,
+                    Fmnm + mm_stride*m_stride*(n + n_offset), mm_stride, 1);
+        }
+
+        // Compute flmn.
+        #pragma omp parallel for num_threads(plan->nthreads) private(el, m, j)
+        for (n = 0; n <= N-1; ++n)
+            for (el = n; el < L; ++el)
+                for (m = -el; m <= el; ++m)
+                {
+                    int ind;
+                    so3_sampling_elmn2ind_real(&ind, el, m, n, parameters);
+                    for (j = 0; j < size; ++j)
+                        flmn[(size_t)(k+j)*flmn_dist + ind] = 0.0;
+                }
+
+        // The el range is split across threads by the work-stealing
+        // scheduler, according to the cost of each el, and each thread
+        // accumulates the coefficients of its own el. The Wigner planes are
+        // obtained in blocks by a single thread (which advances the
+        // recursion), or all at once if they are read from a cache. Each
+        // row of a plane is applied to all signals of the group.
+        #pragma omp parallel num_threads(plan->nthreads) \
+                private(el, m, n, mm, j, n_start, n_stop, n_inc, el_first, el_count, first, last)
+        {
+            int thread = omp_get_thread_num();
+
+            for (el_first = L0; el_first < L; el_first += el_count)
+            {
+                #pragma omp single copyprivate(el_count)
+                {
+                    double *cost;
+
+                    el_count = so3_plan_get_wigner_planes(plan, el_first, L);
+                    cost = so3_schedule_costs(plan->schedule, el_count);
+                    for (el = el_first; el < el_first + el_count; ++el)
+                        cost[el - el_first] = so3_plan_direct_el_cost(parameters, el, 1);
+                    so3_schedule_partition(plan->schedule);
+                }
+
+                while (so3_schedule_next(plan->schedule, thread, &first, &last))
+                {
+                    for (el = el_first + first; el < el_first + last; ++el)
+                    {
+                        // Wigner plane of the current el.
+                        const double *dl = plan->dl_block.planes[el - el_first];
+                        int dl_offset = plan->dl_block.offsets[el - el_first];
+                        int dl_stride = plan->dl_block.strides[el - el_first];
+
+                        // Compute flmn for current el.
+
+                        switch (n_mode)
+                        {
+                        case SO3_N_MODE_ALL:
+                            n_start = 0;
+                            n_stop  = MIN( N-1, el);
+                            n_inc = 1;
+                            break;
+                        case SO3_N_MODE_EVEN:
+                            n_start = 0;
+                            n_stop  = MIN( N-1, el);
+                            n_stop  -=  n_stop%2;
+                            n_inc = 2;
+                            break;
+                        case SO3_N_MODE_ODD:
+                            n_start = 1;
+                            n_stop  = MIN( N-1, el);
+                            n_stop  -= 1-n_stop%2;
+                            n_inc = 2;
+                            break;
+                        case SO3_N_MODE_MAXIMUM:
+                            if (el < N-1)
+                                continue;
+                            n_start = N-1;
+                            n_stop  = N-1;
+                            n_inc = 1;
+                            break;
+                        case SO3_N_MODE_L:
+                            if (el >= N)
+                                continue;
+                            n_start = el;
+                            n_stop  = el;
+                            n_inc = 1;
+                            break;
+                        default:
+                            SO3_ERROR_GENERIC("Invalid n-mode.");
+                        }
+
+                        for (mm = -el; mm <= el; ++mm)
+                        {
+                            // These signs are needed for the symmetry relations of
+                            // Wigner symbols. For m' < 0, the sign of each m is
+                            // signs[el] * signs[abs(m)], and the latter is part of
+                            // the phases.
+                            double elmmsign = signs[el] * signs[abs(mm)];
+                            double elsign = mm >= 0 ? 1.0 : signs[el];
+                            const complex double *mm_phases = phases + m_offset
+                                                              + (mm >= 0 ? 0 : m_stride*N);
+
+                            for (n = n_start; n <= n_stop; n += n_inc)
+                            {
+                                double mmsign = mm >= 0 ? 1.0 : signs[el] * signs[abs(n)];
+
+                                // Factor which does not depend on m.
+                                double elnmm_factor = mmsign * elsign
+                                                      * dl[n + dl_offset + abs(mm)*dl_stride];
+
+                                // The coefficients of el and n are contiguous in m.
+                                int ind;
+                                so3_sampling_elmn2ind_real(&ind, el, 0, n, parameters);
+                                for (j = 0; j < size; ++j)
+                                    so3_simd_accumulate_flmn(
+                                        flmn + (size_t)(k+j)*flmn_dist + ind,
+                                        Gmnm + m_offset + m_stride*(
+                                               mm + mm_offset + mm_stride*(
+                                               j + batch*(
+                                               n + n_offset))),
+                                        mm_phases + m_stride*(n + n_offset),
+                                        dl + dl_offset + abs(mm)*dl_stride, el,
+                                        elnmm_factor * elmmsign, elnmm_factor);
+                            }
+                        }
+                    }
+                }
+
+                // The planes of this block are replaced by the next one.
+                #pragma omp barrier
+            }
+        }
+    }
+
+    if (verbosity > 0)
+        printf("%sForward transform computed!\n", SO3_PROMPT);
+
+    return SO3_SUCCESS;
+}
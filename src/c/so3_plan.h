@@ -0,0 +1,155 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_plan.h
+ *  Reusable transform plans, which own all parameter-dependent
+ *  precomputations, scratch buffers and FFTW plans.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_PLAN
+#define SO3_PLAN
+
+#include "ssht.h"
+#include <complex.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+#include "so3_dl_cache.h"
+#include "so3_schedule.h"
+
+/*!
+ * Opaque plan object. Create one with \link so3_plan_create \endlink
+ * for a given parameter set, execute it as often as required and
+ * release it with \link so3_plan_destroy \endlink.
+ */
+typedef struct so3_plan so3_plan_t;
+
+so3_status_t so3_plan_create_r(
+    so3_plan_t **plan, const so3_parameters_t *parameters, unsigned flags
+);
+so3_plan_t *so3_plan_create(const so3_parameters_t *parameters, unsigned flags);
+void so3_plan_destroy(so3_plan_t *plan);
+
+const so3_parameters_t *so3_plan_get_parameters(const so3_plan_t *plan);
+int so3_plan_set_dl_cache(so3_plan_t *plan, const so3_dl_cache_t *cache);
+
+int so3_plan_get_thread_stats(const so3_plan_t *plan, so3_schedule_stats_t *stats);
+void so3_plan_reset_thread_stats(so3_plan_t *plan);
+
+/*! \link so3_plan_prepare \endlink: set up the transforms via SSHT. */
+#define SO3_PLAN_PREPARE_VIA_SSHT 0x1
+/*! \link so3_plan_prepare \endlink: set up the direct transforms. */
+#define SO3_PLAN_PREPARE_DIRECT 0x2
+/*! \link so3_plan_prepare \endlink: set up all transforms. */
+#define SO3_PLAN_PREPARE_ALL (SO3_PLAN_PREPARE_VIA_SSHT | SO3_PLAN_PREPARE_DIRECT)
+
+so3_status_t so3_plan_prepare(so3_plan_t *plan, unsigned algorithms);
+
+int so3_plan_import_wisdom(const char *filename);
+int so3_plan_export_wisdom(const char *filename);
+
+so3_status_t so3_plan_execute_inverse_via_ssht(
+    so3_plan_t *plan,
+    complex double *f, const complex double *flmn
+);
+
+so3_status_t so3_plan_execute_inverse_via_ssht_batch(
+    so3_plan_t *plan,
+    complex double *f, const complex double *flmn,
+    int count
+);
+
+so3_status_t so3_plan_execute_forward_via_ssht(
+    so3_plan_t *plan,
+    complex double *flmn, const complex double *f
+);
+
+so3_status_t so3_plan_execute_forward_via_ssht_batch(
+    so3_plan_t *plan,
+    complex double *flmn, const complex double *f,
+    int count
+);
+
+so3_status_t so3_plan_execute_inverse_via_ssht_real(
+    so3_plan_t *plan,
+    double *f, const complex double *flmn
+);
+
+so3_status_t so3_plan_execute_inverse_via_ssht_real_batch(
+    so3_plan_t *plan,
+    double *f, const complex double *flmn,
+    int count
+);
+
+so3_status_t so3_plan_execute_forward_via_ssht_real(
+    so3_plan_t *plan,
+    complex double *flmn, const double *f
+);
+
+so3_status_t so3_plan_execute_forward_via_ssht_real_batch(
+    so3_plan_t *plan,
+    complex double *flmn, const double *f,
+    int count
+);
+
+so3_status_t so3_plan_execute_inverse_direct(
+    so3_plan_t *plan,
+    complex double *f, const complex double *flmn
+);
+
+so3_status_t so3_plan_execute_inverse_direct_batch(
+    so3_plan_t *plan,
+    complex double *f, const complex double *flmn,
+    int count
+);
+
+so3_status_t so3_plan_execute_forward_direct(
+    so3_plan_t *plan,
+    complex double *flmn, const complex double *f
+);
+
+so3_status_t so3_plan_execute_forward_direct_batch(
+    so3_plan_t *plan,
+    complex double *flmn, const complex double *f,
+    int count
+);
+
+so3_status_t so3_plan_execute_inverse_direct_split(
+    so3_plan_t *plan,
+    double *f_re, double *f_im,
+    const double *flmn_re, const double *flmn_im
+);
+
+so3_status_t so3_plan_execute_forward_direct_split(
+    so3_plan_t *plan,
+    double *flmn_re, double *flmn_im,
+    const double *f_re, const double *f_im
+);
+
+so3_status_t so3_plan_execute_inverse_direct_real(
+    so3_plan_t *plan,
+    double *f, const complex double *flmn
+);
+
+so3_status_t so3_plan_execute_inverse_direct_real_batch(
+    so3_plan_t *plan,
+    double *f, const complex double *flmn,
+    int count
+);
+
+so3_status_t so3_plan_execute_forward_direct_real(
+    so3_plan_t *plan,
+    complex double *flmn, const double *f
+);
+
+so3_status_t so3_plan_execute_forward_direct_real_batch(
+    so3_plan_t *plan,
+    complex double *flmn, const double *f,
+    int count
+);
+
+#endif
@@ -0,0 +1,195 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_plan_internal.h
+ *  Internals of the transform plans, shared with the distributed
+ *  transforms of so3_mpi.c. Not part of the public interface.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_PLAN_INTERNAL
+#define SO3_PLAN_INTERNAL
+
+#include <complex.h>  // Must be before fftw3.h
+#include <fftw3.h>
+
+#include "so3_types.h"
+#include "so3_error.h"
+#include "so3_dl_cache.h"
+#include "so3_schedule.h"
+#include "so3_plan.h"
+
+#define MIN(a,b) ((a < b) ? (a) : (b))
+#define MAX(a,b) ((a > b) ? (a) : (b))
+
+struct so3_plan {
+    // Copy of the parameters the plan was created for.
+    so3_parameters_t parameters;
+    // FFTW planner flags used for all FFTW plans.
+    unsigned flags;
+    // Number of threads used by the transforms (see
+    // so3_parameters_t::num_threads).
+    int nthreads;
+    // Scheduler for the parallel loops with uneven work per iteration.
+    so3_schedule_t *schedule;
+    // SO3_SUCCESS, or the error which made the setup of a transform
+    // fail. A plan in error stays unusable and can only be destroyed.
+    so3_status_t status;
+
+    // Precomputations for the Wigner recursions.
+    double *sqrt_tbl;
+    double *signs;
+    complex double *exps;
+    double *dl, *dl8;
+    int dl_offset, dl_stride;
+    // Optional cache of the Wigner planes, which replaces the recursion.
+    const so3_dl_cache_t *dl_cache;
+    // Wigner planes of a block of consecutive el, for the transforms
+    // which split el across threads (see so3_plan_get_wigner_planes).
+    // Without a cache, the planes are packed into buffer, which holds as
+    // many values as one full plane per thread.
+    struct {
+        double *buffer;
+        const double **planes;
+        int *offsets, *strides;
+    } dl_block;
+
+    // Quadrature weights (in real space) and FFTW plans for the
+    // convolution in the direct forward transforms.
+    struct {
+        int ready;
+        complex double *kernel;
+        complex double *inout;
+        fftw_plan plan_bwd, plan_fwd;
+    } weights;
+
+    // Separation-of-variables engine of the transforms via SSHT.
+    // Fmnm and mn_factors have room for nblocks blocks of n, those of
+    // the signals which are transformed together (see
+    // so3_plan_setup_sov_batch).
+    struct {
+        int ready;
+        int ntheta, ntheta_ext, nphi;
+        int nblocks;
+        // ext and Fmm hold one buffer per thread.
+        complex double *Fmnm, *mn_factors, *ext, *Fmm, *expsmm;
+        fftw_plan plan_inverse, plan_phi, plan_theta;
+    } sov;
+
+    // The FFTs over gamma of the transforms are split into
+    // nchunks chunks of chunk columns (the last chunk may be smaller and
+    // then uses plan_last), which are executed by different threads.
+    // fn holds batch blocks of fn_dist values, one per signal.
+    struct {
+        int ready;
+        int fn_n_stride, fftw_n, fn_dist, batch;
+        complex double *fn, *ftemp;
+        int chunk, nchunks;
+        fftw_plan plan, plan_last;
+    } inverse_via_ssht;
+
+    struct {
+        int ready;
+        int fn_n_stride, fn_dist, batch;
+        complex double *fn;
+        int chunk, nchunks;
+        fftw_plan plan, plan_last;
+    } forward_via_ssht;
+
+    struct {
+        int ready;
+        int fn_n_stride, fftw_n, fn_dist, batch;
+        complex double *fn;
+        double *ftemp;
+        int chunk, nchunks;
+        fftw_plan plan, plan_last;
+    } inverse_via_ssht_real;
+
+    struct {
+        int ready;
+        int fn_n_stride, fn_dist, batch;
+        complex double *fn;
+        int chunk, nchunks;
+        fftw_plan plan, plan_last;
+    } forward_via_ssht_real;
+
+    // Fmnm only holds m' >= 0. mm_phases holds one row per thread.
+    // Fmnm and mn_factors (of the inverse transforms) and Gmnm (of the
+    // forward transforms) hold the blocks of batch signals, which share
+    // each Wigner plane (see so3_plan_setup_direct_batch).
+    struct {
+        int ready;
+        int batch;
+        complex double *Fmnm, *mn_factors, *fext, *expsmm, *mm_phases;
+        fftw_plan plan;
+    } inverse_direct;
+
+    struct {
+        int ready;
+        int batch;
+        complex double *Fmnm, *mn_factors, *Fmnm_shift;
+        double *fext;
+        fftw_plan plan;
+    } inverse_direct_real;
+
+    // inout (and fft_in, fft_out) hold one buffer per thread. phases
+    // holds the phases of the flmn accumulation (see
+    // so3_plan_setup_flmn_phases).
+    struct {
+        int ready;
+        int batch;
+        complex double *expsmm, *Fmnb, *inout, *Fmnm, *Gmnm, *phases;
+        fftw_plan plan_alpha_gamma, plan_beta;
+    } forward_direct;
+
+    // fft_in_dist is padded to keep the buffers of all threads aligned.
+    struct {
+        int ready;
+        int batch;
+        complex double *expsmm, *Fmnb, *fft_out, *inout, *Fmnm, *Gmnm, *phases;
+        double *fft_in;
+        int fft_in_dist;
+        fftw_plan plan_alpha_gamma, plan_beta;
+    } forward_direct_real;
+};
+
+// Slab of the n blocks of flmn for which the separation-of-variables
+// engine computes a transform: the blocks k_first <= k < k_stop in the
+// storage order of the parameters (see so3_plan_block_n). The flmn
+// passed to the engine start with coefficient flmn_base of the full
+// flmn, and the fn of the slab are stored in consecutive blocks in the
+// order of k.
+typedef struct {
+    int k_first, k_stop;
+    int flmn_base;
+} so3_plan_slab_t;
+
+// FFTs over gamma of a group of signals, see so3_plan.c.
+typedef struct so3_plan_gamma_job so3_plan_gamma_job_t;
+
+int so3_plan_block_n(const so3_parameters_t *parameters, int k);
+
+void so3_plan_setup_sov(so3_plan_t *plan);
+void so3_plan_setup_weights(so3_plan_t *plan);
+int so3_plan_setup_sov_batch(so3_plan_t *plan, int count, int nblocks);
+int so3_plan_sov_nblocks(const so3_parameters_t *parameters, const so3_plan_slab_t *slab, int real);
+
+void so3_plan_sov_inverse(
+    so3_plan_t *plan,
+    complex double *fn, int fn_dist, int fftw_n,
+    const complex double *flmn, int flmn_dist,
+    int count, int real, const so3_plan_slab_t *slab,
+    so3_plan_gamma_job_t *pending
+);
+void so3_plan_sov_forward(
+    so3_plan_t *plan,
+    complex double *flmn, int flmn_dist,
+    const complex double *fn, int fn_dist, int fftw_n,
+    int count, int real, const so3_plan_slab_t *slab,
+    so3_plan_gamma_job_t *pending
+);
+
+#endif
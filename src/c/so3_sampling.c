@@ -646,3 +646,459 @@ void so3_sampling_ind2elmn_real(int *el, int *m, int *n, int ind, const so3_para
         SO3_ERROR_GENERIC("Invalid storage method.");
     }
 }
+
+//============================================================================
+// Reentrant variants
+//============================================================================
+
+// The reentrant variants check their arguments and then call the
+// functions above, whose error branches are thus never taken.
+
+static int so3_sampling_valid_band_limits(const so3_parameters_t *parameters)
+{
+    return parameters->L >= 1 && parameters->N >= 1;
+}
+
+static int so3_sampling_valid_sampling_scheme(const so3_parameters_t *parameters)
+{
+    return (int)parameters->sampling_scheme >= 0
+           && parameters->sampling_scheme < SO3_SAMPLING_SIZE;
+}
+
+static int so3_sampling_valid_storage(const so3_parameters_t *parameters)
+{
+    return (int)parameters->storage >= 0
+           && parameters->storage < SO3_STORAGE_SIZE;
+}
+
+static int so3_sampling_valid_n_order(const so3_parameters_t *parameters)
+{
+    return (int)parameters->n_order >= 0
+           && parameters->n_order < SO3_N_ORDER_SIZE;
+}
+
+/*!
+ * Check all fields of a parameters object.
+ *
+ * \param[in] parameters A parameters object.
+ * \retval status \link SO3_SUCCESS \endlink if all fields are valid,
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink otherwise.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_check_parameters(const so3_parameters_t *parameters)
+{
+    if (!parameters
+        || !so3_sampling_valid_band_limits(parameters)
+        || parameters->L0 < 0 || parameters->L0 >= parameters->L
+        || !so3_sampling_valid_sampling_scheme(parameters)
+        || !so3_sampling_valid_storage(parameters)
+        || !so3_sampling_valid_n_order(parameters)
+        || (int)parameters->n_mode < 0 || parameters->n_mode >= SO3_N_MODE_SIZE
+        || (parameters->dl_method != SSHT_DL_RISBO
+            && parameters->dl_method != SSHT_DL_TRAPANI)
+        || parameters->num_threads < 0)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_weight \endlink.
+ *
+ * \param[out] weight Corresponding conjugate weight.
+ * \param[in] parameters A parameters object with (at least)
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \param[in] p Integer index to compute weight for.
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_weight_r(
+    complex double *weight,
+    const so3_parameters_t *parameters,
+    int p)
+{
+    if (!weight || !parameters || !so3_sampling_valid_sampling_scheme(parameters))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    *weight = so3_sampling_weight(parameters, p);
+
+    return SO3_SUCCESS;
+}
+
+// Shared implementation of the reentrant variants of the functions
+// which return a number of samples.
+static so3_status_t so3_sampling_count_r(
+    int *count,
+    int (*function)(const so3_parameters_t *),
+    const so3_parameters_t *parameters)
+{
+    if (!count || !parameters
+        || !so3_sampling_valid_band_limits(parameters)
+        || !so3_sampling_valid_sampling_scheme(parameters))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    *count = function(parameters);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_f_size \endlink.
+ *
+ * \param[out] size Number of samples stored in the signal buffers.
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_f_size_r(int *size, const so3_parameters_t *parameters)
+{
+    return so3_sampling_count_r(size, so3_sampling_f_size, parameters);
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_n \endlink.
+ *
+ * \param[out] n Number of samples.
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_n_r(int *n, const so3_parameters_t *parameters)
+{
+    return so3_sampling_count_r(n, so3_sampling_n, parameters);
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_nalpha \endlink.
+ *
+ * \param[out] nalpha Number of samples in alpha.
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_nalpha_r(int *nalpha, const so3_parameters_t *parameters)
+{
+    return so3_sampling_count_r(nalpha, so3_sampling_nalpha, parameters);
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_nbeta \endlink.
+ *
+ * \param[out] nbeta Number of samples in beta.
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_nbeta_r(int *nbeta, const so3_parameters_t *parameters)
+{
+    return so3_sampling_count_r(nbeta, so3_sampling_nbeta, parameters);
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_ngamma \endlink.
+ *
+ * \param[out] ngamma Number of samples in gamma.
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_ngamma_r(int *ngamma, const so3_parameters_t *parameters)
+{
+    return so3_sampling_count_r(ngamma, so3_sampling_ngamma, parameters);
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_a2alpha \endlink.
+ *
+ * \param[out] alpha Alpha angle.
+ * \param[in] a Alpha index, in [0 .. nalpha-1].
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_a2alpha_r(double *alpha, int a, const so3_parameters_t *parameters)
+{
+    int nalpha;
+
+    if (!alpha || so3_sampling_nalpha_r(&nalpha, parameters) != SO3_SUCCESS
+        || a < 0 || a >= nalpha)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    *alpha = so3_sampling_a2alpha(a, parameters);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_b2beta \endlink.
+ *
+ * \param[out] beta Beta angle.
+ * \param[in] b Beta index, in [0 .. nbeta-1].
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_b2beta_r(double *beta, int b, const so3_parameters_t *parameters)
+{
+    int nbeta;
+
+    if (!beta || so3_sampling_nbeta_r(&nbeta, parameters) != SO3_SUCCESS
+        || b < 0 || b >= nbeta)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    *beta = so3_sampling_b2beta(b, parameters);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_g2gamma \endlink.
+ *
+ * \param[out] gamma Gamma angle.
+ * \param[in] g Gamma index, in [0 .. ngamma-1].
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::sampling_scheme sampling_scheme\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_g2gamma_r(double *gamma, int g, const so3_parameters_t *parameters)
+{
+    int ngamma;
+
+    if (!gamma || so3_sampling_ngamma_r(&ngamma, parameters) != SO3_SUCCESS
+        || g < 0 || g >= ngamma)
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    *gamma = so3_sampling_g2gamma(g, parameters);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_flmn_size \endlink.
+ *
+ * \param[out] size Number of coefficients to be stored.
+ * \param[in] parameters A parameters object with (at least) the following fields:
+ *                       \link so3_parameters_t::L L\endlink,
+ *                       \link so3_parameters_t::N N\endlink,
+ *                       \link so3_parameters_t::storage storage\endlink,
+ *                       \link so3_parameters_t::reality reality\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_flmn_size_r(int *size, const so3_parameters_t *parameters)
+{
+    if (!size || !parameters
+        || !so3_sampling_valid_band_limits(parameters)
+        || !so3_sampling_valid_storage(parameters))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    *size = so3_sampling_flmn_size(parameters);
+
+    return SO3_SUCCESS;
+}
+
+// Check harmonic indices for a signal (with n >= 0 only if real).
+static int so3_sampling_valid_elmn(int el, int m, int n, const so3_parameters_t *parameters, int real)
+{
+    return el >= 0 && el < parameters->L
+           && abs(m) <= el
+           && abs(n) < parameters->N
+           && (!real || n >= 0)
+           && (parameters->storage != SO3_STORAGE_COMPACT || abs(n) <= el);
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_elmn2ind \endlink.
+ *
+ * \param[out] ind 1D index to access flmn array.
+ * \param[in]  el  Harmonic index.
+ * \param[in]  m   Azimuthal harmonic index.
+ * \param[in]  n   Orientational harmonic index.
+ * \param[in]  parameters A parameters object with (at least) the following fields:
+ *                        \link so3_parameters_t::L L\endlink,
+ *                        \link so3_parameters_t::N N\endlink,
+ *                        \link so3_parameters_t::storage storage\endlink,
+ *                        \link so3_parameters_t::n_order n_order\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink (also for
+ *                indices out of range).
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_elmn2ind_r(int *ind, int el, int m, int n, const so3_parameters_t *parameters)
+{
+    if (!ind || !parameters
+        || !so3_sampling_valid_band_limits(parameters)
+        || !so3_sampling_valid_storage(parameters)
+        || !so3_sampling_valid_n_order(parameters)
+        || !so3_sampling_valid_elmn(el, m, n, parameters, 0))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    so3_sampling_elmn2ind(ind, el, m, n, parameters);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_ind2elmn \endlink.
+ *
+ * \param[out] el  Harmonic index.
+ * \param[out] m   Azimuthal harmonic index.
+ * \param[out] n   Orientational harmonic index.
+ * \param[in]  ind 1D index to access flm array.
+ * \param[in]  parameters A parameters object with (at least) the following fields:
+ *                        \link so3_parameters_t::L L\endlink,
+ *                        \link so3_parameters_t::N N\endlink,
+ *                        \link so3_parameters_t::storage storage\endlink,
+ *                        \link so3_parameters_t::n_order n_order\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink (also for
+ *                an index out of range).
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_ind2elmn_r(int *el, int *m, int *n, int ind, const so3_parameters_t *parameters)
+{
+    so3_parameters_t complex_params;
+
+    if (!el || !m || !n || !parameters
+        || !so3_sampling_valid_band_limits(parameters)
+        || !so3_sampling_valid_storage(parameters)
+        || !so3_sampling_valid_n_order(parameters))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    complex_params = *parameters;
+    complex_params.reality = 0;
+    if (ind < 0 || ind >= so3_sampling_flmn_size(&complex_params))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    so3_sampling_ind2elmn(el, m, n, ind, parameters);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_elmn2ind_real \endlink.
+ *
+ * \param[out] ind 1D index to access flmn array.
+ * \param[in]  el  Harmonic index.
+ * \param[in]  m   Azimuthal harmonic index.
+ * \param[in]  n   Orientational harmonic index (non-negative).
+ * \param[in]  parameters A parameters object with (at least) the following fields:
+ *                        \link so3_parameters_t::L L\endlink,
+ *                        \link so3_parameters_t::N N\endlink,
+ *                        \link so3_parameters_t::storage storage\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink (also for
+ *                indices out of range).
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_elmn2ind_real_r(int *ind, int el, int m, int n, const so3_parameters_t *parameters)
+{
+    if (!ind || !parameters
+        || !so3_sampling_valid_band_limits(parameters)
+        || !so3_sampling_valid_storage(parameters)
+        || !so3_sampling_valid_elmn(el, m, n, parameters, 1))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    so3_sampling_elmn2ind_real(ind, el, m, n, parameters);
+
+    return SO3_SUCCESS;
+}
+
+/*!
+ * Reentrant variant of \link so3_sampling_ind2elmn_real \endlink.
+ *
+ * \param[out] el  Harmonic index.
+ * \param[out] m   Azimuthal harmonic index.
+ * \param[out] n   Orientational harmonic index.
+ * \param[in]  ind 1D index to access flm array.
+ * \param[in]  parameters A parameters object with (at least) the following fields:
+ *                        \link so3_parameters_t::L L\endlink,
+ *                        \link so3_parameters_t::N N\endlink,
+ *                        \link so3_parameters_t::storage storage\endlink
+ * \retval status \link SO3_SUCCESS \endlink or
+ *                \link SO3_ERROR_INVALID_ARGUMENT \endlink (also for
+ *                an index out of range).
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_sampling_ind2elmn_real_r(int *el, int *m, int *n, int ind, const so3_parameters_t *parameters)
+{
+    so3_parameters_t real_params;
+
+    if (!el || !m || !n || !parameters
+        || !so3_sampling_valid_band_limits(parameters)
+        || !so3_sampling_valid_storage(parameters))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    real_params = *parameters;
+    real_params.reality = 1;
+    if (ind < 0 || ind >= so3_sampling_flmn_size(&real_params))
+        return SO3_ERROR_INVALID_ARGUMENT;
+
+    so3_sampling_ind2elmn_real(el, m, n, ind, parameters);
+
+    return SO3_SUCCESS;
+}
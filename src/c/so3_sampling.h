@@ -6,6 +6,7 @@
 #define SO3_SAMPLING
 
 #include "so3_types.h"
+#include "so3_error.h"
 
 complex double so3_sampling_weight(const so3_parameters_t *parameters, int p);
 
@@ -27,4 +28,24 @@ extern inline void so3_sampling_ind2elmn(int *el, int *m, int *n, int ind, const
 extern inline void so3_sampling_elmn2ind_real(int *ind, int el, int m, int n, const so3_parameters_t *parameters);
 extern inline void so3_sampling_ind2elmn_real(int *el, int *m, int *n, int ind, const so3_parameters_t *parameters);
 
+so3_status_t so3_sampling_check_parameters(const so3_parameters_t *parameters);
+
+so3_status_t so3_sampling_weight_r(complex double *weight, const so3_parameters_t *parameters, int p);
+
+so3_status_t so3_sampling_f_size_r(int *size, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_n_r(int *n, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_nalpha_r(int *nalpha, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_nbeta_r(int *nbeta, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_ngamma_r(int *ngamma, const so3_parameters_t *parameters);
+
+so3_status_t so3_sampling_a2alpha_r(double *alpha, int a, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_b2beta_r(double *beta, int b, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_g2gamma_r(double *gamma, int g, const so3_parameters_t *parameters);
+
+so3_status_t so3_sampling_flmn_size_r(int *size, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_elmn2ind_r(int *ind, int el, int m, int n, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_ind2elmn_r(int *el, int *m, int *n, int ind, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_elmn2ind_real_r(int *ind, int el, int m, int n, const so3_parameters_t *parameters);
+so3_status_t so3_sampling_ind2elmn_real_r(int *el, int *m, int *n, int ind, const so3_parameters_t *parameters);
+
 #endif
@@ -0,0 +1,371 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_schedule.c
+ * Work-stealing scheduler for loops whose iterations have a known,
+ * uneven cost, such as the el loops of the direct transforms (the work
+ * per el grows with el) or the n loops of the transforms via SSHT
+ * (blocks of skipped n cost nothing).
+ *
+ * The caller estimates the cost of each iteration. The iterations are
+ * then split into contiguous chunks of roughly equal cost, a few per
+ * thread, and each thread is assigned a contiguous run of chunks of
+ * about the same total cost. Threads execute their own chunks in
+ * order and, once they run out, steal chunks from the end of the runs
+ * of other threads, which evens out any error of the cost model.
+ *
+ * The schedule is driven from within an OpenMP parallel region by all
+ * threads of the team, which the OpenMP runtime keeps alive between
+ * regions, so no threads are created per loop.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+
+#include "so3_error.h"
+#include "so3_schedule.h"
+
+// Number of chunks per thread. More chunks balance better, but each
+// chunk requires a (possibly contended) lock.
+#define SO3_SCHEDULE_CHUNKS_PER_THREAD 4
+
+// Run of chunks [head, tail) owned by a thread. The owner takes chunks
+// from the head, thieves from the tail. Padded to a cache line, since
+// every thread updates its own queue.
+typedef struct {
+    omp_lock_t lock;
+    int head, tail;
+    // Start time of the chunk the thread is executing, or negative.
+    double chunk_start;
+    so3_schedule_stats_t stats;
+    char padding[64];
+} so3_schedule_queue_t;
+
+struct so3_schedule {
+    int nthreads;
+    so3_schedule_queue_t *queues;
+
+    // Estimated cost of each of count iterations.
+    double *cost;
+    int count, cost_size;
+
+    // Chunk c covers the iterations [chunk_first[c], chunk_first[c+1]).
+    int *chunk_first;
+    int nchunks;
+
+    // Number of threads still working on the current loop and its
+    // start time.
+    int active;
+    double start;
+};
+
+/*!
+ * Create a schedule for a team of threads.
+ *
+ * \param[in]  nthreads Number of threads which execute the loops.
+ * \retval schedule Newly created schedule, or NULL if memory allocation
+ *                  failed. Release with \link so3_schedule_destroy
+ *                  \endlink.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_schedule_t *so3_schedule_create(int nthreads)
+{
+    so3_schedule_t *schedule;
+    int t;
+
+    schedule = calloc(1, sizeof *schedule);
+    if (!schedule)
+        return NULL;
+
+    schedule->queues = calloc(nthreads, sizeof *schedule->queues);
+    schedule->chunk_first = calloc(nthreads*SO3_SCHEDULE_CHUNKS_PER_THREAD + 1,
+                                   sizeof *schedule->chunk_first);
+    if (!schedule->queues || !schedule->chunk_first)
+    {
+        so3_schedule_destroy(schedule);
+        return NULL;
+    }
+
+    schedule->nthreads = nthreads;
+    for (t = 0; t < nthreads; ++t)
+    {
+        omp_init_lock(&schedule->queues[t].lock);
+        schedule->queues[t].chunk_start = -1.0;
+    }
+
+    return schedule;
+}
+
+/*!
+ * Release a schedule.
+ *
+ * \param[in]  schedule Schedule to release. May be NULL.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_schedule_destroy(so3_schedule_t *schedule)
+{
+    int t;
+
+    if (!schedule)
+        return;
+
+    for (t = 0; t < schedule->nthreads; ++t)
+        omp_destroy_lock(&schedule->queues[t].lock);
+
+    free(schedule->queues);
+    free(schedule->cost);
+    free(schedule->chunk_first);
+    free(schedule);
+}
+
+/*!
+ * Allocate room for the costs of loops of up to count iterations, such
+ * that \link so3_schedule_costs \endlink does not allocate memory.
+ *
+ * \param[in]  schedule Schedule.
+ * \param[in]  count Maximum number of iterations of the loops.
+ * \retval success 1 on success, 0 if memory allocation failed.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_schedule_reserve(so3_schedule_t *schedule, int count)
+{
+    double *cost;
+
+    if (count <= schedule->cost_size)
+        return 1;
+
+    cost = calloc(count, sizeof *cost);
+    if (!cost)
+        return 0;
+
+    free(schedule->cost);
+    schedule->cost = cost;
+    schedule->cost_size = count;
+
+    return 1;
+}
+
+/*!
+ * Start setting up a loop of count iterations. The estimated cost of
+ * each iteration has to be stored in the returned array before calling
+ * \link so3_schedule_partition \endlink. Only the relative size of the
+ * costs matters. Must be called by a single thread.
+ *
+ * \param[in]  schedule Schedule.
+ * \param[in]  count Number of iterations of the loop.
+ * \retval cost Array of count costs, owned by the schedule.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+double *so3_schedule_costs(so3_schedule_t *schedule, int count)
+{
+    if (!so3_schedule_reserve(schedule, count))
+        SO3_ERROR_GENERIC("Memory allocation failed");
+    schedule->count = count;
+
+    return schedule->cost;
+}
+
+/*!
+ * Split the loop set up with \link so3_schedule_costs \endlink into
+ * chunks and assign them to the threads. Must be called by a single
+ * thread, and all threads have to wait for it to finish (e.g. at the
+ * implicit barrier of an omp single construct) before calling
+ * \link so3_schedule_next \endlink.
+ *
+ * \param[in]  schedule Schedule.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_schedule_partition(so3_schedule_t *schedule)
+{
+    int nthreads = schedule->nthreads;
+    int count = schedule->count;
+    double *cost = schedule->cost;
+    int *chunk_first = schedule->chunk_first;
+    int max_chunks = nthreads*SO3_SCHEDULE_CHUNKS_PER_THREAD;
+    double total, target, sum;
+    int i, c, t;
+
+    total = 0.0;
+    for (i = 0; i < count; ++i)
+        total += cost[i];
+
+    // Chunks of about equal cost. An iteration which is more expensive
+    // than that forms a chunk of its own.
+    target = total / max_chunks;
+    c = 0;
+    chunk_first[0] = 0;
+    sum = 0.0;
+    for (i = 0; i < count; ++i)
+    {
+        sum += cost[i];
+        if (sum >= target && c < max_chunks-1 && i < count-1)
+        {
+            chunk_first[++c] = i+1;
+            sum = 0.0;
+        }
+    }
+    if (count > 0)
+        ++c;
+    chunk_first[c] = count;
+    schedule->nchunks = c;
+
+    // Assign each thread the chunks whose cost midpoints fall into its
+    // share of the total cost.
+    t = 0;
+    sum = 0.0;
+    schedule->queues[0].head = 0;
+    for (c = 0; c < schedule->nchunks; ++c)
+    {
+        double chunk_cost = 0.0;
+        for (i = chunk_first[c]; i < chunk_first[c+1]; ++i)
+            chunk_cost += cost[i];
+
+        while (t < nthreads-1 && sum + 0.5*chunk_cost > (t+1)*total/nthreads)
+        {
+            schedule->queues[t].tail = c;
+            schedule->queues[++t].head = c;
+        }
+        sum += chunk_cost;
+    }
+    schedule->queues[t].tail = schedule->nchunks;
+    for (++t; t < nthreads; ++t)
+        schedule->queues[t].head = schedule->queues[t].tail = schedule->nchunks;
+
+    // The team may be smaller than nthreads, e.g. if the loop runs
+    // within a parallel region of the caller, in which case the missing
+    // threads' chunks are stolen.
+    schedule->active = omp_get_num_threads();
+    schedule->start = omp_get_wtime();
+}
+
+/*!
+ * Get the next chunk of iterations for a thread. Each thread of the
+ * team has to call this until it returns 0.
+ *
+ * \param[in]  schedule Schedule.
+ * \param[in]  thread Number of the calling thread in the team.
+ * \param[out] first First iteration of the chunk.
+ * \param[out] last One past the last iteration of the chunk.
+ * \retval more 1 if a chunk was returned, 0 if the loop is done.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_schedule_next(so3_schedule_t *schedule, int thread, int *first, int *last)
+{
+    int nthreads = schedule->nthreads;
+    so3_schedule_queue_t *own = &schedule->queues[thread];
+    double now = omp_get_wtime();
+    int c = -1, stolen = 0, active, t;
+
+    if (own->chunk_start >= 0.0)
+        own->stats.busy += now - own->chunk_start;
+
+    omp_set_lock(&own->lock);
+    if (own->head < own->tail)
+        c = own->head++;
+    omp_unset_lock(&own->lock);
+
+    // Steal from the end of the run of another thread.
+    for (t = 1; c < 0 && t < nthreads; ++t)
+    {
+        so3_schedule_queue_t *victim = &schedule->queues[(thread + t) % nthreads];
+
+        omp_set_lock(&victim->lock);
+        if (victim->head < victim->tail)
+        {
+            c = --victim->tail;
+            stolen = 1;
+        }
+        omp_unset_lock(&victim->lock);
+    }
+
+    if (c < 0)
+    {
+        own->chunk_start = -1.0;
+
+        // The last thread to finish accounts the wall time of the loop.
+        #pragma omp atomic capture
+        active = --schedule->active;
+        if (active == 0)
+        {
+            double wall = omp_get_wtime() - schedule->start;
+            for (t = 0; t < nthreads; ++t)
+                schedule->queues[t].stats.wall += wall;
+        }
+
+        return 0;
+    }
+
+    *first = schedule->chunk_first[c];
+    *last = schedule->chunk_first[c+1];
+    own->stats.chunks++;
+    own->stats.stolen += stolen;
+    own->chunk_start = omp_get_wtime();
+
+    return 1;
+}
+
+/*!
+ * Get the utilisation statistics of all threads, accumulated since the
+ * schedule was created or last reset.
+ *
+ * \param[in]  schedule Schedule.
+ * \param[out] stats Statistics, one entry per thread. Provide an array
+ *                   of at least as many entries as there are threads,
+ *                   or NULL to query their number.
+ * \retval nthreads Number of threads.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_schedule_get_stats(const so3_schedule_t *schedule, so3_schedule_stats_t *stats)
+{
+    int t;
+
+    if (stats)
+        for (t = 0; t < schedule->nthreads; ++t)
+            stats[t] = schedule->queues[t].stats;
+
+    return schedule->nthreads;
+}
+
+/*!
+ * Reset the utilisation statistics of all threads.
+ *
+ * \param[in]  schedule Schedule.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_schedule_reset_stats(so3_schedule_t *schedule)
+{
+    int t;
+
+    for (t = 0; t < schedule->nthreads; ++t)
+    {
+        schedule->queues[t].stats.busy = 0.0;
+        schedule->queues[t].stats.wall = 0.0;
+        schedule->queues[t].stats.chunks = 0;
+        schedule->queues[t].stats.stolen = 0;
+    }
+}
@@ -0,0 +1,47 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_schedule.h
+ *  Cost-model-driven work-stealing scheduler for the parallel loops of
+ *  the transforms, and the per-thread utilisation statistics it keeps.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_SCHEDULE
+#define SO3_SCHEDULE
+
+/*!
+ * Utilisation statistics of one thread, accumulated over all loops
+ * executed with a schedule. busy/wall is the utilisation of the thread.
+ */
+typedef struct {
+    /*! Time in seconds spent executing chunks of work. */
+    double busy;
+    /*! Time in seconds spent in scheduled loops, including idle time. */
+    double wall;
+    /*! Number of chunks executed. */
+    int chunks;
+    /*! Number of these chunks which were stolen from other threads. */
+    int stolen;
+} so3_schedule_stats_t;
+
+/*!
+ * Opaque scheduler for a fixed team of threads.
+ */
+typedef struct so3_schedule so3_schedule_t;
+
+so3_schedule_t *so3_schedule_create(int nthreads);
+void so3_schedule_destroy(so3_schedule_t *schedule);
+
+int so3_schedule_reserve(so3_schedule_t *schedule, int count);
+double *so3_schedule_costs(so3_schedule_t *schedule, int count);
+void so3_schedule_partition(so3_schedule_t *schedule);
+int so3_schedule_next(so3_schedule_t *schedule, int thread, int *first, int *last);
+
+int so3_schedule_get_stats(const so3_schedule_t *schedule, so3_schedule_stats_t *stats);
+void so3_schedule_reset_stats(so3_schedule_t *schedule);
+
+#endif
@@ -0,0 +1,800 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_simd.c
+ * Vectorised kernels of the innermost loops of the transforms. Each
+ * kernel is compiled for several instruction sets with function-level
+ * target attributes, so the library itself does not require any
+ * particular processor. When the library is loaded, the best
+ * instruction set supported by the processor is selected, unless the
+ * environment variable \link SO3_SIMD_ENV \endlink names another one.
+ *
+ * The kernels scale complex values by real factors (Wigner symbols and
+ * signs). Multiplying both halves of a complex value by the same real
+ * number does not mix them, so the kernels work on the interleaved
+ * complex arrays directly, with each real factor duplicated into the
+ * real and imaginary lanes, rather than splitting the data into real
+ * and imaginary registers and merging it again.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <complex.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "so3_simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SO3_SIMD_X86
+#include <immintrin.h>
+#endif
+
+typedef void (*so3_simd_fmnm_kernel_t)(
+    complex double *, const complex double *, const double *,
+    int, double, double
+);
+
+typedef void (*so3_simd_flmn_kernel_t)(
+    complex double *, const complex double *, const complex double *,
+    const double *, int, double, double
+);
+
+typedef void (*so3_simd_flmn_split_kernel_t)(
+    double *, double *, const complex double *, const complex double *,
+    const double *, int, double, double
+);
+
+typedef void (*so3_simd_scale_kernel_t)(
+    complex double *, const complex double *, complex double, int
+);
+
+typedef void (*so3_simd_modulate_kernel_t)(
+    complex double *, const complex double *, const complex double *,
+    double, int
+);
+
+static const char *so3_simd_isa_names[SO3_SIMD_SIZE] = {
+    "scalar", "avx2", "avx512"
+};
+
+// The selected instruction set, or -1 before the first use.
+static int so3_simd_isa = -1;
+
+//============================================================================
+// Fmnm' accumulation
+//============================================================================
+
+static void so3_simd_accumulate_fmnm_scalar(
+    complex double *Fmnm, const complex double *mn_factors, const double *dl,
+    int el, double neg_factor, double pos_factor
+) {
+    int m;
+
+    for (m = 1; m <= el; ++m)
+        Fmnm[-m] += neg_factor * dl[m] * mn_factors[-m];
+    for (m = 0; m <= el; ++m)
+        Fmnm[m] += pos_factor * dl[m] * mn_factors[m];
+}
+
+#ifdef SO3_SIMD_X86
+
+__attribute__((target("avx2,fma")))
+static void so3_simd_accumulate_fmnm_avx2(
+    complex double *Fmnm, const complex double *mn_factors, const double *dl,
+    int el, double neg_factor, double pos_factor
+) {
+    double *F = (double *)Fmnm;
+    const double *x = (const double *)mn_factors;
+    __m256d neg = _mm256_set1_pd(neg_factor);
+    __m256d pos = _mm256_set1_pd(pos_factor);
+    int m;
+
+    // m < 0: the values of m-1 and m lie at ascending addresses, but
+    // their Wigner symbols dl[|m|+1] and dl[|m|] at descending ones, so
+    // the symbols are loaded in reverse.
+    for (m = 1; m+1 <= el; m += 2)
+    {
+        __m256d d = _mm256_permute4x64_pd(_mm256_castpd128_pd256(_mm_loadu_pd(dl + m)), 0x05);
+        __m256d f = _mm256_loadu_pd(F - 2*(m+1));
+
+        f = _mm256_fmadd_pd(_mm256_mul_pd(neg, d), _mm256_loadu_pd(x - 2*(m+1)), f);
+        _mm256_storeu_pd(F - 2*(m+1), f);
+    }
+    for (; m <= el; ++m)
+        Fmnm[-m] += neg_factor * dl[m] * mn_factors[-m];
+
+    for (m = 0; m+1 <= el; m += 2)
+    {
+        __m256d d = _mm256_permute4x64_pd(_mm256_castpd128_pd256(_mm_loadu_pd(dl + m)), 0x50);
+        __m256d f = _mm256_loadu_pd(F + 2*m);
+
+        f = _mm256_fmadd_pd(_mm256_mul_pd(pos, d), _mm256_loadu_pd(x + 2*m), f);
+        _mm256_storeu_pd(F + 2*m, f);
+    }
+    for (; m <= el; ++m)
+        Fmnm[m] += pos_factor * dl[m] * mn_factors[m];
+}
+
+__attribute__((target("avx512f")))
+static void so3_simd_accumulate_fmnm_avx512(
+    complex double *Fmnm, const complex double *mn_factors, const double *dl,
+    int el, double neg_factor, double pos_factor
+) {
+    double *F = (double *)Fmnm;
+    const double *x = (const double *)mn_factors;
+    __m512d neg = _mm512_set1_pd(neg_factor);
+    __m512d pos = _mm512_set1_pd(pos_factor);
+    // Lane indices which duplicate four symbols, in reverse for m < 0.
+    __m512i reversed = _mm512_set_epi64(0, 0, 1, 1, 2, 2, 3, 3);
+    __m512i forward = _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0);
+    int m;
+
+    for (m = 1; m+3 <= el; m += 4)
+    {
+        __m512d d = _mm512_permutexvar_pd(reversed, _mm512_castpd256_pd512(_mm256_loadu_pd(dl + m)));
+        __m512d f = _mm512_loadu_pd(F - 2*(m+3));
+
+        f = _mm512_fmadd_pd(_mm512_mul_pd(neg, d), _mm512_loadu_pd(x - 2*(m+3)), f);
+        _mm512_storeu_pd(F - 2*(m+3), f);
+    }
+    for (; m <= el; ++m)
+        Fmnm[-m] += neg_factor * dl[m] * mn_factors[-m];
+
+    for (m = 0; m+3 <= el; m += 4)
+    {
+        __m512d d = _mm512_permutexvar_pd(forward, _mm512_castpd256_pd512(_mm256_loadu_pd(dl + m)));
+        __m512d f = _mm512_loadu_pd(F + 2*m);
+
+        f = _mm512_fmadd_pd(_mm512_mul_pd(pos, d), _mm512_loadu_pd(x + 2*m), f);
+        _mm512_storeu_pd(F + 2*m, f);
+    }
+    for (; m <= el; ++m)
+        Fmnm[m] += pos_factor * dl[m] * mn_factors[m];
+}
+
+#endif
+
+static const so3_simd_fmnm_kernel_t so3_simd_fmnm_kernels[SO3_SIMD_SIZE] = {
+    so3_simd_accumulate_fmnm_scalar,
+#ifdef SO3_SIMD_X86
+    so3_simd_accumulate_fmnm_avx2,
+    so3_simd_accumulate_fmnm_avx512
+#endif
+};
+
+//============================================================================
+// flmn accumulation
+//============================================================================
+
+static void so3_simd_accumulate_flmn_scalar(
+    complex double *flmn, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+) {
+    int m;
+
+    for (m = 1; m <= el; ++m)
+        flmn[-m] += neg_factor * dl[m] * phases[-m] * Gmnm[-m];
+    for (m = 0; m <= el; ++m)
+        flmn[m] += pos_factor * dl[m] * phases[m] * Gmnm[m];
+}
+
+#ifdef SO3_SIMD_X86
+
+// Products of two pairs of interleaved complex values.
+__attribute__((target("avx2,fma")))
+static inline __m256d so3_simd_cmul_avx2(__m256d a, __m256d b)
+{
+    return _mm256_fmaddsub_pd(
+        a, _mm256_movedup_pd(b),
+        _mm256_mul_pd(_mm256_permute_pd(a, 0x5), _mm256_permute_pd(b, 0xF))
+    );
+}
+
+__attribute__((target("avx2,fma")))
+static void so3_simd_accumulate_flmn_avx2(
+    complex double *flmn, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+) {
+    double *F = (double *)flmn;
+    const double *g = (const double *)Gmnm;
+    const double *p = (const double *)phases;
+    __m256d neg = _mm256_set1_pd(neg_factor);
+    __m256d pos = _mm256_set1_pd(pos_factor);
+    int m;
+
+    for (m = 1; m+1 <= el; m += 2)
+    {
+        __m256d d = _mm256_permute4x64_pd(_mm256_castpd128_pd256(_mm_loadu_pd(dl + m)), 0x05);
+        __m256d gp = so3_simd_cmul_avx2(_mm256_loadu_pd(g - 2*(m+1)), _mm256_loadu_pd(p - 2*(m+1)));
+        __m256d f = _mm256_loadu_pd(F - 2*(m+1));
+
+        f = _mm256_fmadd_pd(_mm256_mul_pd(neg, d), gp, f);
+        _mm256_storeu_pd(F - 2*(m+1), f);
+    }
+    for (; m <= el; ++m)
+        flmn[-m] += neg_factor * dl[m] * phases[-m] * Gmnm[-m];
+
+    for (m = 0; m+1 <= el; m += 2)
+    {
+        __m256d d = _mm256_permute4x64_pd(_mm256_castpd128_pd256(_mm_loadu_pd(dl + m)), 0x50);
+        __m256d gp = so3_simd_cmul_avx2(_mm256_loadu_pd(g + 2*m), _mm256_loadu_pd(p + 2*m));
+        __m256d f = _mm256_loadu_pd(F + 2*m);
+
+        f = _mm256_fmadd_pd(_mm256_mul_pd(pos, d), gp, f);
+        _mm256_storeu_pd(F + 2*m, f);
+    }
+    for (; m <= el; ++m)
+        flmn[m] += pos_factor * dl[m] * phases[m] * Gmnm[m];
+}
+
+// Products of four pairs of interleaved complex values.
+__attribute__((target("avx512f")))
+static inline __m512d so3_simd_cmul_avx512(__m512d a, __m512d b)
+{
+    return _mm512_fmaddsub_pd(
+        a, _mm512_movedup_pd(b),
+        _mm512_mul_pd(_mm512_permute_pd(a, 0x55), _mm512_permute_pd(b, 0xFF))
+    );
+}
+
+__attribute__((target("avx512f")))
+static void so3_simd_accumulate_flmn_avx512(
+    complex double *flmn, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+) {
+    double *F = (double *)flmn;
+    const double *g = (const double *)Gmnm;
+    const double *p = (const double *)phases;
+    __m512d neg = _mm512_set1_pd(neg_factor);
+    __m512d pos = _mm512_set1_pd(pos_factor);
+    __m512i reversed = _mm512_set_epi64(0, 0, 1, 1, 2, 2, 3, 3);
+    __m512i forward = _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0);
+    int m;
+
+    for (m = 1; m+3 <= el; m += 4)
+    {
+        __m512d d = _mm512_permutexvar_pd(reversed, _mm512_castpd256_pd512(_mm256_loadu_pd(dl + m)));
+        __m512d gp = so3_simd_cmul_avx512(_mm512_loadu_pd(g - 2*(m+3)), _mm512_loadu_pd(p - 2*(m+3)));
+        __m512d f = _mm512_loadu_pd(F - 2*(m+3));
+
+        f = _mm512_fmadd_pd(_mm512_mul_pd(neg, d), gp, f);
+        _mm512_storeu_pd(F - 2*(m+3), f);
+    }
+    for (; m <= el; ++m)
+        flmn[-m] += neg_factor * dl[m] * phases[-m] * Gmnm[-m];
+
+    for (m = 0; m+3 <= el; m += 4)
+    {
+        __m512d d = _mm512_permutexvar_pd(forward, _mm512_castpd256_pd512(_mm256_loadu_pd(dl + m)));
+        __m512d gp = so3_simd_cmul_avx512(_mm512_loadu_pd(g + 2*m), _mm512_loadu_pd(p + 2*m));
+        __m512d f = _mm512_loadu_pd(F + 2*m);
+
+        f = _mm512_fmadd_pd(_mm512_mul_pd(pos, d), gp, f);
+        _mm512_storeu_pd(F + 2*m, f);
+    }
+    for (; m <= el; ++m)
+        flmn[m] += pos_factor * dl[m] * phases[m] * Gmnm[m];
+}
+
+#endif
+
+static const so3_simd_flmn_kernel_t so3_simd_flmn_kernels[SO3_SIMD_SIZE] = {
+    so3_simd_accumulate_flmn_scalar,
+#ifdef SO3_SIMD_X86
+    so3_simd_accumulate_flmn_avx2,
+    so3_simd_accumulate_flmn_avx512
+#endif
+};
+
+//============================================================================
+// flmn accumulation into split real and imaginary parts
+//============================================================================
+
+static void so3_simd_accumulate_flmn_split_scalar(
+    double *flmn_re, double *flmn_im, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+) {
+    complex double z;
+    int m;
+
+    for (m = 1; m <= el; ++m)
+    {
+        z = neg_factor * dl[m] * phases[-m] * Gmnm[-m];
+        flmn_re[-m] += creal(z);
+        flmn_im[-m] += cimag(z);
+    }
+    for (m = 0; m <= el; ++m)
+    {
+        z = pos_factor * dl[m] * phases[m] * Gmnm[m];
+        flmn_re[m] += creal(z);
+        flmn_im[m] += cimag(z);
+    }
+}
+
+#ifdef SO3_SIMD_X86
+
+// The products are computed on interleaved pairs as in the flmn
+// kernels, and the real and imaginary parts of four of them are then
+// gathered into one register each. The Wigner symbols are not
+// duplicated.
+__attribute__((target("avx2,fma")))
+static void so3_simd_accumulate_flmn_split_avx2(
+    double *flmn_re, double *flmn_im, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+) {
+    const double *g = (const double *)Gmnm;
+    const double *p = (const double *)phases;
+    __m256d neg = _mm256_set1_pd(neg_factor);
+    __m256d pos = _mm256_set1_pd(pos_factor);
+    complex double z;
+    int m;
+
+    for (m = 1; m+3 <= el; m += 4)
+    {
+        __m256d d = _mm256_permute4x64_pd(_mm256_loadu_pd(dl + m), 0x1B);
+        __m256d lo = so3_simd_cmul_avx2(_mm256_loadu_pd(g - 2*(m+3)), _mm256_loadu_pd(p - 2*(m+3)));
+        __m256d hi = so3_simd_cmul_avx2(_mm256_loadu_pd(g - 2*(m+1)), _mm256_loadu_pd(p - 2*(m+1)));
+        __m256d re = _mm256_permute4x64_pd(_mm256_unpacklo_pd(lo, hi), 0xD8);
+        __m256d im = _mm256_permute4x64_pd(_mm256_unpackhi_pd(lo, hi), 0xD8);
+
+        d = _mm256_mul_pd(neg, d);
+        _mm256_storeu_pd(flmn_re - (m+3), _mm256_fmadd_pd(d, re, _mm256_loadu_pd(flmn_re - (m+3))));
+        _mm256_storeu_pd(flmn_im - (m+3), _mm256_fmadd_pd(d, im, _mm256_loadu_pd(flmn_im - (m+3))));
+    }
+    for (; m <= el; ++m)
+    {
+        z = neg_factor * dl[m] * phases[-m] * Gmnm[-m];
+        flmn_re[-m] += creal(z);
+        flmn_im[-m] += cimag(z);
+    }
+
+    for (m = 0; m+3 <= el; m += 4)
+    {
+        __m256d d = _mm256_mul_pd(pos, _mm256_loadu_pd(dl + m));
+        __m256d lo = so3_simd_cmul_avx2(_mm256_loadu_pd(g + 2*m), _mm256_loadu_pd(p + 2*m));
+        __m256d hi = so3_simd_cmul_avx2(_mm256_loadu_pd(g + 2*(m+2)), _mm256_loadu_pd(p + 2*(m+2)));
+        __m256d re = _mm256_permute4x64_pd(_mm256_unpacklo_pd(lo, hi), 0xD8);
+        __m256d im = _mm256_permute4x64_pd(_mm256_unpackhi_pd(lo, hi), 0xD8);
+
+        _mm256_storeu_pd(flmn_re + m, _mm256_fmadd_pd(d, re, _mm256_loadu_pd(flmn_re + m)));
+        _mm256_storeu_pd(flmn_im + m, _mm256_fmadd_pd(d, im, _mm256_loadu_pd(flmn_im + m)));
+    }
+    for (; m <= el; ++m)
+    {
+        z = pos_factor * dl[m] * phases[m] * Gmnm[m];
+        flmn_re[m] += creal(z);
+        flmn_im[m] += cimag(z);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void so3_simd_accumulate_flmn_split_avx512(
+    double *flmn_re, double *flmn_im, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+) {
+    const double *g = (const double *)Gmnm;
+    const double *p = (const double *)phases;
+    __m512d neg = _mm512_set1_pd(neg_factor);
+    __m512d pos = _mm512_set1_pd(pos_factor);
+    __m512i reversed = _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    __m512i even = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+    __m512i odd = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+    complex double z;
+    int m;
+
+    for (m = 1; m+7 <= el; m += 8)
+    {
+        __m512d d = _mm512_permutexvar_pd(reversed, _mm512_loadu_pd(dl + m));
+        __m512d lo = so3_simd_cmul_avx512(_mm512_loadu_pd(g - 2*(m+7)), _mm512_loadu_pd(p - 2*(m+7)));
+        __m512d hi = so3_simd_cmul_avx512(_mm512_loadu_pd(g - 2*(m+3)), _mm512_loadu_pd(p - 2*(m+3)));
+
+        d = _mm512_mul_pd(neg, d);
+        _mm512_storeu_pd(flmn_re - (m+7), _mm512_fmadd_pd(d, _mm512_permutex2var_pd(lo, even, hi),
+                                                          _mm512_loadu_pd(flmn_re - (m+7))));
+        _mm512_storeu_pd(flmn_im - (m+7), _mm512_fmadd_pd(d, _mm512_permutex2var_pd(lo, odd, hi),
+                                                          _mm512_loadu_pd(flmn_im - (m+7))));
+    }
+    for (; m <= el; ++m)
+    {
+        z = neg_factor * dl[m] * phases[-m] * Gmnm[-m];
+        flmn_re[-m] += creal(z);
+        flmn_im[-m] += cimag(z);
+    }
+
+    for (m = 0; m+7 <= el; m += 8)
+    {
+        __m512d d = _mm512_mul_pd(pos, _mm512_loadu_pd(dl + m));
+        __m512d lo = so3_simd_cmul_avx512(_mm512_loadu_pd(g + 2*m), _mm512_loadu_pd(p + 2*m));
+        __m512d hi = so3_simd_cmul_avx512(_mm512_loadu_pd(g + 2*(m+4)), _mm512_loadu_pd(p + 2*(m+4)));
+
+        _mm512_storeu_pd(flmn_re + m, _mm512_fmadd_pd(d, _mm512_permutex2var_pd(lo, even, hi),
+                                                      _mm512_loadu_pd(flmn_re + m)));
+        _mm512_storeu_pd(flmn_im + m, _mm512_fmadd_pd(d, _mm512_permutex2var_pd(lo, odd, hi),
+                                                      _mm512_loadu_pd(flmn_im + m)));
+    }
+    for (; m <= el; ++m)
+    {
+        z = pos_factor * dl[m] * phases[m] * Gmnm[m];
+        flmn_re[m] += creal(z);
+        flmn_im[m] += cimag(z);
+    }
+}
+
+#endif
+
+static const so3_simd_flmn_split_kernel_t so3_simd_flmn_split_kernels[SO3_SIMD_SIZE] = {
+    so3_simd_accumulate_flmn_split_scalar,
+#ifdef SO3_SIMD_X86
+    so3_simd_accumulate_flmn_split_avx2,
+    so3_simd_accumulate_flmn_split_avx512
+#endif
+};
+
+//============================================================================
+// Phase modulation and normalisation
+//============================================================================
+
+static void so3_simd_scale_scalar(
+    complex double *out, const complex double *in, complex double factor, int count
+) {
+    int i;
+
+    for (i = 0; i < count; ++i)
+        out[i] = factor * in[i];
+}
+
+static void so3_simd_modulate_scalar(
+    complex double *out, const complex double *in, const complex double *phases,
+    double factor, int count
+) {
+    int i;
+
+    for (i = 0; i < count; ++i)
+        out[i] = in[i] * factor * phases[i];
+}
+
+#ifdef SO3_SIMD_X86
+
+__attribute__((target("avx2,fma")))
+static void so3_simd_scale_avx2(
+    complex double *out, const complex double *in, complex double factor, int count
+) {
+    __m256d c = _mm256_setr_pd(creal(factor), cimag(factor), creal(factor), cimag(factor));
+    int i;
+
+    for (i = 0; i+1 < count; i += 2)
+        _mm256_storeu_pd((double *)(out + i),
+                         so3_simd_cmul_avx2(_mm256_loadu_pd((const double *)(in + i)), c));
+    for (; i < count; ++i)
+        out[i] = factor * in[i];
+}
+
+__attribute__((target("avx2,fma")))
+static void so3_simd_modulate_avx2(
+    complex double *out, const complex double *in, const complex double *phases,
+    double factor, int count
+) {
+    __m256d r = _mm256_set1_pd(factor);
+    int i;
+
+    for (i = 0; i+1 < count; i += 2)
+    {
+        __m256d x = _mm256_mul_pd(r, _mm256_loadu_pd((const double *)(in + i)));
+
+        _mm256_storeu_pd((double *)(out + i),
+                         so3_simd_cmul_avx2(x, _mm256_loadu_pd((const double *)(phases + i))));
+    }
+    for (; i < count; ++i)
+        out[i] = in[i] * factor * phases[i];
+}
+
+__attribute__((target("avx512f")))
+static void so3_simd_scale_avx512(
+    complex double *out, const complex double *in, complex double factor, int count
+) {
+    __m512d c = _mm512_setr_pd(creal(factor), cimag(factor), creal(factor), cimag(factor),
+                               creal(factor), cimag(factor), creal(factor), cimag(factor));
+    int i;
+
+    for (i = 0; i+3 < count; i += 4)
+        _mm512_storeu_pd((double *)(out + i),
+                         so3_simd_cmul_avx512(_mm512_loadu_pd((const double *)(in + i)), c));
+    for (; i < count; ++i)
+        out[i] = factor * in[i];
+}
+
+__attribute__((target("avx512f")))
+static void so3_simd_modulate_avx512(
+    complex double *out, const complex double *in, const complex double *phases,
+    double factor, int count
+) {
+    __m512d r = _mm512_set1_pd(factor);
+    int i;
+
+    for (i = 0; i+3 < count; i += 4)
+    {
+        __m512d x = _mm512_mul_pd(r, _mm512_loadu_pd((const double *)(in + i)));
+
+        _mm512_storeu_pd((double *)(out + i),
+                         so3_simd_cmul_avx512(x, _mm512_loadu_pd((const double *)(phases + i))));
+    }
+    for (; i < count; ++i)
+        out[i] = in[i] * factor * phases[i];
+}
+
+#endif
+
+static const so3_simd_scale_kernel_t so3_simd_scale_kernels[SO3_SIMD_SIZE] = {
+    so3_simd_scale_scalar,
+#ifdef SO3_SIMD_X86
+    so3_simd_scale_avx2,
+    so3_simd_scale_avx512
+#endif
+};
+
+static const so3_simd_modulate_kernel_t so3_simd_modulate_kernels[SO3_SIMD_SIZE] = {
+    so3_simd_modulate_scalar,
+#ifdef SO3_SIMD_X86
+    so3_simd_modulate_avx2,
+    so3_simd_modulate_avx512
+#endif
+};
+
+//============================================================================
+// Selection
+//============================================================================
+
+/*!
+ * Check whether the library and the processor support an instruction
+ * set.
+ *
+ * \param[in]  isa Instruction set.
+ * \retval supported 1 if the kernels for isa can be used, 0 otherwise.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_simd_supported(so3_simd_isa_t isa)
+{
+#ifdef SO3_SIMD_X86
+    // Required before the CPU is queried from a constructor, which may
+    // run before the one of libgcc that would otherwise do this.
+    __builtin_cpu_init();
+#endif
+
+    switch (isa)
+    {
+    case SO3_SIMD_SCALAR:
+        return 1;
+#ifdef SO3_SIMD_X86
+    case SO3_SIMD_AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case SO3_SIMD_AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return 0;
+    }
+}
+
+/*!
+ * Get the name of an instruction set, as accepted in \link SO3_SIMD_ENV
+ * \endlink.
+ *
+ * \param[in]  isa Instruction set.
+ * \retval name Name of isa, or NULL if isa is invalid.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+const char *so3_simd_isa_name(so3_simd_isa_t isa)
+{
+    if ((int)isa < 0 || isa >= SO3_SIMD_SIZE)
+        return NULL;
+
+    return so3_simd_isa_names[isa];
+}
+
+// The instruction set named in the environment if it is supported, or
+// the best supported one.
+static int so3_simd_default_isa()
+{
+    const char *name = getenv(SO3_SIMD_ENV);
+    int isa;
+
+    if (name)
+        for (isa = 0; isa < SO3_SIMD_SIZE; ++isa)
+            if (!strcmp(name, so3_simd_isa_names[isa]) && so3_simd_supported(isa))
+                return isa;
+
+    for (isa = SO3_SIMD_SIZE-1; isa > SO3_SIMD_SCALAR; --isa)
+        if (so3_simd_supported(isa))
+            break;
+
+    return isa;
+}
+
+// Select the instruction set when the library is loaded, so that the
+// environment is read before any transform runs.
+__attribute__((constructor))
+static void so3_simd_init()
+{
+    if (__atomic_load_n(&so3_simd_isa, __ATOMIC_RELAXED) < 0)
+        __atomic_store_n(&so3_simd_isa, so3_simd_default_isa(), __ATOMIC_RELAXED);
+}
+
+/*!
+ * Get the instruction set used by the kernels. This is the one named in
+ * \link SO3_SIMD_ENV \endlink if the processor supports it, the best
+ * one supported otherwise, unless set with \link so3_simd_set_isa
+ * \endlink.
+ *
+ * \retval isa Instruction set.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_simd_isa_t so3_simd_get_isa()
+{
+    int isa = __atomic_load_n(&so3_simd_isa, __ATOMIC_RELAXED);
+
+    // Only without constructor support; concurrent first uses all
+    // arrive at the same result.
+    if (isa < 0)
+    {
+        isa = so3_simd_default_isa();
+        __atomic_store_n(&so3_simd_isa, isa, __ATOMIC_RELAXED);
+    }
+
+    return isa;
+}
+
+/*!
+ * Select the instruction set used by the kernels, e.g. to compare
+ * kernels or to work around a processor. Must not be called while
+ * transforms are being executed.
+ *
+ * \param[in]  isa Instruction set.
+ * \retval success 1 if isa was selected, 0 if it is not supported.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+int so3_simd_set_isa(so3_simd_isa_t isa)
+{
+    if (!so3_simd_supported(isa))
+        return 0;
+
+    __atomic_store_n(&so3_simd_isa, isa, __ATOMIC_RELAXED);
+
+    return 1;
+}
+
+/*!
+ * Accumulate the contribution of a single Wigner symbol row to a row of
+ * Fmnm' in the direct inverse transform (and the separation of
+ * variables of the inverse transform via SSHT):
+ *
+ *   Fmnm[m] += neg_factor * dl[-m] * mn_factors[m]   for -el <= m < 0,
+ *   Fmnm[m] += pos_factor * dl[m] * mn_factors[m]    for 0 <= m <= el.
+ *
+ * \param[in,out] Fmnm Row of Fmnm', pointing to m = 0.
+ * \param[in]  mn_factors Row of the coefficients times their phases,
+ *                        pointing to m = 0.
+ * \param[in]  dl Wigner symbols for m = 0, ..., el.
+ * \param[in]  el Harmonic degree.
+ * \param[in]  neg_factor Factor for m < 0, including the symmetry sign.
+ * \param[in]  pos_factor Factor for m >= 0.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_simd_accumulate_fmnm(
+    complex double *Fmnm, const complex double *mn_factors, const double *dl,
+    int el, double neg_factor, double pos_factor
+) {
+    so3_simd_fmnm_kernels[so3_simd_get_isa()](Fmnm, mn_factors, dl, el, neg_factor, pos_factor);
+}
+
+/*!
+ * Accumulate the contribution of a single Wigner symbol row to the
+ * coefficients of one el and n in the direct forward transforms:
+ *
+ *   flmn[m] += neg_factor * dl[-m] * phases[m] * Gmnm[m]   for -el <= m < 0,
+ *   flmn[m] += pos_factor * dl[m] * phases[m] * Gmnm[m]    for 0 <= m <= el.
+ *
+ * \param[in,out] flmn Coefficients of el and n, pointing to m = 0.
+ * \param[in]  Gmnm Row of Gmnm', pointing to m = 0.
+ * \param[in]  phases Phase (and sign) of each m, pointing to m = 0.
+ * \param[in]  dl Wigner symbols for m = 0, ..., el.
+ * \param[in]  el Harmonic degree.
+ * \param[in]  neg_factor Factor for m < 0, including the symmetry sign.
+ * \param[in]  pos_factor Factor for m >= 0.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_simd_accumulate_flmn(
+    complex double *flmn, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+) {
+    so3_simd_flmn_kernels[so3_simd_get_isa()](flmn, Gmnm, phases, dl, el, neg_factor, pos_factor);
+}
+
+/*!
+ * Variant of \link so3_simd_accumulate_flmn \endlink which accumulates
+ * into separate arrays of real and imaginary parts, for the split
+ * layout of the coefficients:
+ *
+ *   flmn_re[m] + I*flmn_im[m] += factor * dl[|m|] * phases[m] * Gmnm[m],
+ *
+ * with neg_factor for -el <= m < 0 and pos_factor for 0 <= m <= el.
+ *
+ * \param[in,out] flmn_re Real parts of the coefficients of el and n,
+ *                        pointing to m = 0.
+ * \param[in,out] flmn_im Imaginary parts, pointing to m = 0.
+ * \param[in]  Gmnm Row of Gmnm', pointing to m = 0.
+ * \param[in]  phases Phase (and sign) of each m, pointing to m = 0.
+ * \param[in]  dl Wigner symbols for m = 0, ..., el.
+ * \param[in]  el Harmonic degree.
+ * \param[in]  neg_factor Factor for m < 0, including the symmetry sign.
+ * \param[in]  pos_factor Factor for m >= 0.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_simd_accumulate_flmn_split(
+    double *flmn_re, double *flmn_im, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+) {
+    so3_simd_flmn_split_kernels[so3_simd_get_isa()](
+        flmn_re, flmn_im, Gmnm, phases, dl, el, neg_factor, pos_factor);
+}
+
+/*!
+ * Multiply a row by a complex factor, e.g. a phase:
+ *
+ *   out[i] = factor * in[i]   for 0 <= i < count.
+ *
+ * \param[out] out Result, which may be in.
+ * \param[in]  in Row.
+ * \param[in]  factor Factor.
+ * \param[in]  count Length of the row.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_simd_scale(complex double *out, const complex double *in, complex double factor, int count)
+{
+    so3_simd_scale_kernels[so3_simd_get_isa()](out, in, factor, count);
+}
+
+/*!
+ * Apply a phase to each element of a row, and a normalisation factor:
+ *
+ *   out[i] = in[i] * factor * phases[i]   for 0 <= i < count.
+ *
+ * \param[out] out Result, which may be in.
+ * \param[in]  in Row.
+ * \param[in]  phases Phase of each element.
+ * \param[in]  factor Normalisation factor.
+ * \param[in]  count Length of the row.
+ * \retval none
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+void so3_simd_modulate(
+    complex double *out, const complex double *in, const complex double *phases,
+    double factor, int count
+) {
+    so3_simd_modulate_kernels[so3_simd_get_isa()](out, in, phases, factor, count);
+}
@@ -0,0 +1,63 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*! \file so3_simd.h
+ *  Vectorised kernels of the innermost loops of the transforms, with
+ *  the instruction set selected at runtime.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#ifndef SO3_SIMD
+#define SO3_SIMD
+
+#include <complex.h>
+
+/*!
+ * Name of the environment variable which selects the instruction set of
+ * the kernels, by one of the names returned by \link so3_simd_isa_name
+ * \endlink. It is ignored if the processor does not support the
+ * instruction set.
+ */
+#define SO3_SIMD_ENV "SO3_SIMD"
+
+/*!
+ * Instruction sets for which kernels are available.
+ */
+typedef enum {
+    /*! Portable C. */
+    SO3_SIMD_SCALAR,
+    /*! AVX2 with FMA, two complex values per instruction. */
+    SO3_SIMD_AVX2,
+    /*! AVX-512F, four complex values per instruction. */
+    SO3_SIMD_AVX512,
+    SO3_SIMD_SIZE
+} so3_simd_isa_t;
+
+int so3_simd_supported(so3_simd_isa_t isa);
+const char *so3_simd_isa_name(so3_simd_isa_t isa);
+so3_simd_isa_t so3_simd_get_isa();
+int so3_simd_set_isa(so3_simd_isa_t isa);
+
+void so3_simd_accumulate_fmnm(
+    complex double *Fmnm, const complex double *mn_factors, const double *dl,
+    int el, double neg_factor, double pos_factor
+);
+void so3_simd_accumulate_flmn(
+    complex double *flmn, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+);
+void so3_simd_accumulate_flmn_split(
+    double *flmn_re, double *flmn_im, const complex double *Gmnm, const complex double *phases,
+    const double *dl, int el, double neg_factor, double pos_factor
+);
+
+void so3_simd_scale(complex double *out, const complex double *in, complex double factor, int count);
+void so3_simd_modulate(
+    complex double *out, const complex double *in, const complex double *phases,
+    double factor, int count
+);
+
+#endif
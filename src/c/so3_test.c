@@ -12,20 +12,30 @@
  *
  * \par Usage
  *   \code{.sh}
- *   so3_test [L [N [L0 [seed]]]]
+ *   so3_test [L [N [L0 [seed [threads [numa]]]]]]
  *   \endcode
  *   e.g.
  *   \code{.sh}
- *   so3_test 64 4 32 314
+ *   so3_test 64 4 32 314 8 1
  *   \endcode
- *   Defaults: L = 16, N = L, L0 = 0, seed = 1
+ *   Defaults: L = 16, N = L, L0 = 0, seed = 1, threads = 0 (the
+ *   default number of OpenMP threads), numa = 0. A non-zero numa
+ *   spreads the scratch buffers of the transforms over the NUMA nodes
+ *   (see \link so3_parameters_t::numa numa\endlink) and first reports
+ *   the memory bandwidth of each NUMA node of the system.
  *
  * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
  * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
  */
 
+#ifdef __linux__
+#define _GNU_SOURCE  // For the CPU affinity interface of sched.h
+#include <sched.h>
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <complex.h>
 #include <time.h>
 #include <fftw3.h>
@@ -34,6 +44,10 @@
 #include <so3.h>
 
 #define NREPEAT 5
+// Number of doubles per array and thread, and number of passes, of the
+// bandwidth measurement.
+#define NSTREAM (1 << 21)
+#define NSTREAM_REPEAT 10
 #define MIN(a,b) ((a < b) ? (a) : (b))
 #define MAX(a,b) ((a > b) ? (a) : (b))
 
@@ -41,6 +55,7 @@ double get_max_error(complex double *expected, complex double *actual, int n);
 double ran2_dp(int idum);
 void so3_test_gen_flmn_complex(complex double *flmn, const so3_parameters_t *parameters, int seed);
 void so3_test_gen_flmn_real(complex double *flmn, const so3_parameters_t *parameters, int seed);
+so3_status_t so3_test_numa_bandwidth(int num_threads);
 
 int main(int argc, char **argv)
 {
@@ -49,7 +64,7 @@ int main(int argc, char **argv)
     complex double *flmn_orig, *flmn_syn;
     complex double *f;
     double *f_real;
-    int seed;
+    int seed, num_threads, numa;
     clock_t time_start, time_end;
     int i, sampling_scheme, n_order, storage_mode, n_mode, real, routine;
     int flmn_size;
@@ -88,15 +103,12 @@ int main(int argc, char **argv)
     double durations_forward[SO3_SAMPLING_SIZE][SO3_N_MODE_SIZE][SO3_STORAGE_SIZE][SO3_N_MODE_SIZE][2][2];
     double durations_inverse[SO3_SAMPLING_SIZE][SO3_N_MODE_SIZE][SO3_STORAGE_SIZE][SO3_N_MODE_SIZE][2][2];
 
-    //fftw_init_threads();
-    //int nthreads = omp_get_max_threads();
-    //printf("Using %d threads.\n", nthreads);
-    //fftw_plan_with_nthreads(nthreads);
-
     // Parse command line arguments
     L = N = 4;
     L0 = 0;
     seed = 1;
+    num_threads = 0;
+    numa = 0;
     if (argc > 1)
     {
         L = atoi(argv[1]);
@@ -112,10 +124,18 @@ int main(int argc, char **argv)
     if (argc > 4)
         seed = atoi(argv[4]);
 
+    if (argc > 5)
+        num_threads = atoi(argv[5]);
+
+    if (argc > 6)
+        numa = atoi(argv[6]);
+
     parameters.L0 = L0;
     parameters.L = L;
     parameters.N = N;
     parameters.verbosity = 0;
+    parameters.num_threads = num_threads;
+    parameters.numa = numa;
 
     // (2*N-1)*L*L is the largest number of flmn ever needed. For more
     // compact storage modes, only part of the memory will be used.
@@ -135,6 +155,11 @@ int main(int argc, char **argv)
     printf("\n");
     printf("SO3 test program (C implementation)\n");
     printf("================================================================\n");
+    printf("Using %d threads.\n",
+           num_threads > 0 ? num_threads : omp_get_max_threads());
+    printf("Using %s kernels.\n", so3_simd_isa_name(so3_simd_get_isa()));
+    if (numa && so3_test_numa_bandwidth(num_threads) != SO3_SUCCESS)
+        printf("Bandwidth of NUMA nodes not measured: memory allocation failed.\n");
 
     // routine == 0 --> use SSHT
     // routine == 1 --> don't use SSHT
@@ -304,6 +329,122 @@ double get_max_error(complex double *expected, complex double *actual, int n)
     return maxError;
 }
 
+/*!
+ * Measure and print the memory bandwidth of each NUMA node. For each
+ * node, all threads are pinned to the CPUs of the node, and each thread
+ * copies between two arrays it has touched first (and which are thus
+ * allocated on the node), like the copy kernel of the STREAM benchmark.
+ * The affinity of the threads is restored afterwards.
+ *
+ * \param[in] num_threads Number of threads, or zero for the default
+ *                        number of OpenMP threads.
+ * \retval status \link SO3_SUCCESS \endlink, or \link
+ *                SO3_ERROR_OUT_OF_MEMORY \endlink if the arrays of a
+ *                thread could not be allocated, in which case the
+ *                remaining nodes are not measured.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+so3_status_t so3_test_numa_bandwidth(int num_threads)
+{
+#ifdef __linux__
+    int nthreads = num_threads > 0 ? num_threads : omp_get_max_threads();
+    int node;
+
+    for (node = 0; ; ++node)
+    {
+        char filename[64], cpulist[1024], *range;
+        cpu_set_t cpus;
+        double time_start = 0.0, time_end = 0.0;
+        int first, last, cpu, failed = 0;
+        FILE *file;
+
+        // The CPUs of the node, as a list of ranges such as "0-7,16-23".
+        sprintf(filename, "/sys/devices/system/node/node%d/cpulist", node);
+        file = fopen(filename, "r");
+        if (!file)
+            break;
+        if (!fgets(cpulist, sizeof cpulist, file))
+            cpulist[0] = '\0';
+        fclose(file);
+        cpulist[strcspn(cpulist, "\n")] = '\0';
+
+        CPU_ZERO(&cpus);
+        for (range = cpulist; *range; range += strcspn(range, ","), range += *range == ',')
+        {
+            if (sscanf(range, "%d-%d", &first, &last) < 2)
+                last = first = atoi(range);
+            for (cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu)
+                CPU_SET(cpu, &cpus);
+        }
+        // Nodes without CPUs (e.g. memory-only nodes) are skipped.
+        if (CPU_COUNT(&cpus) == 0)
+            continue;
+
+        #pragma omp parallel num_threads(nthreads) private(cpu) reduction(+:failed)
+        {
+            cpu_set_t saved;
+            double *a, *b;
+            int i, r;
+
+            sched_getaffinity(0, sizeof saved, &saved);
+            sched_setaffinity(0, sizeof cpus, &cpus);
+
+            a = malloc(NSTREAM * sizeof *a);
+            b = malloc(NSTREAM * sizeof *b);
+            if (!a || !b)
+                failed = 1;
+            else
+                for (i = 0; i < NSTREAM; ++i)
+                {
+                    a[i] = 1.0;
+                    b[i] = 0.0;
+                }
+
+            #pragma omp barrier
+            #pragma omp master
+            time_start = omp_get_wtime();
+            #pragma omp barrier
+
+            if (a && b)
+                for (r = 0; r < NSTREAM_REPEAT; ++r)
+                {
+                    for (i = 0; i < NSTREAM; ++i)
+                        b[i] = a[i];
+                    // Keep the compiler from dropping repeated passes.
+                    a[r % NSTREAM] += b[(r+1) % NSTREAM];
+                }
+
+            #pragma omp barrier
+            #pragma omp master
+            time_end = omp_get_wtime();
+
+            free(a);
+            free(b);
+            sched_setaffinity(0, sizeof saved, &saved);
+        }
+
+        if (failed)
+            return SO3_ERROR_OUT_OF_MEMORY;
+
+        // Each pass reads one array and writes the other.
+        printf("NUMA node %d (CPUs %s): copy bandwidth %.2f GB/s with %d threads.\n",
+               node, cpulist,
+               2.0*NSTREAM*sizeof(double)*NSTREAM_REPEAT*nthreads
+               / (time_end - time_start) / 1e9,
+               nthreads);
+    }
+
+    if (node == 0)
+        printf("No NUMA nodes found, bandwidth not measured.\n");
+#else
+    printf("Bandwidth of NUMA nodes is only measured on Linux.\n");
+#endif
+
+    return SO3_SUCCESS;
+}
+
 /*!
  * Generate random Wigner coefficients of a complex signal.
  *
@@ -0,0 +1,104 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_tune.c
+ * Time the candidate algorithms, Wigner recursions and FFTW planning
+ * rigours for a list of configurations (complex and real signals) on
+ * this machine and record the fastest choices in a tuning database,
+ * which is used by \link so3_forward \endlink, \link so3_inverse
+ * \endlink and their real counterparts.
+ *
+ * \par Usage
+ *   \code{.sh}
+ *   so3_tune database L N sampling [L N sampling ...]
+ *   \endcode
+ *   e.g.
+ *   \code{.sh}
+ *   so3_tune so3.tuning 64 4 MW 128 8 MWSS
+ *   \endcode
+ *   sampling is either MW or MWSS. The transforms find the database
+ *   through the environment variable SO3_TUNING_DB. The number of
+ *   threads is part of the configuration, so run this with the same
+ *   OMP_NUM_THREADS as the application.
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+
+#include <so3.h>
+
+static void so3_tune_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s database L N sampling [L N sampling ...]\n"
+            "       sampling is either MW or MWSS.\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    so3_parameters_t parameters = {};
+    so3_tuning_t tuning;
+    const char *database;
+    int arg, reality;
+    so3_status_t status;
+
+    if (argc < 5 || (argc - 2) % 3)
+    {
+        so3_tune_usage(argv[0]);
+        return 1;
+    }
+
+    database = argv[1];
+    parameters.verbosity = 1;
+
+    for (arg = 2; arg < argc; arg += 3)
+    {
+        parameters.L = atoi(argv[arg]);
+        parameters.N = atoi(argv[arg+1]);
+        if (!strcmp(argv[arg+2], "MW"))
+            parameters.sampling_scheme = SO3_SAMPLING_MW;
+        else if (!strcmp(argv[arg+2], "MWSS"))
+            parameters.sampling_scheme = SO3_SAMPLING_MW_SS;
+        else
+        {
+            so3_tune_usage(argv[0]);
+            return 1;
+        }
+
+        if (parameters.L < 1 || parameters.N < 1)
+        {
+            so3_tune_usage(argv[0]);
+            return 1;
+        }
+
+        for (reality = 0; reality <= 1; ++reality)
+        {
+            parameters.reality = reality;
+
+            status = so3_autotune(&tuning, &parameters, database);
+            if (status == SO3_ERROR_SYSTEM)
+            {
+                fprintf(stderr, "%sCould not write tuning database %s\n", SO3_PROMPT, database);
+                return 1;
+            }
+            if (status != SO3_SUCCESS)
+            {
+                fprintf(stderr, "%sCould not tune (L, N) = (%d, %d)\n", SO3_PROMPT,
+                        parameters.L, parameters.N);
+                return 1;
+            }
+        }
+    }
+
+    printf("%sTuning written to %s\n", SO3_PROMPT, database);
+
+    return 0;
+}
@@ -186,6 +186,28 @@ typedef struct {
      * A non-zero value indicates that the signal is steerable.
      */
     int steerable;
+
+    /*!
+     * Number of threads used by the transforms, for their parallel
+     * loops as well as for the FFTs (the latter requires a build
+     * against the threaded FFTW library, see the makefile). Zero
+     * uses the default number of OpenMP threads.
+     * \var int num_threads
+     */
+    int num_threads;
+
+    /*!
+     * A non-zero value places each slab of the scratch buffers (which
+     * is always first touched by the thread that processes it) on one
+     * NUMA node of the process, spread evenly over its nodes: the OpenMP
+     * threads are pinned to the CPUs of the process for the first touch
+     * and afterwards regain their original affinity. To keep the threads
+     * on those nodes during the transforms, bind them with
+     * OMP_PROC_BIND=spread, in which case the runtime's placement is
+     * used for the first touch as well. Only supported on Linux.
+     * \var int numa
+     */
+    int numa;
 } so3_parameters_t;
 
 #endif
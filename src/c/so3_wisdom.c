@@ -0,0 +1,147 @@
+// S03 package to perform Wigner transform on the rotation group SO(3)
+// Copyright (C) 2013 Martin Büttner and Jason McEwen
+// See LICENSE.txt for license details
+
+/*!
+ * \file so3_wisdom.c
+ * Pre-generate FFTW wisdom for all FFTs used by the SO3 transforms
+ * (complex and real signals, via SSHT and direct, forward and inverse,
+ * with and without steerability; the direct transforms only for MW
+ * sampling without steerability) for a list of configurations, and
+ * write it to a file. Wisdom already present in that file is imported
+ * first, so that the file accumulates wisdom over several runs.
+ *
+ * Load the file with \link so3_plan_import_wisdom \endlink before
+ * creating plans to skip the expensive planning at startup.
+ *
+ * \par Usage
+ *   \code{.sh}
+ *   so3_wisdom [-estimate|-measure|-patient|-exhaustive] wisdom_file L N sampling [L N sampling ...]
+ *   \endcode
+ *   e.g.
+ *   \code{.sh}
+ *   so3_wisdom -patient so3.wisdom 64 4 MW 128 8 MWSS
+ *   \endcode
+ *   sampling is either MW or MWSS. Default planning mode: -measure
+ *
+ * \author <a href="mailto:m.buettner.d@gmail.com">Martin Büttner</a>
+ * \author <a href="http://www.jasonmcewen.org">Jason McEwen</a>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#include <time.h>
+#include <fftw3.h>
+
+#include <so3.h>
+
+static void so3_wisdom_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [-estimate|-measure|-patient|-exhaustive] "
+            "wisdom_file L N sampling [L N sampling ...]\n"
+            "       sampling is either MW or MWSS.\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    so3_parameters_t parameters = {};
+    so3_plan_t *plan;
+    so3_status_t status;
+    unsigned flags;
+    const char *filename;
+    int arg, reality, steerable;
+    clock_t time_start, time_end;
+
+    // Parse command line arguments
+    flags = FFTW_MEASURE;
+    arg = 1;
+    if (arg < argc && argv[arg][0] == '-')
+    {
+        if (!strcmp(argv[arg], "-estimate"))
+            flags = FFTW_ESTIMATE;
+        else if (!strcmp(argv[arg], "-measure"))
+            flags = FFTW_MEASURE;
+        else if (!strcmp(argv[arg], "-patient"))
+            flags = FFTW_PATIENT;
+        else if (!strcmp(argv[arg], "-exhaustive"))
+            flags = FFTW_EXHAUSTIVE;
+        else
+        {
+            so3_wisdom_usage(argv[0]);
+            return 1;
+        }
+        ++arg;
+    }
+
+    if (argc - arg < 4 || (argc - arg - 1) % 3)
+    {
+        so3_wisdom_usage(argv[0]);
+        return 1;
+    }
+
+    filename = argv[arg++];
+
+    if (so3_plan_import_wisdom(filename))
+        printf("%sImported existing wisdom from %s\n", SO3_PROMPT, filename);
+
+    for (; arg < argc; arg += 3)
+    {
+        parameters.L = atoi(argv[arg]);
+        parameters.N = atoi(argv[arg+1]);
+        if (!strcmp(argv[arg+2], "MW"))
+            parameters.sampling_scheme = SO3_SAMPLING_MW;
+        else if (!strcmp(argv[arg+2], "MWSS"))
+            parameters.sampling_scheme = SO3_SAMPLING_MW_SS;
+        else
+        {
+            so3_wisdom_usage(argv[0]);
+            return 1;
+        }
+
+        if (parameters.L < 1 || parameters.N < 1)
+        {
+            so3_wisdom_usage(argv[0]);
+            return 1;
+        }
+
+        printf("%sGenerating wisdom for (L, N, sampling) = (%d, %d, %s)...\n",
+               SO3_PROMPT, parameters.L, parameters.N, argv[arg+2]);
+
+        time_start = clock();
+        for (reality = 0; reality <= 1; ++reality)
+            for (steerable = 0; steerable <= 1; ++steerable)
+            {
+                parameters.reality = reality;
+                parameters.steerable = steerable;
+
+                plan = so3_plan_create(&parameters, flags);
+                status = so3_plan_prepare(plan, SO3_PLAN_PREPARE_ALL);
+                so3_plan_destroy(plan);
+                if (status != SO3_SUCCESS)
+                {
+                    fprintf(stderr, "%sCould not plan (L, N, sampling, reality, steerable) = "
+                            "(%d, %d, %s, %d, %d)\n", SO3_PROMPT,
+                            parameters.L, parameters.N, argv[arg+2], reality, steerable);
+                    return 1;
+                }
+            }
+        time_end = clock();
+
+        printf("%s  done in %fs\n", SO3_PROMPT,
+               (time_end - time_start) / (double)CLOCKS_PER_SEC);
+    }
+
+    if (!so3_plan_export_wisdom(filename))
+    {
+        fprintf(stderr, "%sCould not write wisdom to %s\n", SO3_PROMPT, filename);
+        return 1;
+    }
+
+    printf("%sWisdom written to %s\n", SO3_PROMPT, filename);
+
+    return 0;
+}
@@ -1,20 +1,61 @@
+#ifdef __linux__
+#define _GNU_SOURCE  // For the CPU affinity interface of sched.h
+#include <sched.h>
+#endif
+
 #include <assert.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include <omp.h>
 
 #include "../so3_types.h"
 #include "../so3_sampling.h"
+#include "../so3_dl_cache.h"
+#include "../so3_autotune.h"
+#include "../so3_core.h"
+#include "../so3_schedule.h"
+#include "../so3_async.h"
+#include "../so3_fork.h"
+#include "../so3_simd.h"
 
 static void test_sampling_elmn2ind();
 static void test_sampling_ind2elmn();
 static void test_sampling_elmn2ind_real();
 static void test_sampling_ind2elmn_real();
+static void test_dl_cache();
+static void test_autotune();
+static void test_num_threads();
+static void test_numa();
+static void test_schedule();
+static void test_reentrant();
+static void test_batch();
+static void test_async();
+static void test_fork();
+static void test_simd();
+static void test_split();
+static void test_via_ssht();
 
 int main() {
     test_sampling_elmn2ind();
     test_sampling_ind2elmn();
     test_sampling_elmn2ind_real();
     test_sampling_ind2elmn_real();
+    test_dl_cache();
+    test_autotune();
+    test_num_threads();
+    test_numa();
+    test_schedule();
+    test_reentrant();
+    test_batch();
+    test_async();
+    test_fork();
+    test_simd();
+    test_split();
+    test_via_ssht();
     printf("All unit tests passed!\n");
     return 0;
 }
@@ -462,3 +503,1050 @@ void test_sampling_ind2elmn_real()
     assert( el == 2 && m == 1 && n == 2 &&
             "Index 23 yields wrong indices (el,m,n)." );
 }
+
+void test_dl_cache()
+{
+    const char *filename = "so3_unittest_dl_cache.tmp";
+    so3_dl_cache_t *cache;
+    const double *plane;
+    double value;
+    FILE *file;
+
+    remove(filename);
+
+    // Missing cache files are created.
+    assert( so3_dl_cache_open(&cache, filename, 4, SSHT_DL_RISBO) == SO3_SUCCESS &&
+            "Cache could not be created." );
+    assert( so3_dl_cache_get_L(cache) == 4 &&
+            "Cache has wrong band-limit." );
+
+    // Plane el is stored as an (el+1) x (el+1) array.
+    plane = so3_dl_cache_get_plane(cache, 0);
+    assert( fabs(plane[0] - 1.0) < 1e-14 &&
+            "d^0_00(pi/2) should be 1." );
+    plane = so3_dl_cache_get_plane(cache, 1);
+    assert( fabs(plane[0]) < 1e-14 &&
+            "d^1_00(pi/2) should be 0." );
+    assert( fabs(plane[3] - 0.5) < 1e-14 &&
+            "d^1_11(pi/2) should be 1/2." );
+    value = so3_dl_cache_get_plane(cache, 3)[5];
+    so3_dl_cache_close(cache);
+
+    // Existing caches are reused for smaller band-limits.
+    assert( so3_dl_cache_open(&cache, filename, 2, SSHT_DL_RISBO) == SO3_SUCCESS &&
+            so3_dl_cache_get_L(cache) == 4 &&
+            "Existing cache should be reused." );
+    so3_dl_cache_close(cache);
+
+    // Corrupt caches are detected and rewritten.
+    file = fopen(filename, "r+b");
+    assert( file != NULL );
+    fseek(file, -1, SEEK_END);
+    fputc(0x55, file);
+    fclose(file);
+
+    assert( so3_dl_cache_open(&cache, filename, 4, SSHT_DL_RISBO) == SO3_SUCCESS &&
+            "Corrupt cache should be rewritten." );
+    assert( so3_dl_cache_get_plane(cache, 3)[5] == value &&
+            "Rewritten cache differs from original." );
+    so3_dl_cache_close(cache);
+
+    remove(filename);
+}
+
+void test_autotune()
+{
+    const char *filename = "so3_unittest_tuning.tmp";
+    so3_parameters_t parameters = {};
+    so3_tuning_t tuning, recorded;
+
+    remove(filename);
+
+    parameters.L = 4;
+    parameters.N = 2;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+
+    assert( !so3_autotune_lookup(&recorded, &parameters, filename) &&
+            "Missing database should not contain any records." );
+
+    // The results of both signal types are recorded side by side.
+    parameters.reality = 1;
+    assert( so3_autotune(&tuning, &parameters, filename) == SO3_SUCCESS &&
+            "Tuning database could not be written." );
+    parameters.reality = 0;
+    assert( so3_autotune(&tuning, &parameters, filename) == SO3_SUCCESS &&
+            "Tuning database could not be written." );
+
+    assert( so3_autotune_lookup(&recorded, &parameters, filename) &&
+            "Tuned configuration not found in database." );
+    assert( recorded.forward.algorithm == tuning.forward.algorithm &&
+            recorded.forward.dl_method == tuning.forward.dl_method &&
+            recorded.forward.fftw_flags == tuning.forward.fftw_flags &&
+            recorded.inverse.algorithm == tuning.inverse.algorithm &&
+            recorded.inverse.dl_method == tuning.inverse.dl_method &&
+            recorded.inverse.fftw_flags == tuning.inverse.fftw_flags &&
+            "Recorded tuning differs from result." );
+
+    parameters.reality = 1;
+    assert( so3_autotune_lookup(&recorded, &parameters, filename) &&
+            "Earlier record was lost when adding another one." );
+
+    parameters.N = 3;
+    assert( !so3_autotune_lookup(&recorded, &parameters, filename) &&
+            "Untuned configuration found in database." );
+
+    remove(filename);
+}
+
+void test_num_threads()
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_serial, *flmn_threaded;
+    complex double *f_serial, *f_threaded;
+    int flmn_size, f_size, i;
+
+    parameters.L = 6;
+    parameters.N = 3;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    f_size = so3_sampling_f_size(&parameters);
+    flmn = malloc(flmn_size * sizeof *flmn);
+    flmn_serial = calloc(flmn_size, sizeof *flmn_serial);
+    flmn_threaded = calloc(flmn_size, sizeof *flmn_threaded);
+    f_serial = malloc(f_size * sizeof *f_serial);
+    f_threaded = malloc(f_size * sizeof *f_threaded);
+    assert( flmn && flmn_serial && flmn_threaded && f_serial && f_threaded );
+
+    for (i = 0; i < flmn_size; ++i)
+        flmn[i] = sin(i) + I*cos(3*i);
+
+    // The transforms give the same results for any number of threads.
+    parameters.num_threads = 1;
+    so3_core_inverse_direct(f_serial, flmn, &parameters);
+    so3_core_forward_via_ssht(flmn_serial, f_serial, &parameters);
+    parameters.num_threads = 3;
+    so3_core_inverse_direct(f_threaded, flmn, &parameters);
+    so3_core_forward_via_ssht(flmn_threaded, f_serial, &parameters);
+
+    for (i = 0; i < f_size; ++i)
+        assert( cabs(f_threaded[i] - f_serial[i]) < 1e-12 &&
+                "Threaded inverse transform differs from serial one." );
+    for (i = 0; i < flmn_size; ++i)
+        assert( cabs(flmn_threaded[i] - flmn_serial[i]) < 1e-12 &&
+                "Threaded forward transform differs from serial one." );
+
+    free(flmn);
+    free(flmn_serial);
+    free(flmn_threaded);
+    free(f_serial);
+    free(f_threaded);
+}
+
+void test_schedule()
+{
+    const int nthreads = 3, count = 100;
+    so3_schedule_t *schedule;
+    so3_schedule_stats_t stats[3];
+    int visits[100] = {0};
+    int i, chunks;
+
+    schedule = so3_schedule_create(nthreads);
+    assert( schedule != NULL );
+
+    // Every iteration is executed exactly once, including those of zero
+    // cost.
+    #pragma omp parallel num_threads(nthreads)
+    {
+        int thread = omp_get_thread_num();
+        int first, last, j;
+
+        #pragma omp single
+        {
+            double *cost = so3_schedule_costs(schedule, count);
+            for (j = 0; j < count; ++j)
+                cost[j] = j % 7 ? j : 0.0;
+            so3_schedule_partition(schedule);
+        }
+
+        while (so3_schedule_next(schedule, thread, &first, &last))
+            for (j = first; j < last; ++j)
+            {
+                #pragma omp atomic
+                visits[j]++;
+            }
+    }
+
+    for (i = 0; i < count; ++i)
+        assert( visits[i] == 1 &&
+                "Iteration was not executed exactly once." );
+
+    assert( so3_schedule_get_stats(schedule, stats) == nthreads );
+    chunks = 0;
+    for (i = 0; i < nthreads; ++i)
+    {
+        assert( stats[i].busy <= stats[i].wall &&
+                "Thread was busy for longer than the loop took." );
+        chunks += stats[i].chunks;
+    }
+    assert( chunks > 0 && chunks <= 4*nthreads &&
+            "Unexpected number of chunks." );
+
+    so3_schedule_reset_stats(schedule);
+    so3_schedule_get_stats(schedule, stats);
+    assert( stats[0].chunks == 0 && stats[0].wall == 0.0 &&
+            "Statistics were not reset." );
+
+    so3_schedule_destroy(schedule);
+}
+
+void test_reentrant()
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_r, *f, *f_r;
+    int flmn_size, f_size, ind, el, m, n, i;
+    int failures = 0;
+
+    parameters.L = 5;
+    parameters.N = 3;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+
+    // Invalid parameters are reported instead of terminating.
+    parameters.N = 0;
+    assert( so3_sampling_check_parameters(&parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "N < 1 was accepted." );
+    assert( so3_sampling_f_size_r(&f_size, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "N < 1 was accepted." );
+    parameters.N = 3;
+    parameters.sampling_scheme = SO3_SAMPLING_SIZE;
+    assert( so3_sampling_nbeta_r(&n, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "Invalid sampling scheme was accepted." );
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+    assert( so3_sampling_check_parameters(&parameters) == SO3_SUCCESS );
+
+    // Indices out of range.
+    assert( so3_sampling_elmn2ind_r(&ind, 5, 0, 0, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "el >= L was accepted." );
+    assert( so3_sampling_elmn2ind_r(&ind, 2, 3, 0, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "|m| > el was accepted." );
+    assert( so3_sampling_elmn2ind_real_r(&ind, 2, 0, -1, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "n < 0 was accepted for a real signal." );
+    assert( so3_sampling_b2beta_r(NULL, 0, &parameters) == SO3_ERROR_INVALID_ARGUMENT );
+
+    // Valid indices give the results of the non-reentrant functions.
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    for (i = 0; i < flmn_size; ++i)
+    {
+        assert( so3_sampling_ind2elmn_r(&el, &m, &n, i, &parameters) == SO3_SUCCESS );
+        assert( so3_sampling_elmn2ind_r(&ind, el, m, n, &parameters) == SO3_SUCCESS &&
+                ind == i && "Reentrant index conversion is not consistent." );
+    }
+    assert( so3_sampling_ind2elmn_r(&el, &m, &n, flmn_size, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "Index beyond the flmn was accepted." );
+
+    f_size = so3_sampling_f_size(&parameters);
+    flmn = malloc(flmn_size * sizeof *flmn);
+    flmn_r = calloc(flmn_size, sizeof *flmn_r);
+    f = malloc(f_size * sizeof *f);
+    f_r = malloc(f_size * sizeof *f_r);
+    assert( flmn && flmn_r && f && f_r );
+
+    for (i = 0; i < flmn_size; ++i)
+        flmn[i] = sin(i) + I*cos(2*i);
+
+    // The direct transforms support MW sampling only.
+    parameters.sampling_scheme = SO3_SAMPLING_MW_SS;
+    assert( so3_core_inverse_direct_r(f_r, flmn, &parameters) == SO3_ERROR_UNSUPPORTED &&
+            "Direct transform accepted MW_SS sampling." );
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+    parameters.L0 = 5;
+    assert( so3_core_inverse_via_ssht_r(f_r, flmn, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "L0 >= L was accepted." );
+    parameters.L0 = 0;
+
+    so3_core_inverse_direct(f, flmn, &parameters);
+    assert( so3_core_inverse_direct_r(f_r, flmn, &parameters) == SO3_SUCCESS );
+    for (i = 0; i < f_size; ++i)
+        assert( cabs(f_r[i] - f[i]) < 1e-12 &&
+                "Reentrant inverse transform differs." );
+
+    // The batch and split variants check their arguments in the same way.
+    assert( so3_core_inverse_direct_batch_r(f_r, flmn, -1, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "Negative count was accepted." );
+    assert( so3_core_forward_via_ssht_batch_r(NULL, f, 1, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "Missing output was accepted." );
+    assert( so3_core_inverse_direct_batch_r(f_r, flmn, 1, &parameters) == SO3_SUCCESS );
+    for (i = 0; i < f_size; ++i)
+        assert( cabs(f_r[i] - f[i]) < 1e-12 &&
+                "Reentrant batched inverse transform differs." );
+    parameters.steerable = 1;
+    assert( so3_core_inverse_direct_split_r((double *)f_r, (double *)f_r + f_size,
+                                            (const double *)flmn, (const double *)flmn + flmn_size,
+                                            &parameters) == SO3_ERROR_UNSUPPORTED &&
+            "Direct transform accepted a steerable signal." );
+    parameters.steerable = 0;
+
+    // Concurrent transforms on independent threads, each with a single
+    // thread of its own.
+    parameters.num_threads = 1;
+    so3_core_forward_via_ssht(flmn_r, f, &parameters);
+    #pragma omp parallel num_threads(4) reduction(+:failures)
+    {
+        complex double *flmn_t = calloc(flmn_size, sizeof *flmn_t);
+        int j;
+
+        if (!flmn_t
+            || so3_core_forward_via_ssht_r(flmn_t, f, &parameters) != SO3_SUCCESS)
+            ++failures;
+        else
+            for (j = 0; j < flmn_size; ++j)
+                if (cabs(flmn_t[j] - flmn_r[j]) > 1e-12)
+                    ++failures;
+
+        free(flmn_t);
+    }
+    assert( failures == 0 &&
+            "Concurrent reentrant transforms failed." );
+
+    free(flmn);
+    free(flmn_r);
+    free(f);
+    free(f_r);
+}
+
+void test_batch()
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_b, *flmn_s, *f, *f_b, *f_s;
+    double *fr, *fr_b, *fr_s;
+    int flmn_size, f_size, i, k, steerable;
+    const int count = 3;
+
+    parameters.L = 6;
+    parameters.N = 4;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    f_size = so3_sampling_f_size(&parameters);
+    flmn = malloc(count*flmn_size * sizeof *flmn);
+    flmn_b = calloc(count*flmn_size, sizeof *flmn_b);
+    flmn_s = calloc(count*flmn_size, sizeof *flmn_s);
+    f = malloc(count*f_size * sizeof *f);
+    f_b = calloc(count*f_size, sizeof *f_b);
+    f_s = calloc(count*f_size, sizeof *f_s);
+    fr = malloc(count*f_size * sizeof *fr);
+    fr_b = calloc(count*f_size, sizeof *fr_b);
+    fr_s = calloc(count*f_size, sizeof *fr_s);
+    assert( flmn && flmn_b && flmn_s && f && f_b && f_s && fr && fr_b && fr_s );
+
+    for (i = 0; i < count*flmn_size; ++i)
+        flmn[i] = sin(i) + I*cos(3*i);
+    for (i = 0; i < count*f_size; ++i)
+    {
+        f[i] = cos(i) + I*sin(5*i);
+        fr[i] = cos(7*i);
+    }
+
+    // Each signal of a batch gives the result of an individual transform.
+    for (steerable = 0; steerable <= 1; ++steerable)
+    {
+        parameters.steerable = steerable;
+        f_size = so3_sampling_f_size(&parameters);
+
+        so3_core_inverse_via_ssht_batch(f_b, flmn, count, &parameters);
+        for (k = 0; k < count; ++k)
+            so3_core_inverse_via_ssht(f_s + k*f_size, flmn + k*flmn_size, &parameters);
+        for (i = 0; i < count*f_size; ++i)
+            assert( cabs(f_b[i] - f_s[i]) < 1e-12 &&
+                    "Batched inverse transform differs." );
+
+        so3_core_forward_via_ssht_batch(flmn_b, f, count, &parameters);
+        for (k = 0; k < count; ++k)
+            so3_core_forward_via_ssht(flmn_s + k*flmn_size, f + k*f_size, &parameters);
+        for (i = 0; i < count*flmn_size; ++i)
+            assert( cabs(flmn_b[i] - flmn_s[i]) < 1e-12 &&
+                    "Batched forward transform differs." );
+    }
+    parameters.steerable = 0;
+    f_size = so3_sampling_f_size(&parameters);
+
+    // Real signals have fewer harmonic coefficients.
+    parameters.reality = 1;
+    flmn_size = so3_sampling_flmn_size(&parameters);
+
+    so3_core_inverse_via_ssht_real_batch(fr_b, flmn, count, &parameters);
+    for (k = 0; k < count; ++k)
+        so3_core_inverse_via_ssht_real(fr_s + k*f_size, flmn + k*flmn_size, &parameters);
+    for (i = 0; i < count*f_size; ++i)
+        assert( fabs(fr_b[i] - fr_s[i]) < 1e-12 &&
+                "Batched real inverse transform differs." );
+
+    so3_core_forward_via_ssht_real_batch(flmn_b, fr, count, &parameters);
+    for (k = 0; k < count; ++k)
+        so3_core_forward_via_ssht_real(flmn_s + k*flmn_size, fr + k*f_size, &parameters);
+    for (i = 0; i < count*flmn_size; ++i)
+        assert( cabs(flmn_b[i] - flmn_s[i]) < 1e-12 &&
+                "Batched real forward transform differs." );
+
+    parameters.reality = 0;
+    flmn_size = so3_sampling_flmn_size(&parameters);
+
+    so3_core_inverse_direct_batch(f_b, flmn, count, &parameters);
+    for (k = 0; k < count; ++k)
+        so3_core_inverse_direct(f_s + k*f_size, flmn + k*flmn_size, &parameters);
+    for (i = 0; i < count*f_size; ++i)
+        assert( cabs(f_b[i] - f_s[i]) < 1e-12 &&
+                "Batched direct inverse transform differs." );
+
+    so3_core_forward_direct_batch(flmn_b, f, count, &parameters);
+    for (k = 0; k < count; ++k)
+        so3_core_forward_direct(flmn_s + k*flmn_size, f + k*f_size, &parameters);
+    for (i = 0; i < count*flmn_size; ++i)
+        assert( cabs(flmn_b[i] - flmn_s[i]) < 1e-12 &&
+                "Batched direct forward transform differs." );
+
+    parameters.reality = 1;
+    flmn_size = so3_sampling_flmn_size(&parameters);
+
+    so3_core_inverse_direct_real_batch(fr_b, flmn, count, &parameters);
+    for (k = 0; k < count; ++k)
+        so3_core_inverse_direct_real(fr_s + k*f_size, flmn + k*flmn_size, &parameters);
+    for (i = 0; i < count*f_size; ++i)
+        assert( fabs(fr_b[i] - fr_s[i]) < 1e-12 &&
+                "Batched direct real inverse transform differs." );
+
+    so3_core_forward_direct_real_batch(flmn_b, fr, count, &parameters);
+    for (k = 0; k < count; ++k)
+        so3_core_forward_direct_real(flmn_s + k*flmn_size, fr + k*f_size, &parameters);
+    for (i = 0; i < count*flmn_size; ++i)
+        assert( cabs(flmn_b[i] - flmn_s[i]) < 1e-12 &&
+                "Batched direct real forward transform differs." );
+
+    free(flmn);
+    free(flmn_b);
+    free(flmn_s);
+    free(f);
+    free(f_b);
+    free(f_s);
+    free(fr);
+    free(fr_b);
+    free(fr_s);
+}
+
+static void test_async_callback(so3_job_t *job, so3_status_t status, void *data)
+{
+    if (status == SO3_SUCCESS)
+    {
+        #pragma omp atomic
+        ++*(int *)data;
+    }
+}
+
+void test_async()
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_a, *flmn_s, *f, *f_a, *f_s;
+    so3_job_t *jobs[4];
+    int flmn_size, f_size, i, k;
+    int callbacks = 0;
+    const int count = 4;
+
+    parameters.L = 6;
+    parameters.N = 3;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    f_size = so3_sampling_f_size(&parameters);
+    flmn = malloc(count*flmn_size * sizeof *flmn);
+    flmn_a = calloc(count*flmn_size, sizeof *flmn_a);
+    flmn_s = calloc(count*flmn_size, sizeof *flmn_s);
+    f = malloc(count*f_size * sizeof *f);
+    f_a = calloc(count*f_size, sizeof *f_a);
+    f_s = calloc(count*f_size, sizeof *f_s);
+    assert( flmn && flmn_a && flmn_s && f && f_a && f_s );
+
+    for (i = 0; i < count*flmn_size; ++i)
+        flmn[i] = sin(2*i) + I*cos(i);
+    for (i = 0; i < count*f_size; ++i)
+        f[i] = cos(3*i) + I*sin(i);
+
+    // Invalid submissions are rejected without a job.
+    parameters.N = 0;
+    assert( so3_submit_inverse(&jobs[0], f_a, flmn, &parameters, NULL, NULL) == SO3_ERROR_INVALID_ARGUMENT &&
+            jobs[0] == NULL && "Invalid parameters were accepted." );
+    parameters.N = 3;
+    assert( so3_submit_forward(&jobs[0], NULL, f, &parameters, NULL, NULL) == SO3_ERROR_INVALID_ARGUMENT &&
+            "NULL buffer was accepted." );
+
+    // Concurrent jobs give the results of the blocking transforms.
+    for (k = 0; k < count; ++k)
+    {
+        assert( so3_submit_inverse(&jobs[k], f_a + k*f_size, flmn + k*flmn_size,
+                                   &parameters, test_async_callback, &callbacks) == SO3_SUCCESS );
+        so3_core_inverse_via_ssht(f_s + k*f_size, flmn + k*flmn_size, &parameters);
+    }
+    while (!so3_test_done(jobs[count-1]))
+        ;
+    for (k = 0; k < count; ++k)
+        assert( so3_wait(jobs[k]) == SO3_SUCCESS );
+    for (i = 0; i < count*f_size; ++i)
+        assert( cabs(f_a[i] - f_s[i]) < 1e-12 &&
+                "Asynchronous inverse transform differs." );
+
+    for (k = 0; k < count; ++k)
+    {
+        assert( so3_submit_forward(&jobs[k], flmn_a + k*flmn_size, f + k*f_size,
+                                   &parameters, test_async_callback, &callbacks) == SO3_SUCCESS );
+        so3_core_forward_via_ssht(flmn_s + k*flmn_size, f + k*f_size, &parameters);
+    }
+    for (k = 0; k < count; ++k)
+        assert( so3_wait(jobs[k]) == SO3_SUCCESS );
+    for (i = 0; i < count*flmn_size; ++i)
+        assert( cabs(flmn_a[i] - flmn_s[i]) < 1e-12 &&
+                "Asynchronous forward transform differs." );
+
+    assert( callbacks == 2*count &&
+            "Completion callbacks were not invoked." );
+
+    so3_async_finalize();
+
+    free(flmn);
+    free(flmn_a);
+    free(flmn_s);
+    free(f);
+    free(f_a);
+    free(f_s);
+}
+
+void test_fork()
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_p, *f, *f_p, *flmn_s, *f_s;
+    double *fr, *fr_p, *fr_s;
+    int flmn_size, f_size, i, k;
+    const int count = 5;
+
+    parameters.L = 6;
+    parameters.N = 3;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    f_size = so3_sampling_f_size(&parameters);
+
+    // Batches are only accepted while the pool is running.
+    assert( so3_fork_alloc(64) == NULL &&
+            "Allocation without a pool succeeded." );
+
+#ifndef __linux__
+    assert( so3_fork_init(2, 1024) == SO3_ERROR_UNSUPPORTED &&
+            "Pool was started without process-shared semaphores." );
+    return;
+#endif
+
+    assert( so3_fork_init(2, 4*count*(flmn_size + f_size) * sizeof *f) == SO3_SUCCESS );
+    assert( so3_fork_init(2, 1024) == SO3_ERROR_INVALID_ARGUMENT &&
+            "Pool was started twice." );
+
+    flmn = so3_fork_alloc(count*flmn_size * sizeof *flmn);
+    flmn_p = so3_fork_alloc(count*flmn_size * sizeof *flmn_p);
+    f = so3_fork_alloc(count*f_size * sizeof *f);
+    f_p = so3_fork_alloc(count*f_size * sizeof *f_p);
+    fr = so3_fork_alloc(count*f_size * sizeof *fr);
+    fr_p = so3_fork_alloc(count*f_size * sizeof *fr_p);
+    flmn_s = calloc(count*flmn_size, sizeof *flmn_s);
+    f_s = calloc(count*f_size, sizeof *f_s);
+    fr_s = calloc(count*f_size, sizeof *fr_s);
+    assert( flmn && flmn_p && f && f_p && fr && fr_p && flmn_s && f_s && fr_s );
+
+    for (i = 0; i < count*flmn_size; ++i)
+        flmn[i] = sin(i) + I*cos(2*i);
+    for (i = 0; i < count*f_size; ++i)
+    {
+        f[i] = cos(3*i) + I*sin(i);
+        fr[i] = sin(5*i);
+    }
+
+    // Buffers outside the arena cannot be shared with the helpers.
+    assert( so3_fork_inverse_via_ssht_batch(f_s, flmn, count, &parameters) == SO3_ERROR_INVALID_ARGUMENT &&
+            "Buffer outside the arena was accepted." );
+
+    // Each signal gives the result of an individual transform.
+    assert( so3_fork_inverse_via_ssht_batch(f_p, flmn, count, &parameters) == SO3_SUCCESS );
+    for (k = 0; k < count; ++k)
+        so3_core_inverse_via_ssht(f_s + k*f_size, flmn + k*flmn_size, &parameters);
+    for (i = 0; i < count*f_size; ++i)
+        assert( cabs(f_p[i] - f_s[i]) < 1e-12 &&
+                "Inverse transform in helper processes differs." );
+
+    memset(flmn_p, 0, count*flmn_size * sizeof *flmn_p);
+    assert( so3_fork_forward_direct_batch(flmn_p, f, count, &parameters) == SO3_SUCCESS );
+    for (k = 0; k < count; ++k)
+        so3_core_forward_direct(flmn_s + k*flmn_size, f + k*f_size, &parameters);
+    for (i = 0; i < count*flmn_size; ++i)
+        assert( cabs(flmn_p[i] - flmn_s[i]) < 1e-12 &&
+                "Direct forward transform in helper processes differs." );
+
+    parameters.reality = 1;
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    assert( so3_fork_forward_via_ssht_real_batch(flmn_p, fr, count, &parameters) == SO3_SUCCESS );
+    for (k = 0; k < count; ++k)
+        so3_core_forward_via_ssht_real(flmn_s + k*flmn_size, fr + k*f_size, &parameters);
+    for (i = 0; i < count*flmn_size; ++i)
+        assert( cabs(flmn_p[i] - flmn_s[i]) < 1e-12 &&
+                "Real forward transform in helper processes differs." );
+    parameters.reality = 0;
+
+    parameters.steerable = 1;
+    assert( so3_fork_inverse_direct_batch(f_p, flmn, count, &parameters) == SO3_ERROR_UNSUPPORTED &&
+            "Unsupported direct transform was accepted." );
+    parameters.steerable = 0;
+
+    // Freed blocks are merged and reused first.
+    so3_fork_free(fr);
+    so3_fork_free(fr_p);
+    fr_p = so3_fork_alloc(2*count*f_size * sizeof *fr_p);
+    assert( fr_p == fr && "Freed blocks were not merged." );
+    so3_fork_free(fr_p);
+
+    so3_fork_free(flmn);
+    so3_fork_free(flmn_p);
+    so3_fork_free(f);
+    so3_fork_free(f_p);
+    so3_fork_finalize();
+
+    free(flmn_s);
+    free(f_s);
+    free(fr_s);
+}
+
+void test_simd()
+{
+    so3_parameters_t parameters = {};
+    complex double F_scalar[2*9+1], F[2*9+1], x[2*9+1], y[2*9+1];
+    double F_re[2*9+1], F_im[2*9+1];
+    complex double *flmn, *flmn_scalar, *flmn_isa, *f_scalar, *f;
+    double dl[10];
+    so3_simd_isa_t isa, best;
+    int flmn_size, f_size, el, i;
+
+    for (i = 0; i < 2*9+1; ++i)
+    {
+        x[i] = sin(i) + I*cos(3*i);
+        y[i] = cos(5*i) - I*sin(i);
+    }
+    for (i = 0; i < 10; ++i)
+        dl[i] = cos(2*i);
+
+    parameters.L = 9;
+    parameters.N = 3;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    f_size = so3_sampling_f_size(&parameters);
+    flmn = malloc(flmn_size * sizeof *flmn);
+    flmn_scalar = malloc(flmn_size * sizeof *flmn_scalar);
+    flmn_isa = malloc(flmn_size * sizeof *flmn_isa);
+    f_scalar = malloc(f_size * sizeof *f_scalar);
+    f = malloc(f_size * sizeof *f);
+    assert( flmn && flmn_scalar && flmn_isa && f_scalar && f );
+    for (i = 0; i < flmn_size; ++i)
+        flmn[i] = cos(i) + I*sin(2*i);
+
+    best = so3_simd_get_isa();
+    assert( so3_simd_supported(best) && so3_simd_supported(SO3_SIMD_SCALAR) );
+    assert( !so3_simd_set_isa(SO3_SIMD_SIZE) &&
+            "Invalid instruction set was selected." );
+    assert( !strcmp(so3_simd_isa_name(SO3_SIMD_SCALAR), "scalar") &&
+            !so3_simd_isa_name(SO3_SIMD_SIZE) );
+
+    so3_simd_set_isa(SO3_SIMD_SCALAR);
+    so3_core_inverse_direct(f_scalar, flmn, &parameters);
+    // Entries with el < |n| are not written by the forward transform.
+    memcpy(flmn_scalar, flmn, flmn_size * sizeof *flmn);
+    so3_core_forward_direct(flmn_scalar, f_scalar, &parameters);
+
+    // Every supported kernel gives the result of the scalar one, for
+    // all remainders of the vector length.
+    for (isa = SO3_SIMD_SCALAR; isa < SO3_SIMD_SIZE; ++isa)
+    {
+        if (!so3_simd_set_isa(isa))
+            continue;
+
+        for (el = 0; el <= 9; ++el)
+        {
+            for (i = 0; i < 2*9+1; ++i)
+                F[i] = F_scalar[i] = i;
+
+            so3_simd_set_isa(SO3_SIMD_SCALAR);
+            so3_simd_accumulate_fmnm(F_scalar + 9, x + 9, dl, el, -0.5, 2.0);
+            so3_simd_set_isa(isa);
+            so3_simd_accumulate_fmnm(F + 9, x + 9, dl, el, -0.5, 2.0);
+
+            for (i = 0; i < 2*9+1; ++i)
+                assert( cabs(F[i] - F_scalar[i]) < 1e-14 &&
+                        "Vectorised Fmnm' accumulation differs." );
+
+            for (i = 0; i < 2*9+1; ++i)
+                F[i] = F_scalar[i] = i;
+
+            so3_simd_set_isa(SO3_SIMD_SCALAR);
+            so3_simd_accumulate_flmn(F_scalar + 9, x + 9, y + 9, dl, el, -0.5, 2.0);
+            so3_simd_set_isa(isa);
+            so3_simd_accumulate_flmn(F + 9, x + 9, y + 9, dl, el, -0.5, 2.0);
+
+            for (i = 0; i < 2*9+1; ++i)
+                assert( cabs(F[i] - F_scalar[i]) < 1e-14 &&
+                        "Vectorised flmn accumulation differs." );
+
+            for (i = 0; i < 2*9+1; ++i)
+            {
+                F_re[i] = i;
+                F_im[i] = 0.0;
+            }
+
+            so3_simd_accumulate_flmn_split(F_re + 9, F_im + 9, x + 9, y + 9, dl, el, -0.5, 2.0);
+
+            for (i = 0; i < 2*9+1; ++i)
+                assert( cabs(F_re[i] + I*F_im[i] - F_scalar[i]) < 1e-14 &&
+                        "Split flmn accumulation differs." );
+
+            so3_simd_set_isa(SO3_SIMD_SCALAR);
+            so3_simd_scale(F_scalar, x, y[el], el);
+            so3_simd_modulate(F_scalar + 9, x, y, 0.5, el);
+            so3_simd_set_isa(isa);
+            so3_simd_scale(F, x, y[el], el);
+            so3_simd_modulate(F + 9, x, y, 0.5, el);
+
+            for (i = 0; i < 2*9+1; ++i)
+                assert( cabs(F[i] - F_scalar[i]) < 1e-14 &&
+                        "Vectorised phase modulation differs." );
+        }
+
+        so3_core_inverse_direct(f, flmn, &parameters);
+        for (i = 0; i < f_size; ++i)
+            assert( cabs(f[i] - f_scalar[i]) < 1e-12 &&
+                    "Direct inverse transform differs between kernels." );
+
+        memcpy(flmn_isa, flmn, flmn_size * sizeof *flmn);
+        so3_core_forward_direct(flmn_isa, f_scalar, &parameters);
+        for (i = 0; i < flmn_size; ++i)
+            assert( cabs(flmn_isa[i] - flmn_scalar[i]) < 1e-12 &&
+                    "Direct forward transform differs between kernels." );
+    }
+
+    so3_simd_set_isa(best);
+
+    free(flmn);
+    free(flmn_scalar);
+    free(flmn_isa);
+    free(f_scalar);
+    free(f);
+}
+
+void test_split()
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_c, *f;
+    double *flmn_re, *flmn_im, *f_re, *f_im;
+    int flmn_size, f_size, i;
+
+    parameters.L = 7;
+    parameters.N = 4;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    f_size = so3_sampling_f_size(&parameters);
+    flmn = malloc(flmn_size * sizeof *flmn);
+    flmn_c = calloc(flmn_size, sizeof *flmn_c);
+    flmn_re = malloc(flmn_size * sizeof *flmn_re);
+    flmn_im = malloc(flmn_size * sizeof *flmn_im);
+    f = malloc(f_size * sizeof *f);
+    f_re = malloc(f_size * sizeof *f_re);
+    f_im = malloc(f_size * sizeof *f_im);
+    assert( flmn && flmn_c && flmn_re && flmn_im && f && f_re && f_im );
+
+    for (i = 0; i < flmn_size; ++i)
+    {
+        flmn[i] = sin(3*i) + I*cos(i);
+        flmn_re[i] = creal(flmn[i]);
+        flmn_im[i] = cimag(flmn[i]);
+    }
+
+    // The split layout gives the results of the interleaved one.
+    so3_core_inverse_direct(f, flmn, &parameters);
+    so3_core_inverse_direct_split(f_re, f_im, flmn_re, flmn_im, &parameters);
+    for (i = 0; i < f_size; ++i)
+        assert( cabs(f_re[i] + I*f_im[i] - f[i]) < 1e-12 &&
+                "Split direct inverse transform differs." );
+
+    for (i = 0; i < flmn_size; ++i)
+        flmn_re[i] = flmn_im[i] = 0.0;
+    so3_core_forward_direct(flmn_c, f, &parameters);
+    so3_core_forward_direct_split(flmn_re, flmn_im, f_re, f_im, &parameters);
+    for (i = 0; i < flmn_size; ++i)
+        assert( cabs(flmn_re[i] + I*flmn_im[i] - flmn_c[i]) < 1e-12 &&
+                "Split direct forward transform differs." );
+
+    free(flmn);
+    free(flmn_c);
+    free(flmn_re);
+    free(flmn_im);
+    free(f);
+    free(f_re);
+    free(f_im);
+}
+
+// Fill flmn with the coefficients of a signal which respects L0, the
+// n-mode and the reality flag of the parameters.
+static void test_gen_flmn(complex double *flmn, const so3_parameters_t *parameters)
+{
+    int L0 = parameters->L0;
+    int L = parameters->L;
+    int N = parameters->N;
+    so3_n_mode_t n_mode = parameters->n_mode;
+    int el, m, n, ind;
+    complex double value;
+
+    memset(flmn, 0, so3_sampling_flmn_size(parameters) * sizeof *flmn);
+
+    for (n = parameters->reality ? 0 : -N+1; n <= N-1; ++n)
+    {
+        if ((n_mode == SO3_N_MODE_EVEN && n % 2)
+            || (n_mode == SO3_N_MODE_ODD && !(n % 2))
+            || (n_mode == SO3_N_MODE_MAXIMUM && abs(n) < N-1))
+            continue;
+
+        for (el = abs(n) > L0 ? abs(n) : L0; el < L; ++el)
+        {
+            if (n_mode == SO3_N_MODE_L && el != abs(n))
+                continue;
+
+            for (m = -el; m <= el; ++m)
+            {
+                value = sin(el + 2*m + 3*n) + I*cos(5*el - m + n);
+
+                if (!parameters->reality)
+                {
+                    so3_sampling_elmn2ind(&ind, el, m, n, parameters);
+                    flmn[ind] = value;
+                }
+                else if (n > 0 || m > 0)
+                {
+                    so3_sampling_elmn2ind_real(&ind, el, m, n, parameters);
+                    flmn[ind] = value;
+                    // For n = 0, fl-m0 = (-1)^m flm0*.
+                    if (n == 0)
+                    {
+                        so3_sampling_elmn2ind_real(&ind, el, -m, n, parameters);
+                        flmn[ind] = (m % 2 ? -1.0 : 1.0) * conj(value);
+                    }
+                }
+                else if (m == 0)
+                {
+                    so3_sampling_elmn2ind_real(&ind, el, m, n, parameters);
+                    flmn[ind] = creal(value);
+                }
+            }
+        }
+    }
+}
+
+void test_via_ssht()
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_v, *flmn_d, *f_v, *f_d;
+    double *fr_v, *fr_d;
+    int flmn_size, f_size, i, L0, n_mode, real, sampling_scheme;
+    const int L = 6, N = 4;
+
+    // Large enough for all configurations below.
+    flmn = malloc((2*N-1)*L*L * sizeof *flmn);
+    flmn_v = malloc((2*N-1)*L*L * sizeof *flmn_v);
+    flmn_d = malloc((2*N-1)*L*L * sizeof *flmn_d);
+    f_v = malloc((2*L)*(L+1)*(2*N-1) * sizeof *f_v);
+    f_d = malloc((2*L)*(L+1)*(2*N-1) * sizeof *f_d);
+    fr_v = malloc((2*L)*(L+1)*(2*N-1) * sizeof *fr_v);
+    fr_d = malloc((2*L)*(L+1)*(2*N-1) * sizeof *fr_d);
+    assert( flmn && flmn_v && flmn_d && f_v && f_d && fr_v && fr_d );
+
+    parameters.L = L;
+    parameters.N = N;
+
+    // For MW sampling, the transforms via SSHT agree with the direct ones.
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+    for (L0 = 0; L0 <= 2; L0 += 2)
+        for (n_mode = 0; n_mode < SO3_N_MODE_SIZE; ++n_mode)
+            for (real = 0; real <= 1; ++real)
+            {
+                parameters.L0 = L0;
+                parameters.n_mode = n_mode;
+                parameters.reality = real;
+                flmn_size = so3_sampling_flmn_size(&parameters);
+                f_size = so3_sampling_f_size(&parameters);
+
+                test_gen_flmn(flmn, &parameters);
+                memset(flmn_v, 0, flmn_size * sizeof *flmn_v);
+                memset(flmn_d, 0, flmn_size * sizeof *flmn_d);
+
+                if (real)
+                {
+                    so3_core_inverse_via_ssht_real(fr_v, flmn, &parameters);
+                    so3_core_inverse_direct_real(fr_d, flmn, &parameters);
+                    for (i = 0; i < f_size; ++i)
+                        assert( fabs(fr_v[i] - fr_d[i]) < 1e-10 &&
+                                "Real inverse transforms via SSHT and direct differ." );
+
+                    so3_core_forward_via_ssht_real(flmn_v, fr_v, &parameters);
+                    so3_core_forward_direct_real(flmn_d, fr_v, &parameters);
+                }
+                else
+                {
+                    so3_core_inverse_via_ssht(f_v, flmn, &parameters);
+                    so3_core_inverse_direct(f_d, flmn, &parameters);
+                    for (i = 0; i < f_size; ++i)
+                        assert( cabs(f_v[i] - f_d[i]) < 1e-10 &&
+                                "Inverse transforms via SSHT and direct differ." );
+
+                    so3_core_forward_via_ssht(flmn_v, f_v, &parameters);
+                    so3_core_forward_direct(flmn_d, f_v, &parameters);
+                }
+
+                for (i = 0; i < flmn_size; ++i)
+                {
+                    assert( cabs(flmn_v[i] - flmn_d[i]) < 1e-10 &&
+                            "Forward transforms via SSHT and direct differ." );
+                    assert( cabs(flmn_v[i] - flmn[i]) < 1e-10 &&
+                            "Round-trip via SSHT does not recover the coefficients." );
+                }
+            }
+
+    // Round-trips via SSHT for MW_SS sampling, which the direct
+    // transforms do not support.
+    parameters.sampling_scheme = SO3_SAMPLING_MW_SS;
+    for (L0 = 0; L0 <= 2; L0 += 2)
+        for (n_mode = 0; n_mode < SO3_N_MODE_SIZE; ++n_mode)
+            for (real = 0; real <= 1; ++real)
+            {
+                parameters.L0 = L0;
+                parameters.n_mode = n_mode;
+                parameters.reality = real;
+                flmn_size = so3_sampling_flmn_size(&parameters);
+
+                test_gen_flmn(flmn, &parameters);
+                memset(flmn_v, 0, flmn_size * sizeof *flmn_v);
+
+                if (real)
+                {
+                    so3_core_inverse_via_ssht_real(fr_v, flmn, &parameters);
+                    so3_core_forward_via_ssht_real(flmn_v, fr_v, &parameters);
+                }
+                else
+                {
+                    so3_core_inverse_via_ssht(f_v, flmn, &parameters);
+                    so3_core_forward_via_ssht(flmn_v, f_v, &parameters);
+                }
+
+                for (i = 0; i < flmn_size; ++i)
+                    assert( cabs(flmn_v[i] - flmn[i]) < 1e-10 &&
+                            "MW_SS round-trip via SSHT does not recover the coefficients." );
+            }
+
+    // Round-trips of steerable signals, which only have n of the parity
+    // of N-1 (here even) and are sampled over half of the range of gamma.
+    parameters.steerable = 1;
+    parameters.N = 3;
+    parameters.n_mode = SO3_N_MODE_EVEN;
+    for (sampling_scheme = 0; sampling_scheme < SO3_SAMPLING_SIZE; ++sampling_scheme)
+        for (L0 = 0; L0 <= 2; L0 += 2)
+            for (real = 0; real <= 1; ++real)
+            {
+                parameters.sampling_scheme = sampling_scheme;
+                parameters.L0 = L0;
+                parameters.reality = real;
+                flmn_size = so3_sampling_flmn_size(&parameters);
+
+                test_gen_flmn(flmn, &parameters);
+                memset(flmn_v, 0, flmn_size * sizeof *flmn_v);
+
+                if (real)
+                {
+                    so3_core_inverse_via_ssht_real(fr_v, flmn, &parameters);
+                    so3_core_forward_via_ssht_real(flmn_v, fr_v, &parameters);
+                }
+                else
+                {
+                    so3_core_inverse_via_ssht(f_v, flmn, &parameters);
+                    so3_core_forward_via_ssht(flmn_v, f_v, &parameters);
+                }
+
+                for (i = 0; i < flmn_size; ++i)
+                    assert( cabs(flmn_v[i] - flmn[i]) < 1e-10 &&
+                            "Steerable round-trip via SSHT does not recover the coefficients." );
+            }
+
+    free(flmn);
+    free(flmn_v);
+    free(flmn_d);
+    free(f_v);
+    free(f_d);
+    free(fr_v);
+    free(fr_d);
+}
+
+void test_numa()
+{
+    so3_parameters_t parameters = {};
+    complex double *flmn, *flmn_default, *flmn_numa;
+    complex double *f_default, *f_numa;
+    int flmn_size, f_size, i;
+#ifdef __linux__
+    cpu_set_t mask_before, mask_after;
+#endif
+
+    parameters.L = 6;
+    parameters.N = 3;
+    parameters.sampling_scheme = SO3_SAMPLING_MW;
+    parameters.num_threads = 3;
+
+    flmn_size = so3_sampling_flmn_size(&parameters);
+    f_size = so3_sampling_f_size(&parameters);
+    flmn = malloc(flmn_size * sizeof *flmn);
+    flmn_default = calloc(flmn_size, sizeof *flmn_default);
+    flmn_numa = calloc(flmn_size, sizeof *flmn_numa);
+    f_default = malloc(f_size * sizeof *f_default);
+    f_numa = malloc(f_size * sizeof *f_numa);
+    assert( flmn && flmn_default && flmn_numa && f_default && f_numa );
+
+    for (i = 0; i < flmn_size; ++i)
+        flmn[i] = sin(2*i) + I*cos(i);
+
+    // Pinning the threads does not change the results.
+    so3_core_inverse_direct(f_default, flmn, &parameters);
+    so3_core_forward_direct(flmn_default, f_default, &parameters);
+#ifdef __linux__
+    CPU_ZERO(&mask_before);
+    sched_getaffinity(0, sizeof mask_before, &mask_before);
+#endif
+    parameters.numa = 1;
+    so3_core_inverse_direct(f_numa, flmn, &parameters);
+    so3_core_forward_direct(flmn_numa, f_default, &parameters);
+#ifdef __linux__
+    // The threads are only pinned while the buffers are first touched.
+    CPU_ZERO(&mask_after);
+    sched_getaffinity(0, sizeof mask_after, &mask_after);
+    assert( CPU_EQUAL(&mask_before, &mask_after) &&
+            "Plan with numa flag changed the affinity of the calling thread." );
+#endif
+
+    for (i = 0; i < f_size; ++i)
+        assert( cabs(f_numa[i] - f_default[i]) < 1e-12 &&
+                "Inverse transform with pinned threads differs." );
+    for (i = 0; i < flmn_size; ++i)
+        assert( cabs(flmn_numa[i] - flmn_default[i]) < 1e-12 &&
+                "Forward transform with pinned threads differs." );
+
+    free(flmn);
+    free(flmn_default);
+    free(flmn_numa);
+    free(f_default);
+    free(f_numa);
+}
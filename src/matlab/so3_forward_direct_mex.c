@@ -27,7 +27,7 @@
     const mwSize *dims;
     int f_na, f_nb, f_ng, f_is_complex;
     double *f_real, *f_imag;
-    complex double *f;
+    double *f_re, *f_im;
     double *fr;
     int L0, L, N;
     int len;
@@ -87,12 +87,18 @@
     }
     else
     {
-        f = malloc(f_ng * f_nb * f_na * sizeof(*f));
+        // The complex transform reads the split layout of MATLAB, so the
+        // samples are only reordered, not interleaved.
+        f_re = malloc(f_ng * f_nb * f_na * sizeof(*f_re));
+        f_im = calloc(f_ng * f_nb * f_na, sizeof(*f_im));
         for(g = 0; g < f_ng; ++g)
             for(b = 0; b < f_nb; ++b)
                 for(a = 0; a < f_na; ++a)
-                    f[g*f_na*f_nb + b*f_na + a] = f_real[a*f_ng*f_nb + b*f_ng + g]
-                                                  + I * (f_is_complex ? f_imag[a*f_ng*f_nb + b*f_ng + g] : 0.0);
+                {
+                    f_re[g*f_na*f_nb + b*f_na + a] = f_real[a*f_ng*f_nb + b*f_ng + g];
+                    if (f_is_complex)
+                        f_im[g*f_na*f_nb + b*f_na + a] = f_imag[a*f_ng*f_nb + b*f_ng + g];
+                }
     }
 
     if (f_is_complex && reality)
@@ -299,41 +305,47 @@
         mexErrMsgIdAndTxt("so3_forward_direct_mex:InvalidInput:fSize",
                           "Invalid dimension sizes of function samples.");
 
-    /* Compute inverse transform. */
+    /* Compute forward transform. */
 
-    flmn = calloc(flmn_size, sizeof(*flmn));
+    // The output argument is zero-initialised, so the complex transform
+    // writes into it directly.
+    iout = 0;
+    plhs[iout] = mxCreateDoubleMatrix(flmn_size, 1, mxCOMPLEX);
+    flmn_real = mxGetPr(plhs[iout]);
+    flmn_imag = mxGetPi(plhs[iout]);
 
     if (reality)
     {
+        flmn = calloc(flmn_size, sizeof(*flmn));
         so3_core_forward_direct_real(
             flmn, fr,
             &parameters
         );
+
+        // Copy result to output argument
+        for(i = 0; i < flmn_size; ++i)
+        {
+            flmn_real[i] = creal(flmn[i]);
+            flmn_imag[i] = cimag(flmn[i]);
+        }
     }
     else
     {
-        so3_core_forward_direct(
-            flmn, f,
+        so3_core_forward_direct_split(
+            flmn_real, flmn_imag, f_re, f_im,
             &parameters
         );
     }
 
-    // Copy result to output argument
-
-    iout = 0;
-    plhs[iout] = mxCreateDoubleMatrix(flmn_size, 1, mxCOMPLEX);
-    flmn_real = mxGetPr(plhs[iout]);
-    flmn_imag = mxGetPi(plhs[iout]);
-    for(i = 0; i < flmn_size; ++i)
-    {
-        flmn_real[i] = creal(flmn[i]);
-        flmn_imag[i] = cimag(flmn[i]);
-    }
-
     /* Free memory. */
     if (reality)
+    {
         free(fr);
+        free(flmn);
+    }
     else
-        free(f);
-    free(flmn);
+    {
+        free(f_re);
+        free(f_im);
+    }
 }
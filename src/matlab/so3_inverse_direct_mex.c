@@ -25,7 +25,7 @@ void mexFunction( int nlhs, mxArray *plhs[],
     int i, iin, iout, a, b, g;
 
     int flmn_m, flmn_n, flmn_size;
-    double *flmn_real, *flmn_imag;
+    double *flmn_real, *flmn_imag, *flmn_zero;
     complex double *flmn;
     int L0, L, N;
     int len;
@@ -41,7 +41,7 @@ void mexFunction( int nlhs, mxArray *plhs[],
 
     int reality;
 
-    complex double *f;
+    double *f_re, *f_im;
     double *f_real, *f_imag;
     double *fr;
     mwSize ndim = 3;
@@ -71,15 +71,22 @@ void mexFunction( int nlhs, mxArray *plhs[],
         mexErrMsgIdAndTxt("so3_inverse_direct_mex:InvalidInput:flmnVector",
                           "Harmonic coefficients must be contained in vector.");
     flmn_size = flmn_m * flmn_n;
-    flmn = malloc(flmn_size * sizeof(*flmn));
     flmn_real = mxGetPr(prhs[iin]);
-    for (i = 0; i < flmn_m*flmn_n; ++i)
-        flmn[i] = flmn_real[i];
-    if (mxIsComplex(prhs[iin]))
+    flmn_imag = mxIsComplex(prhs[iin]) ? mxGetPi(prhs[iin]) : NULL;
+    flmn = NULL;
+    flmn_zero = NULL;
+    if (reality)
     {
-        flmn_imag = mxGetPi(prhs[iin]);
+        flmn = malloc(flmn_size * sizeof(*flmn));
         for (i = 0; i < flmn_m*flmn_n; ++i)
-            flmn[i] += I * flmn_imag[i];
+            flmn[i] = flmn_real[i] + I * (flmn_imag ? flmn_imag[i] : 0.0);
+    }
+    else if (!flmn_imag)
+    {
+        // The complex transform reads the split layout of MATLAB
+        // directly, so only a missing imaginary part is provided.
+        flmn_zero = calloc(flmn_size, sizeof(*flmn_zero));
+        flmn_imag = flmn_zero;
     }
 
     /* Parse lower harmonic band-limit L0. */
@@ -293,9 +300,10 @@ void mexFunction( int nlhs, mxArray *plhs[],
     }
     else
     {
-        f = malloc(nalpha * nbeta * ngamma * sizeof(*f));
-        so3_core_inverse_direct(
-            f, flmn,
+        f_re = malloc(nalpha * nbeta * ngamma * sizeof(*f_re));
+        f_im = malloc(nalpha * nbeta * ngamma * sizeof(*f_im));
+        so3_core_inverse_direct_split(
+            f_re, f_im, flmn_real, flmn_imag,
             &parameters
         );
     }
@@ -334,8 +342,8 @@ void mexFunction( int nlhs, mxArray *plhs[],
             {
                 for(a = 0; a < nalpha; ++a)
                 {
-                    f_real[a*ngamma*nbeta + b*ngamma + g] = creal(f[g*nalpha*nbeta + b*nalpha + a]);
-                    f_imag[a*ngamma*nbeta + b*ngamma + g] = cimag(f[g*nalpha*nbeta + b*nalpha + a]);
+                    f_real[a*ngamma*nbeta + b*ngamma + g] = f_re[g*nalpha*nbeta + b*nalpha + a];
+                    f_imag[a*ngamma*nbeta + b*ngamma + g] = f_im[g*nalpha*nbeta + b*nalpha + a];
                 }
             }
         }
@@ -343,12 +351,14 @@ void mexFunction( int nlhs, mxArray *plhs[],
 
     /* Free memory. */
     free(flmn);
+    free(flmn_zero);
     if (reality)
     {
         free(fr);
     }
     else
     {
-        free(f);
+        free(f_re);
+        free(f_im);
     }
 }